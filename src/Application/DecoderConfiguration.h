@@ -44,6 +44,7 @@ namespace QuickFAST{
         PCAPFILE_RECEIVER = DecoderConfigurationEnums::PCAPFILE_RECEIVER,
         ASYNCHRONOUS_FILE_RECEIVER = DecoderConfigurationEnums::ASYNCHRONOUS_FILE_RECEIVER,
         BUFFER_RECEIVER = DecoderConfigurationEnums::BUFFER_RECEIVER,
+        BUSY_POLL_RECEIVER = DecoderConfigurationEnums::BUSY_POLL_RECEIVER,
         UNSPECIFIED_RECEIVER = DecoderConfigurationEnums::UNSPECIFIED_RECEIVER
       };
 
@@ -116,6 +117,12 @@ namespace QuickFAST{
         , receiverType_(UNSPECIFIED_RECEIVER)
         , bufferSize_(1500)
         , bufferCount_(2)
+        , receiveBatch_(1)
+        , spinCpu_(-1)
+        , spinLimit_(0)
+        , busyPoll_(0)
+        , spinDecode_(false)
+        , spinDecodeCpu_(-1)
         , nonstandard_(0)
         , privateIOService_(false)
         , testSkip_(0)
@@ -154,6 +161,12 @@ namespace QuickFAST{
         , portName_(rhs.portName_)
         , bufferSize_(rhs.bufferSize_)
         , bufferCount_(rhs.bufferCount_)
+        , receiveBatch_(rhs.receiveBatch_)
+        , spinCpu_(rhs.spinCpu_)
+        , spinLimit_(rhs.spinLimit_)
+        , busyPoll_(rhs.busyPoll_)
+        , spinDecode_(rhs.spinDecode_)
+        , spinDecodeCpu_(rhs.spinDecodeCpu_)
         , nonstandard_(rhs.nonstandard_)
         , privateIOService_(rhs.privateIOService_)
         , testSkip_(rhs.testSkip_)
@@ -408,6 +421,45 @@ namespace QuickFAST{
         return bufferCount_;
       }
 
+      /// @brief For MulticastReceiver, how many datagrams to read per system call.
+      size_t receiveBatch()const
+      {
+        return receiveBatch_;
+      }
+
+      /// @brief For BusyPollReceiver, the CPU to which the receiving thread is pinned.
+      /// Negative means do not pin.
+      int spinCpu()const
+      {
+        return spinCpu_;
+      }
+
+      /// @brief For BusyPollReceiver, how many empty polls before blocking.
+      /// Zero means spin forever.
+      size_t spinLimit()const
+      {
+        return spinLimit_;
+      }
+
+      /// @brief For BusyPollReceiver, microseconds the kernel may busy poll (SO_BUSY_POLL)
+      int busyPoll()const
+      {
+        return busyPoll_;
+      }
+
+      /// @brief For BusyPollReceiver, decode on a separate thread?
+      bool spinDecode()const
+      {
+        return spinDecode_;
+      }
+
+      /// @brief For BusyPollReceiver, the CPU to which the decoding thread is pinned.
+      /// Negative means do not pin.
+      int spinDecodeCpu()const
+      {
+        return spinDecodeCpu_;
+      }
+
       /// @brief Support (nonstandard) presence attribute on length instruction
       unsigned long nonstandard() const
       {
@@ -689,6 +741,42 @@ namespace QuickFAST{
         bufferCount_ = bufferCount;
       }
 
+      /// @brief For MulticastReceiver, how many datagrams to read per system call.
+      /// Values greater than one take effect only where recvmmsg() is available.
+      void setReceiveBatch(size_t receiveBatch)
+      {
+        receiveBatch_ = receiveBatch;
+      }
+
+      /// @brief For BusyPollReceiver, the CPU to which the receiving thread is pinned.
+      /// Negative means do not pin.
+      void setSpinCpu(int spinCpu)
+      {
+        spinCpu_ = spinCpu;
+      }
+
+      /// @brief For BusyPollReceiver, how many empty polls before blocking.
+      /// Zero means spin forever.
+      void setSpinLimit(size_t spinLimit)
+      {
+        spinLimit_ = spinLimit;
+      }
+
+      /// @brief For BusyPollReceiver, microseconds the kernel may busy poll (SO_BUSY_POLL)
+      void setBusyPoll(int busyPoll)
+      {
+        busyPoll_ = busyPoll;
+      }
+
+      /// @brief For BusyPollReceiver, decode on a separate thread.
+      /// @param spinDecode is true to use a separate decoding thread.
+      /// @param spinDecodeCpu is the CPU for the decoding thread.  Negative means do not pin.
+      void setSpinDecode(bool spinDecode, int spinDecodeCpu = -1)
+      {
+        spinDecode_ = spinDecode;
+        spinDecodeCpu_ = spinDecodeCpu;
+      }
+
       /// @brief Support nonstandard FAST featurs
       /// @param nonstandard is an 'or' of the nonstandard features that will be allowed
       ///      1:  if the presence attribute is allowed on length instructoin
@@ -769,6 +857,13 @@ namespace QuickFAST{
         out << "                           on which to subscribe and listen." << std::endl;
         out << "                           0.0.0.0 means pick any NIC." << std::endl;
         out << "  -mbind ip            : Multicast bind address.  Defaults to listenIP. Override if you dare." << std::endl;
+        out << "  -spinmulticast ip:port : Input from Multicast on a dedicated thread that" << std::endl;
+        out << "                         spins on a non-blocking socket.  Single feed only." << std::endl;
+        out << "  -spincpu n           : Pin the spinning thread to CPU 'n'." << std::endl;
+        out << "  -spinlimit n         : Block after 'n' empty polls.  (default 0: spin forever)" << std::endl;
+        out << "  -busypoll usec       : Linux SO_BUSY_POLL time for the spinning socket." << std::endl;
+        out << "  -spindecode cpu      : Decode on a second thread pinned to CPU 'cpu'" << std::endl;
+        out << "                         (-1 means do not pin)." << std::endl;
         out << "  -tcp host:port       : Input from TCP/IP.  Connect to \"host\" name or" << std::endl;
         out << "                         dotted IP on named or numbered port." << std::endl;
         out << std::endl;
@@ -819,6 +914,9 @@ namespace QuickFAST{
         out << "  -buffers count       : Number of buffers. (default " << bufferCount() << ")." << std::endl;
         out << "                         For \"-streaming block\" buffersize * buffers must" << std::endl;
         out << "                         exceed largest expected message." << std::endl;
+        out << "  -recvbatch n         : Read up to 'n' datagrams per system call." << std::endl;
+        out << "                         Linux multicast only.  Use at least 'n' buffers." << std::endl;
+        out << "                         (default " << receiveBatch() << ")." << std::endl;
         out << std::endl;
         out << "  -e file              : Echo input to file:" << std::endl;
         out << "    -ehex                : Echo as hexadecimal (default)." << std::endl;
@@ -952,9 +1050,9 @@ namespace QuickFAST{
           setMulticastName(argv[1]);
           consumed = 2;
         }
-        else if(opt == "-multicast" && argc > 1)
+        else if((opt == "-multicast" || opt == "-spinmulticast") && argc > 1)
         {
-          setReceiverType(MULTICAST_RECEIVER);
+          setReceiverType(opt == "-multicast" ? MULTICAST_RECEIVER : BUSY_POLL_RECEIVER);
           std::string address = argv[1];
           std::string::size_type colon = address.find(':');
           setMulticastGroupIP(address.substr(0, colon));
@@ -975,6 +1073,26 @@ namespace QuickFAST{
           setMulticastBindIP(argv[1]);
           consumed = 2;
         }
+        else if(opt == "-spincpu" && argc > 1)
+        {
+          setSpinCpu(boost::lexical_cast<int>(argv[1]));
+          consumed = 2;
+        }
+        else if(opt == "-spinlimit" && argc > 1)
+        {
+          setSpinLimit(boost::lexical_cast<size_t>(argv[1]));
+          consumed = 2;
+        }
+        else if(opt == "-busypoll" && argc > 1)
+        {
+          setBusyPoll(boost::lexical_cast<int>(argv[1]));
+          consumed = 2;
+        }
+        else if(opt == "-spindecode" && argc > 1)
+        {
+          setSpinDecode(true, boost::lexical_cast<int>(argv[1]));
+          consumed = 2;
+        }
         else if(opt == "-tcp" && argc > 1)
         {
           setReceiverType(TCP_RECEIVER);
@@ -1118,6 +1236,11 @@ namespace QuickFAST{
           setBufferCount(boost::lexical_cast<size_t>(argv[1]));
           consumed = 2;
         }
+        else if(opt == "-recvbatch" && argc > 1)
+        {
+          setReceiveBatch(boost::lexical_cast<size_t>(argv[1]));
+          consumed = 2;
+        }
         else if(opt == "-nonstandard" && argc > 1)
         {
           setNonstandard(boost::lexical_cast<unsigned long>(argv[1]));
@@ -1217,6 +1340,18 @@ namespace QuickFAST{
       /// For StreamingAssembler with waitForCompleteMessage_ specified,
       /// bufferCount_ * bufferSize_ must equal or exceed maximum message size.
       size_t bufferCount_;
+      /// @brief For MulticastReceiver, how many datagrams to read per system call.
+      size_t receiveBatch_;
+      /// @brief For BusyPollReceiver, the CPU to which the receiving thread is pinned.
+      int spinCpu_;
+      /// @brief For BusyPollReceiver, how many empty polls before blocking.
+      size_t spinLimit_;
+      /// @brief For BusyPollReceiver, microseconds the kernel may busy poll.
+      int busyPoll_;
+      /// @brief For BusyPollReceiver, decode on a separate thread?
+      bool spinDecode_;
+      /// @brief For BusyPollReceiver, the CPU to which the decoding thread is pinned.
+      int spinDecodeCpu_;
 
       /// @brief Allow nonstandard presence attribute on length instruction
       /// If true, allow presence= attribute on sequence length instruction
@@ -41,6 +41,7 @@ namespace QuickFAST{
         PCAPFILE_RECEIVER,            /// File captured from network in PCAP format
         ASYNCHRONOUS_FILE_RECEIVER,   /// File read using asynchronous I/O (not in core QuickFAST)
         BUFFER_RECEIVER,              /// Decode from in-memory buffer.
+        BUSY_POLL_RECEIVER,           /// Multicast received by a dedicated spinning thread.
         UNSPECIFIED_RECEIVER          /// Receiver has not yet been specified.
       };
 
@@ -21,6 +21,7 @@
 #include <Communication/PCapFileReceiver.h>
 #include <Communication/AsynchFileReceiver.h>
 #include <Communication/BufferReceiver.h>
+#include <Communication/BusyPollReceiver.h>
 #include <Communication/AsioService.h>
 
 using namespace QuickFAST;
@@ -272,6 +273,7 @@ DecoderConnection::configure(
       case Application::DecoderConfiguration::MULTICAST_RECEIVER:
       case Application::DecoderConfiguration::PCAPFILE_RECEIVER:
       case Application::DecoderConfiguration::BUFFER_RECEIVER:
+      case Application::DecoderConfiguration::BUSY_POLL_RECEIVER:
         {
           Codecs::MessagePerPacketAssembler * pAssembler = new Codecs::MessagePerPacketAssembler(
             registry_,
@@ -334,6 +336,7 @@ DecoderConnection::configure(
         receiver = new Communication::MulticastReceiver();
       }
       receiver_.reset(receiver);
+      receiver->setReceiveBatch(configuration.receiveBatch());
       receiver->addFeed(
         configuration.multicastName(),
         configuration.multicastGroupIP(),
@@ -354,6 +357,20 @@ DecoderConnection::configure(
       }
       break;
     }
+  case Application::DecoderConfiguration::BUSY_POLL_RECEIVER:
+    {
+      Communication::BusyPollReceiver * receiver = new Communication::BusyPollReceiver(
+        configuration.multicastGroupIP(),
+        configuration.listenInterfaceIP(),
+        configuration.multicastBindIP(),
+        configuration.portNumber());
+      receiver_.reset(receiver);
+      receiver->setCpu(configuration.spinCpu());
+      receiver->setSpinLimit(configuration.spinLimit());
+      receiver->setBusyPoll(configuration.busyPoll());
+      receiver->setDecodeThread(configuration.spinDecode(), configuration.spinDecodeCpu());
+      break;
+    }
   case Application::DecoderConfiguration::TCP_RECEIVER:
     {
       if(configuration.privateIOService())
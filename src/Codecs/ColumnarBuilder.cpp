@@ -0,0 +1,687 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "ColumnarBuilder.h"
+#include <Common/Decimal.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+const size_t ColumnarBuilder::defaultBatchRows;
+
+namespace
+{
+  /// How a column stores its values
+  enum ColumnKind
+  {
+    INTEGER,
+    DECIMAL,
+    STRING,
+    PRESENCE
+  };
+
+  ColumnKind columnKind(ValueType::Type type)
+  {
+    switch(type)
+    {
+    case ValueType::DECIMAL:
+      return DECIMAL;
+    case ValueType::ASCII:
+    case ValueType::UTF8:
+    case ValueType::BYTEVECTOR:
+    case ValueType::BITMAP:
+      return STRING;
+    case ValueType::GROUP:
+    case ValueType::TEMPLATEREF:
+      return PRESENCE;
+    default:
+      // integers, and the entry count of a sequence.
+      return INTEGER;
+    }
+  }
+
+  /// The values of one field for the rows in the current batch.
+  struct Column
+  {
+    std::string name_;
+    ValueType::Type type_;
+    ColumnKind kind_;
+    std::vector<uchar> present_;
+    std::vector<uint64> numbers_;
+    std::vector<int8> exponents_;
+    std::vector<uint32> offsets_;
+    std::vector<uchar> arena_;
+  };
+
+  template<typename VALUE>
+  void writeValue(std::ostream & out, VALUE value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  template<typename VALUE>
+  void writeVector(std::ostream & out, const std::vector<VALUE> & values)
+  {
+    if(!values.empty())
+    {
+      out.write(reinterpret_cast<const char *>(&values[0]), values.size() * sizeof(VALUE));
+    }
+  }
+
+  void writeString(std::ostream & out, const std::string & value)
+  {
+    writeValue(out, uint32(value.size()));
+    out.write(value.data(), value.size());
+  }
+}
+
+/// @brief The rows decoded from one segment: a template, sequence or group.
+class ColumnarBuilder::Table
+{
+public:
+  Table(const FlatRecordLayout & layout, const std::string & name, bool child);
+
+  const FlatRecordLayout & layout()const
+  {
+    return layout_;
+  }
+
+  Table * child(size_t slot)const
+  {
+    return children_[slot].get();
+  }
+
+  /// The number of the row being built.
+  uint64 currentRow()const
+  {
+    return firstRow_ + rows_ - 1;
+  }
+
+  size_t rows()const
+  {
+    return rows_;
+  }
+
+  void startRow(uint64 parentRow);
+  void dropRow();
+  uchar * setPresent(size_t slot);
+  void setNumber(size_t slot, uint64 value);
+  void setDecimal(size_t slot, const Decimal & value);
+  void setString(size_t slot, const uchar * value, size_t length);
+  void writeFull(size_t batchRows, std::ostream & out, size_t & batchCount);
+  void flush(std::ostream & out, size_t & batchCount);
+
+private:
+  void writeBatch(std::ostream & out, size_t & batchCount);
+  void clear();
+
+private:
+  const FlatRecordLayout & layout_;
+  std::string name_;
+  bool child_;
+  std::vector<uint64> parents_;
+  std::vector<Column> columns_;
+  std::vector<TablePtr> children_;
+  uint64 firstRow_;
+  size_t rows_;
+};
+
+ColumnarBuilder::Table::Table(const FlatRecordLayout & layout, const std::string & name, bool child)
+: layout_(layout)
+, name_(name)
+, child_(child)
+, firstRow_(0)
+, rows_(0)
+{
+  size_t slotCount = layout.slotCount();
+  columns_.resize(slotCount);
+  children_.resize(slotCount);
+  for(size_t nSlot = 0; nSlot < slotCount; ++nSlot)
+  {
+    const FlatRecordLayout::Slot & slot = layout[nSlot];
+    Column & column = columns_[nSlot];
+    column.name_ = slot.identity_->getLocalName();
+    column.type_ = slot.type_;
+    column.kind_ = columnKind(slot.type_);
+    if(slot.nested_)
+    {
+      children_[nSlot].reset(new Table(*slot.nested_, name + '.' + slot.nested_->name(), true));
+    }
+  }
+  clear();
+}
+
+void
+ColumnarBuilder::Table::clear()
+{
+  firstRow_ += rows_;
+  rows_ = 0;
+  parents_.clear();
+  for(size_t nColumn = 0; nColumn < columns_.size(); ++nColumn)
+  {
+    Column & column = columns_[nColumn];
+    column.present_.clear();
+    column.numbers_.clear();
+    column.exponents_.clear();
+    column.offsets_.clear();
+    column.arena_.clear();
+    if(column.kind_ == STRING)
+    {
+      column.offsets_.push_back(0);
+    }
+  }
+}
+
+void
+ColumnarBuilder::Table::startRow(uint64 parentRow)
+{
+  if(rows_ % 8 == 0)
+  {
+    for(size_t nColumn = 0; nColumn < columns_.size(); ++nColumn)
+    {
+      columns_[nColumn].present_.push_back(0);
+    }
+  }
+  ++rows_;
+  if(child_)
+  {
+    parents_.push_back(parentRow);
+  }
+  for(size_t nColumn = 0; nColumn < columns_.size(); ++nColumn)
+  {
+    Column & column = columns_[nColumn];
+    switch(column.kind_)
+    {
+    case DECIMAL:
+      // the exponent goes here; the mantissa is stored with the integers.
+      column.exponents_.push_back(0);
+      // fall through
+    case INTEGER:
+      column.numbers_.push_back(0);
+      break;
+    case STRING:
+      column.offsets_.push_back(uint32(column.arena_.size()));
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+void
+ColumnarBuilder::Table::dropRow()
+{
+  if(rows_ == 0)
+  {
+    return;
+  }
+  uint64 row = currentRow();
+  for(size_t nSlot = 0; nSlot < children_.size(); ++nSlot)
+  {
+    Table * table = children_[nSlot].get();
+    while(table != 0 && table->rows_ > 0 && table->parents_.back() == row)
+    {
+      table->dropRow();
+    }
+  }
+  --rows_;
+  if(child_)
+  {
+    parents_.pop_back();
+  }
+  for(size_t nColumn = 0; nColumn < columns_.size(); ++nColumn)
+  {
+    Column & column = columns_[nColumn];
+    column.present_.resize((rows_ + 7) / 8);
+    if(!column.present_.empty())
+    {
+      column.present_.back() &= uchar((1 << (rows_ % 8)) - 1);
+    }
+    switch(column.kind_)
+    {
+    case DECIMAL:
+      column.exponents_.pop_back();
+      // fall through
+    case INTEGER:
+      column.numbers_.pop_back();
+      break;
+    case STRING:
+      column.offsets_.pop_back();
+      column.arena_.resize(column.offsets_.back());
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+uchar *
+ColumnarBuilder::Table::setPresent(size_t slot)
+{
+  size_t row = rows_ - 1;
+  uchar & bits = columns_[slot].present_[row / 8];
+  bits |= uchar(1 << (row % 8));
+  return &bits;
+}
+
+void
+ColumnarBuilder::Table::setNumber(size_t slot, uint64 value)
+{
+  setPresent(slot);
+  columns_[slot].numbers_.back() = value;
+}
+
+void
+ColumnarBuilder::Table::setDecimal(size_t slot, const Decimal & value)
+{
+  setPresent(slot);
+  Column & column = columns_[slot];
+  column.numbers_.back() = uint64(value.getMantissa());
+  column.exponents_.back() = int8(value.getExponent());
+}
+
+void
+ColumnarBuilder::Table::setString(size_t slot, const uchar * value, size_t length)
+{
+  setPresent(slot);
+  Column & column = columns_[slot];
+  column.arena_.insert(column.arena_.end(), value, value + length);
+  column.offsets_.back() = uint32(column.arena_.size());
+}
+
+void
+ColumnarBuilder::Table::writeFull(size_t batchRows, std::ostream & out, size_t & batchCount)
+{
+  if(rows_ >= batchRows)
+  {
+    writeBatch(out, batchCount);
+  }
+  for(size_t nSlot = 0; nSlot < children_.size(); ++nSlot)
+  {
+    if(children_[nSlot])
+    {
+      children_[nSlot]->writeFull(batchRows, out, batchCount);
+    }
+  }
+}
+
+void
+ColumnarBuilder::Table::flush(std::ostream & out, size_t & batchCount)
+{
+  writeBatch(out, batchCount);
+  for(size_t nSlot = 0; nSlot < children_.size(); ++nSlot)
+  {
+    if(children_[nSlot])
+    {
+      children_[nSlot]->flush(out, batchCount);
+    }
+  }
+}
+
+void
+ColumnarBuilder::Table::writeBatch(std::ostream & out, size_t & batchCount)
+{
+  if(rows_ > 0)
+  {
+    out.write("QFCB", 4);
+    writeString(out, name_);
+    writeValue(out, uint64(firstRow_));
+    writeValue(out, uint32(rows_));
+    writeValue(out, uint32(columns_.size() + (child_ ? 1 : 0)));
+    if(child_)
+    {
+      static const std::string parent("_parent");
+      writeString(out, parent);
+      writeValue(out, uint32(ValueType::UINT64));
+      std::vector<uchar> allPresent((rows_ + 7) / 8, uchar(0xFF));
+      writeVector(out, allPresent);
+      writeVector(out, parents_);
+    }
+    for(size_t nColumn = 0; nColumn < columns_.size(); ++nColumn)
+    {
+      const Column & column = columns_[nColumn];
+      writeString(out, column.name_);
+      writeValue(out, uint32(column.type_));
+      writeVector(out, column.present_);
+      switch(column.kind_)
+      {
+      case INTEGER:
+        writeVector(out, column.numbers_);
+        break;
+      case DECIMAL:
+        writeVector(out, column.numbers_);
+        writeVector(out, column.exponents_);
+        break;
+      case STRING:
+        writeVector(out, column.offsets_);
+        writeValue(out, uint32(column.arena_.size()));
+        writeVector(out, column.arena_);
+        break;
+      default:
+        break;
+      }
+    }
+    ++batchCount;
+    clear();
+  }
+}
+
+//////////////////
+// ColumnarBuilder
+
+ColumnarBuilder::ColumnarBuilder(
+  const TemplateRegistry & registry,
+  std::ostream & out,
+  Common::Logger & logger,
+  size_t batchRows)
+: schema_(new FlatRecordSchema(registry))
+, out_(out)
+, logger_(logger)
+, batchRows_(batchRows)
+, batchCount_(0)
+, templateId_(0)
+, selected_(0)
+{
+}
+
+ColumnarBuilder::ColumnarBuilder(
+  FlatRecordSchemaCPtr schema,
+  std::ostream & out,
+  Common::Logger & logger,
+  size_t batchRows)
+: schema_(schema)
+, out_(out)
+, logger_(logger)
+, batchRows_(batchRows)
+, batchCount_(0)
+, templateId_(0)
+, selected_(0)
+{
+}
+
+ColumnarBuilder::~ColumnarBuilder()
+{
+}
+
+void
+ColumnarBuilder::flush()
+{
+  for(Tables::iterator it = tables_.begin(); it != tables_.end(); ++it)
+  {
+    it->second->flush(out_, batchCount_);
+  }
+  out_.flush();
+}
+
+ColumnarBuilder::Table &
+ColumnarBuilder::currentTable()const
+{
+  if(stack_.empty())
+  {
+    throw UsageError("Coding Error", "ColumnarBuilder: no message has been started.");
+  }
+  return *stack_.back();
+}
+
+ColumnarBuilder::Table &
+ColumnarBuilder::childTable(const Messages::FieldIdentity & identity, size_t & slot)const
+{
+  Table & table = currentTable();
+  slot = table.layout().slotFor(identity);
+  if(slot == FlatRecordLayout::NO_SLOT || table.child(slot) == 0)
+  {
+    throw UsageError("Coding Error", "ColumnarBuilder: unknown group or sequence (dynamic template references are not supported).");
+  }
+  return *table.child(slot);
+}
+
+const std::string &
+ColumnarBuilder::getApplicationType()const
+{
+  return currentTable().layout().getApplicationType();
+}
+
+const std::string &
+ColumnarBuilder::getApplicationTypeNs()const
+{
+  return currentTable().layout().getApplicationTypeNs();
+}
+
+namespace
+{
+  size_t findSlot(const FlatRecordLayout & layout, const Messages::FieldIdentity & identity)
+  {
+    size_t slot = layout.slotFor(identity);
+    if(slot == FlatRecordLayout::NO_SLOT)
+    {
+      std::string error("ColumnarBuilder: field is not in the template: ");
+      error += identity.name();
+      throw UsageError("Coding Error", error.c_str());
+    }
+    return slot;
+  }
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int64 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(value));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint64 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), value);
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int32 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(int64(value)));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint32 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(value));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int16 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(int64(value)));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint16 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(value));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int8 value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(int64(value)));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uchar value)
+{
+  Table & table = currentTable();
+  table.setNumber(findSlot(table.layout(), identity), uint64(value));
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const Decimal& value)
+{
+  Table & table = currentTable();
+  table.setDecimal(findSlot(table.layout(), identity), value);
+}
+
+void
+ColumnarBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const unsigned char * value, size_t length)
+{
+  Table & table = currentTable();
+  table.setString(findSlot(table.layout(), identity), value, length);
+}
+
+void
+ColumnarBuilder::selectTemplate(template_id_t templateId)
+{
+  if(selected_ != 0 && templateId == templateId_)
+  {
+    return;
+  }
+  templateId_ = templateId;
+  selected_ = 0;
+  Tables::iterator it = tables_.find(templateId);
+  if(it != tables_.end())
+  {
+    selected_ = it->second.get();
+    return;
+  }
+  const FlatRecordLayout * layout = schema_->findLayout(templateId);
+  if(layout != 0)
+  {
+    TablePtr table(new Table(*layout, layout->name(), false));
+    tables_[templateId] = table;
+    selected_ = table.get();
+  }
+}
+
+Messages::ValueMessageBuilder &
+ColumnarBuilder::startMessage(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  if(selected_ == 0)
+  {
+    throw UsageError("Coding Error", "ColumnarBuilder: no table selected for message.");
+  }
+  stack_.clear();
+  stack_.push_back(selected_);
+  selected_->startRow(0);
+  return *this;
+}
+
+bool
+ColumnarBuilder::endMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  stack_.clear();
+  if(selected_ != 0)
+  {
+    // The message's rows are complete, so its tables may be written.
+    selected_->writeFull(batchRows_, out_, batchCount_);
+  }
+  return true;
+}
+
+bool
+ColumnarBuilder::ignoreMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  stack_.clear();
+  if(selected_ != 0)
+  {
+    selected_->dropRow();
+  }
+  return true;
+}
+
+Messages::ValueMessageBuilder &
+ColumnarBuilder::startSequence(
+  const Messages::FieldIdentity & identity,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*fieldCount*/,
+  const Messages::FieldIdentity & /*lengthIdentity*/,
+  size_t length)
+{
+  size_t slot;
+  Table & child = childTable(identity, slot);
+  currentTable().setNumber(slot, uint64(length));
+  stack_.push_back(&child);
+  return *this;
+}
+
+void
+ColumnarBuilder::endSequence(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*sequenceBuilder*/)
+{
+  stack_.pop_back();
+}
+
+Messages::ValueMessageBuilder &
+ColumnarBuilder::startSequenceEntry(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  // The parent row is the current row of the table that contains the sequence.
+  uint64 parentRow = stack_[stack_.size() - 2]->currentRow();
+  stack_.back()->startRow(parentRow);
+  return *this;
+}
+
+void
+ColumnarBuilder::endSequenceEntry(Messages::ValueMessageBuilder & /*entry*/)
+{
+}
+
+Messages::ValueMessageBuilder &
+ColumnarBuilder::startGroup(
+  const Messages::FieldIdentity & identity,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  size_t slot;
+  Table & child = childTable(identity, slot);
+  Table & parent = currentTable();
+  parent.setPresent(slot);
+  child.startRow(parent.currentRow());
+  stack_.push_back(&child);
+  return *this;
+}
+
+void
+ColumnarBuilder::endGroup(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*groupBuilder*/)
+{
+  stack_.pop_back();
+}
+
+bool
+ColumnarBuilder::wantLog(unsigned short level)
+{
+  return logger_.wantLog(level);
+}
+
+bool
+ColumnarBuilder::logMessage(unsigned short level, const std::string & logMessage)
+{
+  return logger_.logMessage(level, logMessage);
+}
+
+bool
+ColumnarBuilder::reportDecodingError(const std::string & errorMessage)
+{
+  return logger_.reportDecodingError(errorMessage);
+}
+
+bool
+ColumnarBuilder::reportCommunicationError(const std::string & errorMessage)
+{
+  return logger_.reportCommunicationError(errorMessage);
+}
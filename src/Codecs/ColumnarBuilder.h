@@ -0,0 +1,171 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef COLUMNARBUILDER_H
+#define COLUMNARBUILDER_H
+#include <Common/QuickFAST_Export.h>
+#include <Messages/ValueMessageBuilder.h>
+#include <Codecs/FlatRecordLayout.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Decode messages into per-template column tables and write them to a stream.
+    ///
+    /// Intended for bulk decoding of recorded feeds for analysis.  Each template
+    /// becomes a table with one row per message and one column per field.
+    /// Each sequence or group in a template becomes a child table with one row per
+    /// entry (or group) and an extra "_parent" column holding the row number
+    /// of the containing row.
+    ///
+    /// Values are appended directly to typed column vectors: 64 bit integers,
+    /// decimals as a mantissa vector and an exponent vector, and strings as an offset
+    /// vector into a byte arena.  Each column has a presence bitmap.  No Message or
+    /// Field objects are created.
+    ///
+    /// When a message is complete, each of its tables that has accumulated at least
+    /// batchRows rows is written to the output stream as a batch and its columns are
+    /// cleared (keeping their capacity).  Rows are never written while their message
+    /// is being decoded, so an ignored message leaves nothing behind, but a batch
+    /// may hold more than batchRows rows.
+    /// Call flush() after decoding to write the final partial batches.
+    ///
+    /// Log messages and errors are passed to the logger supplied to the constructor.
+    ///
+    /// The output is a series of batches.  Integers are in native byte order:
+    /// <pre>
+    /// "QFCB"
+    /// uint32 name length, table name    (template name; child tables are parent.field)
+    /// uint64 row number of the first row in this batch
+    /// uint32 row count (N)
+    /// uint32 column count
+    /// for each column:
+    ///   uint32 name length, column name
+    ///   uint32 ValueType::Type
+    ///   (N + 7) / 8 bytes presence bitmap, least significant bit first
+    ///   data:
+    ///     integers and sequence lengths: N int64/uint64
+    ///     decimals: N int64 mantissas then N int8 exponents
+    ///     strings and byte vectors: N + 1 uint32 offsets, uint32 arena size, arena
+    ///     groups and template references: nothing
+    /// </pre>
+    class QuickFAST_Export ColumnarBuilder : public Messages::ValueMessageBuilder
+    {
+    public:
+      /// @brief The default number of rows in a batch.
+      static const size_t defaultBatchRows = 65536;
+
+      /// @brief Construct
+      /// @param registry must be finalized.
+      /// @param out receives the batches.  Should be opened in binary mode.
+      /// @param logger receives log messages and errors.
+      /// @param batchRows is the number of rows to accumulate before writing a batch.
+      ColumnarBuilder(
+        const TemplateRegistry & registry,
+        std::ostream & out,
+        Common::Logger & logger,
+        size_t batchRows = defaultBatchRows);
+
+      /// @brief Construct using precomputed layouts.
+      /// @param schema supplies the field layouts for each template.
+      /// @param out receives the batches.  Should be opened in binary mode.
+      /// @param logger receives log messages and errors.
+      /// @param batchRows is the number of rows to accumulate before writing a batch.
+      ColumnarBuilder(
+        FlatRecordSchemaCPtr schema,
+        std::ostream & out,
+        Common::Logger & logger,
+        size_t batchRows = defaultBatchRows);
+
+      virtual ~ColumnarBuilder();
+
+      /// @brief Write any rows that have not yet been written.
+      void flush();
+
+      /// @brief How many batches have been written.
+      size_t batchCount()const
+      {
+        return batchCount_;
+      }
+
+      //////////////////////////////
+      // Implement ValueMessageBuilder
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int8 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uchar value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+      virtual void selectTemplate(template_id_t templateId);
+      virtual Messages::ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual Messages::ValueMessageBuilder & startSequence(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t fieldCount,
+        const Messages::FieldIdentity & lengthIdentity,
+        size_t length);
+      virtual void endSequence(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & sequenceBuilder);
+      virtual Messages::ValueMessageBuilder & startSequenceEntry(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endSequenceEntry(Messages::ValueMessageBuilder & entry);
+      virtual Messages::ValueMessageBuilder & startGroup(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endGroup(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & groupBuilder);
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      class Table;
+      typedef boost::shared_ptr<Table> TablePtr;
+      typedef std::map<template_id_t, TablePtr> Tables;
+
+      Table & currentTable()const;
+      Table & childTable(const Messages::FieldIdentity & identity, size_t & slot)const;
+
+    private:
+      ColumnarBuilder(const ColumnarBuilder &);
+      ColumnarBuilder & operator=(const ColumnarBuilder &);
+
+    private:
+      FlatRecordSchemaCPtr schema_;
+      std::ostream & out_;
+      Common::Logger & logger_;
+      size_t batchRows_;
+      size_t batchCount_;
+      Tables tables_;
+      template_id_t templateId_;
+      Table * selected_;
+      std::vector<Table *> stack_;
+    };
+  }
+}
+#endif // COLUMNARBUILDER_H
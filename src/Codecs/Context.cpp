@@ -19,7 +19,8 @@ Context::Context(Codecs::TemplateRegistryCPtr registry)
 , strict_(true)
 , indexedDictionarySize_(registry->dictionarySize())
 //, indexedDictionary_(new Messages::FieldCPtr[indexedDictionarySize_])
-, indexedDictionary_(new Value[indexedDictionarySize_])
+, indexedDictionary_(new DictionaryEntry[indexedDictionarySize_])
+, generation_(1)
 {
 }
 
@@ -30,9 +31,17 @@ Context::~Context()
 void
 Context::reset(bool resetTemplateId /*= true*/)
 {
-  for(size_t nDict = 0; nDict < indexedDictionarySize_; ++nDict)
+  ++generation_;
+  if(generation_ == 0)
   {
-    indexedDictionary_[nDict].erase();
+    // The counter wrapped.  Entries from 2^32 resets ago would look current,
+    // so clear them the slow way.
+    for(size_t nDict = 0; nDict < indexedDictionarySize_; ++nDict)
+    {
+      indexedDictionary_[nDict].erase();
+    }
+    stringArena_.clear();
+    generation_ = 1;
   }
   if(resetTemplateId)
   {
@@ -40,6 +49,111 @@ Context::reset(bool resetTemplateId /*= true*/)
   }
 }
 
+namespace
+{
+  const size_t minimumStringCapacity = 16;
+}
+
+uint32
+Context::allocateString(size_t capacity)
+{
+  if(capacity < minimumStringCapacity)
+  {
+    capacity = minimumStringCapacity;
+  }
+  // capacity, then the data, then a null terminator.
+  size_t offset = stringArena_.size() + sizeof(uint32);
+  stringArena_.resize(offset + capacity + 1);
+  uint32 capacity32 = uint32(capacity);
+  memcpy(&stringArena_[offset - sizeof(uint32)], &capacity32, sizeof(uint32));
+  return uint32(offset);
+}
+
+uint32
+Context::stringCapacity(uint32 offset)const
+{
+  uint32 capacity;
+  memcpy(&capacity, &stringArena_[offset - sizeof(uint32)], sizeof(uint32));
+  return capacity;
+}
+
+void
+Context::storeString(DictionaryEntry & entry, const unsigned char * value, size_t length)
+{
+  if(!entry.hasBlock() || stringCapacity(entry.stringOffset()) < length)
+  {
+    // The value may be in the arena, which is about to move.
+    const unsigned char * arena = stringArena_.empty() ? 0 : &stringArena_[0];
+    bool inArena = arena != 0 && value >= arena && value < arena + stringArena_.size();
+    size_t valueOffset = inArena ? size_t(value - arena) : 0;
+    size_t capacity = entry.hasBlock() ? 2 * stringCapacity(entry.stringOffset()) : 0;
+    uint32 offset = allocateString(std::max(capacity, length));
+    if(inArena)
+    {
+      value = &stringArena_[valueOffset];
+    }
+    entry.setString(offset, 0);
+  }
+  unsigned char * buffer = &stringArena_[entry.stringOffset()];
+  if(length > 0)
+  {
+    memmove(buffer, value, length);
+  }
+  buffer[length] = 0;
+  entry.setString(entry.stringOffset(), uint32(length));
+}
+
+void
+Context::replaceString(DictionaryEntry & entry, size_t pos, size_t removeLength, const unsigned char * value, size_t length)
+{
+  if(!entry.isString())
+  {
+    storeString(entry, value, length);
+    return;
+  }
+  size_t oldLength = entry.stringLength();
+  if(pos > oldLength)
+  {
+    pos = oldLength;
+  }
+  if(removeLength > oldLength - pos)
+  {
+    removeLength = oldLength - pos;
+  }
+  size_t newLength = oldLength - removeLength + length;
+  uint32 offset = entry.stringOffset();
+  uint32 capacity = stringCapacity(offset);
+  // The value may be in the arena, which is about to move or be rearranged.
+  const unsigned char * arena = &stringArena_[0];
+  bool inArena = value >= arena && value < arena + stringArena_.size();
+  size_t valueOffset = inArena ? size_t(value - arena) : 0;
+  if(capacity < newLength)
+  {
+    uint32 newOffset = allocateString(std::max(size_t(2 * capacity), newLength));
+    memcpy(&stringArena_[newOffset], &stringArena_[offset], oldLength);
+    offset = newOffset;
+    capacity = stringCapacity(offset);
+  }
+  std::string overlap;
+  if(inArena)
+  {
+    value = &stringArena_[valueOffset];
+    // Shifting the tail below would overwrite a value taken from this entry's own block.
+    if(valueOffset < offset + capacity + 1 && valueOffset + length > offset)
+    {
+      overlap.assign(reinterpret_cast<const char *>(value), length);
+      value = reinterpret_cast<const unsigned char *>(overlap.data());
+    }
+  }
+  unsigned char * buffer = &stringArena_[offset];
+  memmove(buffer + pos + length, buffer + pos + removeLength, oldLength - pos - removeLength);
+  if(length > 0)
+  {
+    memcpy(buffer + pos, value, length);
+  }
+  buffer[newLength] = 0;
+  entry.setString(offset, uint32(newLength));
+}
 
 bool
 Context::findTemplate(const std::string & name, const std::string & nameSpace, TemplateCPtr & result) const
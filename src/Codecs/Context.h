@@ -10,8 +10,10 @@
 #include <Common/QuickFAST_Export.h>
 #include <Common/Types.h>
 #include <Common/Value.h>
+#include <Codecs/DictionaryEntry.h>
 #include <Common/Exceptions.h>
 #include <Common/WorkingBuffer.h>
+#include <Common/Diagnostics.h>
 #include <Codecs/TemplateRegistry_fwd.h>
 #include <Codecs/Template_fwd.h>
 #include <Messages/FieldIdentity_fwd.h>
@@ -58,6 +60,9 @@ namespace QuickFAST
       }
 
       /// @brief Reset decoding state to initial conditions
+      ///
+      /// Constant time: dictionary entries written before the reset are
+      /// recognized by their generation number and read as undefined.
       /// @param resetTemplateId Normally you want to reset the template ID
       ///        however there are cases when you don't.
       void reset(bool resetTemplateId = true);
@@ -90,12 +95,6 @@ namespace QuickFAST
 
       //////////////////////////////
       // Support for decoding fields
-      /// @brief Find the definition of a field in the dictionary
-      /// @param index identifies the dictionary entry corresponding to this field
-      /// @param value receives the pointer to the value found
-      /// @returns true if a valid entry was found
-      bool findDictionaryField(size_t index, Value *& value);
-
       /// @brief Sets the value in the dictionary to NULL
       /// @param index identifies the dictionary entry corresponding to this field
       void setDictionaryValueNull(size_t index)
@@ -104,7 +103,7 @@ namespace QuickFAST
         {
           throw TemplateDefinitionError("Illegal dictionary index.");
         }
-        indexedDictionary_[index].setNull();
+        writeEntry(index).setNull();
       }
 
       /// @brief Sets the value in the dictionary to be undefined
@@ -115,7 +114,7 @@ namespace QuickFAST
         {
           throw TemplateDefinitionError("Illegal dictionary index.");
         }
-        indexedDictionary_[index].setUndefined();
+        writeEntry(index).setUndefined();
       }
 
       /// @brief Sets the value in the dictionary
@@ -128,7 +127,7 @@ namespace QuickFAST
         {
           throw TemplateDefinitionError("Illegal dictionary index.");
         }
-        indexedDictionary_[index].setValue(value);
+        writeEntry(index).setValue(value);
       }
 
       /// @brief Sets the string value in the dictionary
@@ -141,53 +140,91 @@ namespace QuickFAST
         {
           throw TemplateDefinitionError("Illegal dictionary index.");
         }
-        indexedDictionary_[index].setValue(value, length);
+        storeString(writeEntry(index), value, length);
       }
 
-      /// @brief Get a value from the dictionary
+      /// @brief Sets the string value in the dictionary
       /// @param index identifies the dictionary entry corresponding to this field
-      /// @param value receives the stored value
-      template<typename VALUE_TYPE>
-      DictionaryStatus getDictionaryValue(size_t index, VALUE_TYPE & value)
+      /// @param value is the string to be stored
+      void setDictionaryValue(size_t index, const std::string & value)
+      {
+        setDictionaryValue(index, reinterpret_cast<const unsigned char *>(value.data()), value.size());
+      }
+
+      /// @brief Sets the string value in the dictionary
+      /// @param index identifies the dictionary entry corresponding to this field
+      /// @param value is the null terminated string to be stored
+      void setDictionaryValue(size_t index, const char * value)
+      {
+        setDictionaryValue(index, reinterpret_cast<const unsigned char *>(value), std::strlen(value));
+      }
+
+      /// @brief Replace part of a string in the dictionary in place.
+      ///
+      /// The entry must already hold a string in the current generation.
+      /// @param index identifies the dictionary entry corresponding to this field
+      /// @param pos is the position of the first byte to be replaced.
+      /// @param removeLength is the number of bytes to be replaced.
+      /// @param value is the replacement data.
+      /// @param length is the number of bytes of replacement data.
+      void replaceDictionaryString(size_t index, size_t pos, size_t removeLength, const unsigned char * value, size_t length)
       {
         if(index > indexedDictionarySize_)
         {
           throw TemplateDefinitionError("Illegal dictionary index.");
         }
-        Value & entry = indexedDictionary_[index];
-        if(!entry.isDefined())
-        {
-          return UNDEFINED_VALUE;
-        }
-        if(entry.isNull())
+        replaceString(writeEntry(index), pos, removeLength, value, length);
+      }
+
+      /// @brief Get a value from the dictionary
+      /// @param index identifies the dictionary entry corresponding to this field
+      /// @param value receives the stored value
+      template<typename VALUE_TYPE>
+      DictionaryStatus getDictionaryValue(size_t index, VALUE_TYPE & value)
+      {
+        const DictionaryEntry * entry = 0;
+        DictionaryStatus status = readEntry(index, entry);
+        if(status == OK_VALUE)
         {
-          return NULL_VALUE;
+          (void)entry->getValue(value);
         }
-        (void)entry.getValue(value);
-        return OK_VALUE;
+        return status;
       }
 
-      /// @brief Sets the value in the dictionary
+      /// @brief Get a pointer to a string value in the dictionary
+      ///
+      /// The pointer refers to the dictionary's own storage.  Any later write to
+      /// the dictionary may move that storage, so do not hold the pointer across
+      /// another setDictionaryValue() or replaceDictionaryString() call.  Passing it
+      /// as the value of such a call is safe.
       /// @param index identifies the dictionary entry corresponding to this field
-      /// @param value is the new value for the dictionary entry
-      /// @param length is the length of the string pointed to by value
+      /// @param value receives a pointer to the stored string
+      /// @param length receives the length of the string pointed to by value
       DictionaryStatus getDictionaryValue(size_t index, const unsigned char *& value, size_t &length)
       {
-        if(index > indexedDictionarySize_)
+        const DictionaryEntry * entry = 0;
+        DictionaryStatus status = readEntry(index, entry);
+        if(status == OK_VALUE && entry->isString())
         {
-          throw TemplateDefinitionError("Illegal dictionary index.");
+          value = &stringArena_[entry->stringOffset()];
+          length = entry->stringLength();
         }
-        Value & entry = indexedDictionary_[index];
-        if(!entry.isDefined())
-        {
-          return UNDEFINED_VALUE;
-        }
-        if(entry.isNull())
+        return status;
+      }
+
+      /// @brief Get a string value from the dictionary
+      /// @param index identifies the dictionary entry corresponding to this field
+      /// @param value receives a copy of the stored string
+      DictionaryStatus getDictionaryValue(size_t index, std::string & value)
+      {
+        const unsigned char * buffer = 0;
+        size_t length = 0;
+        DictionaryStatus status = getDictionaryValue(index, buffer, length);
+        if(buffer != 0)
         {
-          return NULL_VALUE;
+          value.assign(reinterpret_cast<const char *>(buffer), length);
         }
-        (void)entry.getValue(value, length);
-        return OK_VALUE;
+        return status;
       }
 
       /// @brief Report a warning
@@ -286,8 +323,13 @@ namespace QuickFAST
 
       /// @brief Enable some debugging/diagnostic information to be written to an ostream
       /// @param out the ostream to receive the data
+      /// @throws UsageError if QuickFAST was built with QUICKFAST_NO_DIAGNOSTICS
       void setVerboseOutput(std::ostream & out)
       {
+        if(!QUICKFAST_DIAGNOSTICS)
+        {
+          throw UsageError("Coding Error", "Verbose output is not available: QuickFAST was built with QUICKFAST_NO_DIAGNOSTICS.");
+        }
         verboseOut_ = &out;
       }
 
@@ -301,7 +343,7 @@ namespace QuickFAST
       /// @returns a pointer to the verbose output stream or zero if disabled
       std::ostream * getVerboseOut()const
       {
-        return verboseOut_;
+        return QUICKFAST_DIAGNOSTICS ? verboseOut_ : 0;
       }
 
       /// @brief enable logging to the supplied ostream
@@ -351,10 +393,58 @@ namespace QuickFAST
 
       /// false makes the Xcoder more forgiving
       bool strict_;
+    private:
+      /// @brief Find a dictionary entry that is about to be written.
+      ///
+      /// Marks the entry as belonging to the current generation.
+      /// The caller has checked the index.
+      DictionaryEntry & writeEntry(size_t index)
+      {
+        DictionaryEntry & entry = indexedDictionary_[index];
+        entry.setGeneration(generation_);
+        return entry;
+      }
+
+      /// @brief Find a dictionary entry that is about to be read.
+      DictionaryStatus readEntry(size_t index, const DictionaryEntry *& entry)const
+      {
+        if(index > indexedDictionarySize_)
+        {
+          throw TemplateDefinitionError("Illegal dictionary index.");
+        }
+        entry = &indexedDictionary_[index];
+        if(entry->generation() != generation_ || !entry->isDefined())
+        {
+          return UNDEFINED_VALUE;
+        }
+        if(entry->isNull())
+        {
+          return NULL_VALUE;
+        }
+        return OK_VALUE;
+      }
+
+      /// @brief Store a string in the entry's arena block, growing the block if necessary.
+      void storeString(DictionaryEntry & entry, const unsigned char * value, size_t length);
+
+      /// @brief Replace part of the string in the entry's arena block.
+      void replaceString(DictionaryEntry & entry, size_t pos, size_t removeLength, const unsigned char * value, size_t length);
+
+      /// @brief Allocate a block in the string arena.
+      /// @returns the offset of the block's data.
+      uint32 allocateString(size_t capacity);
+
+      /// @brief How many bytes the block at offset can hold.
+      uint32 stringCapacity(uint32 offset)const;
+
     private:
       size_t indexedDictionarySize_;
-      typedef boost::scoped_array<Value> IndexedDictionary;
+      typedef boost::scoped_array<DictionaryEntry> IndexedDictionary;
       IndexedDictionary indexedDictionary_;
+      /// Holds the strings for the dictionary.  Each block is preceded by its capacity.
+      std::vector<unsigned char> stringArena_;
+      /// Incremented by reset().  Entries from earlier generations are undefined.
+      uint32 generation_;
       WorkingBuffer workingBuffer_;
     };
   }
@@ -0,0 +1,127 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "DataDestination.h"
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  const size_t minimumCapacity = 256;
+}
+
+DataDestination::DataDestination()
+  : buffer_(0)
+  , capacity_(0)
+  , used_(0)
+  , packed_(0)
+  , active_(NotABuffer)
+  , verboseOut_(0)
+{
+}
+
+DataDestination::~DataDestination()
+{
+  delete [] buffer_;
+}
+
+void
+DataDestination::grow(size_t required)
+{
+  size_t capacity = std::max(std::max(required, capacity_ * 2), minimumCapacity);
+  uchar * buffer = new uchar[capacity];
+  if(used_ > 0)
+  {
+    // Reserved room at the end may not have been allocated yet.
+    const Region & last = regions_[used_ - 1];
+    std::memcpy(buffer, buffer_, std::min(last.start_ + last.size_, capacity_));
+  }
+  delete [] buffer_;
+  buffer_ = buffer;
+  capacity_ = capacity;
+}
+
+void
+DataDestination::makeRoom(size_t index, size_t extra)
+{
+  // The reserved room was too small.  Move everything after this buffer.
+  size_t last = used_ - 1;
+  size_t end = regions_[last].start_ + regions_[last].size_;
+  if(end + extra > capacity_)
+  {
+    grow(end + extra);
+  }
+  size_t from = regions_[index + 1].start_;
+  std::memmove(buffer_ + from + extra, buffer_ + from, end - from);
+  for(size_t nRegion = index + 1; nRegion <= last; ++nRegion)
+  {
+    regions_[nRegion].start_ += extra;
+  }
+  regions_[index].capacity_ += extra;
+}
+
+void
+DataDestination::compact()
+{
+  if(used_ == 0)
+  {
+    return;
+  }
+  size_t last = used_ - 1;
+  size_t first = packed_;
+  while(first < last && regions_[first].size_ == regions_[first].capacity_)
+  {
+    ++first;
+  }
+  if(first < last)
+  {
+    Region & hole = regions_[first];
+    size_t gap = hole.capacity_ - hole.size_;
+    size_t prefix = hole.start_ + hole.size_ - regions_[0].start_;
+    size_t suffix = regions_[last].start_ + regions_[last].size_ - regions_[first + 1].start_;
+    if(packed_ == 0 && prefix < suffix)
+    {
+      // The first unused room usually follows the presence map at the start of
+      // the message.  Move the presence map rather than the rest of the message.
+      size_t from = regions_[0].start_;
+      std::memmove(buffer_ + from + gap, buffer_ + from, prefix);
+      for(size_t nRegion = 0; nRegion <= first; ++nRegion)
+      {
+        regions_[nRegion].start_ += gap;
+      }
+    }
+    hole.capacity_ = hole.size_;
+    size_t to = hole.start_ + hole.size_;
+    for(size_t nRegion = first + 1; nRegion <= last; ++nRegion)
+    {
+      Region & region = regions_[nRegion];
+      if(region.start_ != to)
+      {
+        std::memmove(buffer_ + to, buffer_ + region.start_, region.size_);
+        region.start_ = to;
+      }
+      region.capacity_ = region.size_;
+      to += region.size_;
+    }
+  }
+  packed_ = last;
+}
+
+void
+DataDestination::logBytes(const uchar * bytes, size_t count)
+{
+  const Region & region = regions_[active_];
+  size_t position = region.size_ - count;
+  for(size_t nByte = 0; nByte < count; ++nByte)
+  {
+    (*verboseOut_)
+      << '[' << active_ << ':' << ++position << ']'
+      << std::hex << std::setw(2) << std::setfill('0')
+      << static_cast<unsigned short>(bytes[nByte])
+      << std::setfill(' ') << std::dec << ' ';
+    static size_t mod = 0; // keep the lines from getting too long
+    if(++mod % 16 == 0) (*verboseOut_) << std::endl;
+  }
+}
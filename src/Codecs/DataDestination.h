@@ -1,4 +1,4 @@
-// Copyright (c) 2009, Object Computing, Inc.
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
 // All rights reserved.
 // See the file license.txt for licensing information.
 #ifdef _MSC_VER
@@ -11,6 +11,8 @@
 #include <Common/QuickFAST_Export.h>
 #include <Common/Types.h>
 #include <Common/WorkingBuffer.h>
+#include <Common/Diagnostics.h>
+#include <Communication/LinkedBuffer.h>
 #include <boost/asio.hpp>
 namespace QuickFAST{
   namespace Codecs{
@@ -23,10 +25,14 @@ namespace QuickFAST{
     /// encoded so the buffer holding them may be filled in after the buffer holding
     /// the fields even though it will appear first in the output stream.
     ///
-    /// Different implementations of DataDestination may use scatter/gather I/O; may
-    /// send the individual buffers separately; or may assemble them into a common
-    /// buffer when endMessage() is called.
-    class /*QuickFAST_Export */ DataDestination
+    /// All buffers share a single contiguous block of memory.  When a new buffer is
+    /// started the caller may reserve room at the end of the current buffer for data
+    /// that will be back-patched later (i.e. the presence map.)  Data that fits in the
+    /// reserved room is written in place.  Only if it overflows is the data that follows
+    /// moved to make room.  Reserved room that is not used is squeezed out by
+    /// endMessage() so the encoded data is contiguous and can be used in place via
+    /// data() and length() or toLinkedBuffer().
+    class QuickFAST_Export DataDestination
     {
     public:
       /// @brief a type for an opaque handle to a buffer within the DataDestination
@@ -34,17 +40,10 @@ namespace QuickFAST{
       /// @brief special handle for a buffer that doesn't exist
       static const BufferHandle NotABuffer = ~0U;
 
-      DataDestination()
-        : used_(0)
-        , active_(NotABuffer)
-        , verboseOut_(0)
-      {
-      }
+      DataDestination();
 
       /// @brief Until DataDestinationString is retired, allow for inheritence.
-      virtual ~DataDestination()
-      {
-      }
+      virtual ~DataDestination();
 
       /// @brief Enable verbose output as information is added to the data destination
       ///
@@ -63,17 +62,27 @@ namespace QuickFAST{
       /// @brief start a new buffer at the end of the set.
       ///
       /// The new buffer will be selected for output automatically
+      /// @param reserve is how many bytes to leave room for at the end of the
+      ///        previous buffer, which is expected to be selected and appended to later.
       /// @returns a "handle" to the buffer to be used with selectBuffer()
-      BufferHandle startBuffer()
+      BufferHandle startBuffer(size_t reserve = 0)
       {
-        if(used_ == buffers_.size())
+        size_t start = 0;
+        if(used_ > 0)
         {
-          WorkingBuffer empty;
-          buffers_.push_back(empty);
+          Region & last = regions_[used_ - 1];
+          last.capacity_ = last.size_ + reserve;
+          start = last.start_ + last.capacity_;
         }
-        assert(used_ < buffers_.size());
+        if(used_ == regions_.size())
+        {
+          regions_.push_back(Region());
+        }
+        Region & region = regions_[used_];
+        region.start_ = start;
+        region.size_ = 0;
+        region.capacity_ = 0;
         active_ = used_++;
-        buffers_[active_].clear(false);
         return active_;
       }
 
@@ -81,20 +90,25 @@ namespace QuickFAST{
       /// @param byte is the datum to be appended.
       void putByte(uchar byte)
       {
-        if(active_ == NotABuffer)
+        *room(1) = byte;
+        if(QUICKFAST_DIAGNOSTICS && verboseOut_)
         {
-          (void)startBuffer();
+          logBytes(&byte, 1);
         }
-        buffers_[active_].push(byte);
-        if(verboseOut_)
+      }
+
+      /// @brief Append bytes to the end of the currently selected buffer.
+      /// @param bytes points to the data to be appended.
+      /// @param count is the number of bytes to append.
+      void putBytes(const uchar * bytes, size_t count)
+      {
+        if(count > 0)
         {
-          (*verboseOut_)
-            << '[' << active_ << ':' << buffers_[active_].size() << ']'
-            << std::hex << std::setw(2) << std::setfill('0')
-            << static_cast<unsigned short>(byte)
-            << std::setfill(' ') << std::dec << ' ';
-          static size_t mod = 0; // keep the lines from getting too long
-          if(++mod % 16 == 0) (*verboseOut_) << std::endl;
+          std::memcpy(room(count), bytes, count);
+          if(QUICKFAST_DIAGNOSTICS && verboseOut_)
+          {
+            logBytes(bytes, count);
+          }
         }
       }
 
@@ -119,11 +133,8 @@ namespace QuickFAST{
       /// @brief Discard all buffered data.  Ready to start a new encoding cycle.
       void clear()
       {
-        for(size_t handle = 0; handle < buffers_.size(); ++handle)
-        {
-          buffers_[handle].clear(false);
-        }
         used_ = 0;
+        packed_ = 0;
         active_ = NotABuffer;
       }
 
@@ -139,7 +150,7 @@ namespace QuickFAST{
 
       /// @brief Notification that we're starting a new field.
       /// @param identity identifies the field.
-      void startField(const Messages::FieldIdentity identity)
+      void startField(const Messages::FieldIdentity & identity)
       {
         if(verboseOut_)
         {
@@ -148,7 +159,7 @@ namespace QuickFAST{
       }
       /// @brief Notification that a field has been completely encoded
       /// @param identity identifies the field.
-      void endField(const Messages::FieldIdentity identity)
+      void endField(const Messages::FieldIdentity & identity)
       {
         if(verboseOut_)
         {
@@ -157,32 +168,70 @@ namespace QuickFAST{
       }
 
       /// @brief Indicate the message is ready to be sent.
+      ///
+      /// Squeezes out any reserved room that was not used.
       void endMessage()
       {
+        compact();
         if(verboseOut_)
         {
           (*verboseOut_) << std::endl << "**END MESSAGE" << std::endl;
         }
       }
 
+      /// @brief Squeeze out any reserved room that was not used.
+      ///
+      /// Called by endMessage().  Call it explicitly only if data() is needed
+      /// for data that was not written by an Encoder.
+      void compact();
+
+      /// @brief Access the encoded data in place.
+      ///
+      /// Valid after endMessage() or compact() until more data is written.
+      const uchar * data()const
+      {
+        if(used_ == 0)
+        {
+          return buffer_;
+        }
+        return buffer_ + regions_[0].start_;
+      }
+
+      /// @brief How many bytes of encoded data are present.
+      size_t length()const
+      {
+        size_t result = 0;
+        for(size_t nRegion = 0; nRegion < used_; ++nRegion)
+        {
+          result += regions_[nRegion].size_;
+        }
+        return result;
+      }
+
+      /// @brief Wrap the encoded data in a LinkedBuffer without copying it.
+      ///
+      /// The LinkedBuffer refers to memory owned by this DataDestination, so it
+      /// must be sent before this DataDestination is cleared, written, or destroyed.
+      /// @param buffer will refer to the encoded data
+      void toLinkedBuffer(Communication::LinkedBuffer & buffer)
+      {
+        compact();
+        buffer.setExternal(data(), length());
+      }
+
       /// @brief Convert results to string.
       ///
-      /// For best performance, use toWorkingBuffer rather than this method
+      /// For best performance, use data() rather than this method
       /// or else use gather/write treating this object as an asio::ConstBufferSequence
       /// @param result is the Strubg into which the data will be copied.
       void toString(std::string & result)const
       {
-        size_t size = 0;
-        for(size_t pos = 0; pos < buffers_.size(); ++pos)
-        {
-          size += buffers_[pos].size();
-        }
         result.clear();
-        result.reserve(size);
-        for(size_t pos = 0; pos < buffers_.size(); ++pos)
+        result.reserve(length());
+        for(size_t nRegion = 0; nRegion < used_; ++nRegion)
         {
-          result.append(reinterpret_cast<const char *>(buffers_[pos].begin()),
-            buffers_[pos].size());
+          const Region & region = regions_[nRegion];
+          result.append(reinterpret_cast<const char *>(buffer_ + region.start_), region.size_);
         }
       }
 
@@ -191,15 +240,11 @@ namespace QuickFAST{
       /// @param result is the WorkingBuffer into which the data will be copied.
       void toWorkingBuffer(WorkingBuffer & result) const
       {
-        size_t size = 0;
-        for(size_t pos = 0; pos < buffers_.size(); ++pos)
-        {
-          size += buffers_[pos].size();
-        }
-        result.clear(false, size);
-        for(size_t pos = 0; pos < buffers_.size(); ++pos)
+        result.clear(false, length());
+        for(size_t nRegion = 0; nRegion < used_; ++nRegion)
         {
-          result.append(buffers_[pos]);
+          const Region & region = regions_[nRegion];
+          result.append(buffer_ + region.start_, region.size_);
         }
       }
 
@@ -245,15 +290,13 @@ namespace QuickFAST{
         /// @brief dereference the iterator to find the actual buffer
         boost::asio::const_buffer operator * () const
         {
-          const WorkingBuffer & buffer(destination_[position_]);
-          return boost::asio::const_buffer(buffer.begin(), buffer.size());
+          return destination_[position_];
         }
 
         /// @brief dereference the iterator to find the actual buffer
         boost::asio::const_buffer operator -> () const
         {
-          const WorkingBuffer & buffer(destination_[position_]);
-          return boost::asio::const_buffer(buffer.begin(), buffer.size());
+          return destination_[position_];
         }
 
         /// @brief compare iterators.
@@ -297,26 +340,69 @@ namespace QuickFAST{
 
       /// @brief indexed access to a buffer in the set.
       /// @param index should be < size()
-      const WorkingBuffer & operator[](size_t index)const
+      boost::asio::const_buffer operator[](size_t index)const
       {
-        return buffers_[index];
+        const Region & region = regions_[index];
+        return boost::asio::const_buffer(buffer_ + region.start_, region.size_);
       }
 
     private:
       DataDestination & operator = (const DataDestination &); // forbidden assignment
       DataDestination(const DataDestination &); // forbidden copy constructor
 
+      /// @brief Make room for count bytes at the end of the active buffer.
+      /// @returns where to put them.
+      uchar * room(size_t count)
+      {
+        if(active_ == NotABuffer)
+        {
+          (void)startBuffer();
+        }
+        Region & region = regions_[active_];
+        if(active_ + 1 < used_ && region.size_ + count > region.capacity_)
+        {
+          makeRoom(active_, region.size_ + count - region.capacity_);
+        }
+        size_t required = region.start_ + region.size_ + count;
+        if(required > capacity_)
+        {
+          grow(required);
+        }
+        uchar * result = buffer_ + region.start_ + region.size_;
+        region.size_ += count;
+        return result;
+      }
+
+      void grow(size_t required);
+      void makeRoom(size_t index, size_t extra);
+      void logBytes(const uchar * bytes, size_t count);
+
     private:
+      /// @brief A buffer is a region within buffer_.
+      struct Region
+      {
+        /// @brief offset of the first byte
+        size_t start_;
+        /// @brief how many bytes are in use
+        size_t size_;
+        /// @brief how many bytes may be used without moving the buffers that follow.
+        /// Not used for the last buffer which can always grow.
+        size_t capacity_;
+      };
+      /// @brief The memory shared by all buffers.
+      uchar * buffer_;
+      /// @brief The size of buffer_
+      size_t capacity_;
+      /// @brief The buffers.
+      std::vector<Region> regions_;
       /// @brief how many buffers contain data.
       size_t used_;
+      /// @brief how many buffers are known to have no unused reserved room.
+      size_t packed_;
       /// @brief which buffer will receive pushes
       size_t active_;
-      /// @brief A type to store the buffers in vectors
-      typedef std::vector<WorkingBuffer> BufferVector;
-      BufferVector buffers_;
       /// @brief Where to write noisy/debug output.
       std::ostream * verboseOut_;
-
     };
   }
 }
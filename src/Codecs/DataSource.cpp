@@ -82,6 +82,10 @@ DataSource::setEcho(
   bool verboseMessages/* = true */,
   bool verboseFields/* = false */)
 {
+  if(!QUICKFAST_DIAGNOSTICS)
+  {
+    throw UsageError("Coding Error", "Echo is not available: QuickFAST was built with QUICKFAST_NO_DIAGNOSTICS.");
+  }
   echo_ = &echo;
   if (echoType == HEX)
   {
@@ -105,7 +109,7 @@ DataSource::setEcho(
 void
 DataSource::beginMessage()
 {
-  if(echo_ && verboseMessages_)
+  if(QUICKFAST_DIAGNOSTICS && echo_ && verboseMessages_)
   {
     (*echo_) << std::endl << "***MESSAGE @" << std::hex << byteCount_ << std::dec << "***" << std::endl;
   }
@@ -114,7 +118,7 @@ DataSource::beginMessage()
 void
 DataSource::beginField(const std::string & name)
 {
-  if(echo_ && verboseFields_)
+  if(QUICKFAST_DIAGNOSTICS && echo_ && verboseFields_)
   {
     if(!echoString_.empty())
     {
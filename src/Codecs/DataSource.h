@@ -11,6 +11,8 @@
 #include <Common/Types.h>
 #include <Common/StringBuffer.h>
 #include <Common/Exceptions.h>
+#include <Common/StopBitScanner.h>
+#include <Common/Diagnostics.h>
 #include <Application/DecoderConfiguration_fwd.h>
 namespace QuickFAST{
   namespace Codecs{
@@ -76,6 +78,21 @@ namespace QuickFAST{
         return (position_ + needed <= size_);
       }
 
+      /// @brief Find the next stop-bit-terminated entity in the current buffer
+      ///
+      /// Nothing is consumed.  Use skipContiguous(length) after using the data.
+      /// @param[out] buffer points to the beginning of the entity
+      /// @param[out] length is the size of the entity including the byte with the stop bit.
+      /// @returns true if the entire entity is in the current buffer.
+      inline
+      bool findStopBit(const uchar *& buffer, size_t & length)
+      {
+        buffer = buffer_ + position_;
+        size_t available = size_ - position_;
+        length = StopBitScanner::find(buffer, available) + 1;
+        return length <= available;
+      }
+
       /// @brief Skip over contiguous bytes
       ///
       /// presumably after calling hasContiguous to find the contiguous bytes
@@ -83,7 +100,7 @@ namespace QuickFAST{
       inline
       void skipContiguous(size_t used)
       {
-        if(echo_)
+        if(QUICKFAST_DIAGNOSTICS && echo_)
         {
           size_t end = position_ + used;
           while (position_ < end)
@@ -124,7 +141,7 @@ namespace QuickFAST{
           ok = false;
         }
 
-        if(echo_)
+        if(QUICKFAST_DIAGNOSTICS && echo_)
         {
           doEcho(ok, byte);
         }
@@ -171,7 +188,7 @@ namespace QuickFAST{
       /// @returns a pointer to the echo stream; 0 means no echo
       std::ostream * getEcho()const
       {
-        return echo_;
+        return QUICKFAST_DIAGNOSTICS ? echo_ : 0;
       }
 
       /// @brief Discard any remaining contents and prepare for new data.
@@ -0,0 +1,119 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "DecodePlan.h"
+#include <Codecs/SegmentBody.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldOp.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  DecodePlan::OpCode integerNop(ValueType::Type type)
+  {
+    switch(type)
+    {
+    case ValueType::UINT32:
+      return DecodePlan::UINT32_NOP;
+    case ValueType::INT32:
+      return DecodePlan::INT32_NOP;
+    case ValueType::UINT64:
+      return DecodePlan::UINT64_NOP;
+    case ValueType::INT64:
+      return DecodePlan::INT64_NOP;
+    default:
+      return DecodePlan::NOP;
+    }
+  }
+
+  DecodePlan::OpCode integerCopy(ValueType::Type type)
+  {
+    switch(type)
+    {
+    case ValueType::UINT32:
+      return DecodePlan::UINT32_COPY;
+    case ValueType::INT32:
+      return DecodePlan::INT32_COPY;
+    case ValueType::UINT64:
+      return DecodePlan::UINT64_COPY;
+    case ValueType::INT64:
+      return DecodePlan::INT64_COPY;
+    default:
+      return DecodePlan::COPY;
+    }
+  }
+}
+
+DecodePlan::DecodePlan()
+: compiled_(false)
+{
+}
+
+void
+DecodePlan::compile(const SegmentBody & segment)
+{
+  steps_.clear();
+  size_t instructionCount = segment.size();
+  steps_.reserve(instructionCount);
+  for(size_t pos = 0; pos < instructionCount; ++pos)
+  {
+    const FieldInstructionCPtr & instruction = segment.getInstruction(pos);
+    FieldOpCPtr fieldOp = instruction->getFieldOp();
+    Step step;
+    step.opCode = GENERIC;
+    step.mandatory = instruction->isMandatory();
+    step.ignoreOverflow = instruction->getIgnoreOverflow();
+    step.pmapBit = fieldOp->getPMapBit();
+    step.dictionaryIndex = fieldOp->getDictionaryIndex();
+    step.instruction = instruction.get();
+
+    // The choices here must match the dispatching done by the FieldOp::decode implementations.
+    ValueType::Type type = instruction->fieldInstructionType();
+    switch(fieldOp->opType())
+    {
+    case FieldOp::NOP:
+      step.opCode = integerNop(type);
+      break;
+    case FieldOp::CONSTANT:
+      step.opCode = CONSTANT;
+      break;
+    case FieldOp::DEFAULT:
+      step.opCode = DEFAULT;
+      break;
+    case FieldOp::COPY:
+      if(fieldOp->hasPMapBit())
+      {
+        step.opCode = COPY_PMAP_BIT;
+      }
+      else
+      {
+        step.opCode = integerCopy(type);
+      }
+      break;
+    case FieldOp::DELTA:
+      step.opCode = DELTA;
+      break;
+    case FieldOp::INCREMENT:
+      if(fieldOp->hasPMapBit())
+      {
+        step.opCode = INCREMENT_PMAP_BIT;
+      }
+      else
+      {
+        step.opCode = INCREMENT;
+      }
+      break;
+    case FieldOp::TAIL:
+      step.opCode = TAIL;
+      break;
+    default:
+      step.opCode = GENERIC;
+      break;
+    }
+    steps_.push_back(step);
+  }
+  compiled_ = true;
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef DECODEPLAN_H
+#define DECODEPLAN_H
+#include "DecodePlan_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Codecs/FieldInstruction_fwd.h>
+#include <Codecs/SegmentBody_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief A flattened, precompiled description of how to decode a SegmentBody.
+    ///
+    /// The normal decoding path for a field goes through two virtual calls:
+    /// FieldInstruction::decode calls FieldOp::decode which calls back into the
+    /// FieldInstruction's decodeXxx method for the appropriate operator.
+    ///
+    /// A DecodePlan resolves that dispatch once, when the TemplateRegistry is finalized.
+    /// Each Step records the combination of field type, operator, presence and
+    /// dictionary index for one field instruction so the Decoder can run the
+    /// segment with a single switch statement. The most common integer cases
+    /// are decoded inline by the Decoder.  Everything else is delegated directly
+    /// to the operator-specific method on the FieldInstruction.
+    ///
+    /// @see Decoder::setUseDecodePlan()
+    class QuickFAST_Export DecodePlan
+    {
+    public:
+      /// @brief Identify the action to be taken for a Step.
+      enum OpCode
+      {
+        /// Use FieldInstruction::decode() (no precompiled knowledge)
+        GENERIC,
+        /// Call decodeNop()
+        NOP,
+        /// Call decodeConstant()
+        CONSTANT,
+        /// Call decodeDefault()
+        DEFAULT,
+        /// Call decodeCopy() using the next presence map bit
+        COPY,
+        /// Call decodeCopy() using an explicitly assigned presence map bit
+        COPY_PMAP_BIT,
+        /// Call decodeDelta()
+        DELTA,
+        /// Call decodeIncrement() using the next presence map bit
+        INCREMENT,
+        /// Call decodeIncrement() using an explicitly assigned presence map bit
+        INCREMENT_PMAP_BIT,
+        /// Call decodeTail()
+        TAIL,
+        /// Decode a nop uint32 field inline
+        UINT32_NOP,
+        /// Decode a nop int32 field inline
+        INT32_NOP,
+        /// Decode a nop uint64 field inline
+        UINT64_NOP,
+        /// Decode a nop int64 field inline
+        INT64_NOP,
+        /// Decode a copy uint32 field inline
+        UINT32_COPY,
+        /// Decode a copy int32 field inline
+        INT32_COPY,
+        /// Decode a copy uint64 field inline
+        UINT64_COPY,
+        /// Decode a copy int64 field inline
+        INT64_COPY
+      };
+
+      /// @brief One entry in the plan.  Corresponds to one FieldInstruction.
+      struct Step
+      {
+        /// What to do.
+        OpCode opCode;
+        /// Is the field mandatory?
+        bool mandatory;
+        /// Should integer overflow be ignored?
+        bool ignoreOverflow;
+        /// Presence map bit for operators with an explicit pmap bit.
+        size_t pmapBit;
+        /// Index into the Context's dictionary (valid only for operators that use a dictionary)
+        size_t dictionaryIndex;
+        /// The instruction that this step was compiled from.
+        /// Owned by the SegmentBody that owns this plan.
+        const FieldInstruction * instruction;
+      };
+
+      /// @brief Construct an empty plan.
+      DecodePlan();
+
+      /// @brief Build the plan for the instructions in a segment body.
+      ///
+      /// The segment must be finalized, and its dictionaries indexed, before the plan is compiled.
+      /// @param segment supplies the field instructions.
+      void compile(const SegmentBody & segment);
+
+      /// @brief Has compile() been called?
+      bool isCompiled()const
+      {
+        return compiled_;
+      }
+
+      /// @brief How many steps are in the plan?
+      size_t size()const
+      {
+        return steps_.size();
+      }
+
+      /// @brief Access a step by position
+      /// @param index must be less than size()
+      const Step & operator[](size_t index)const
+      {
+        return steps_[index];
+      }
+
+    private:
+      std::vector<Step> steps_;
+      bool compiled_;
+    };
+  }
+}
+#endif // DECODEPLAN_H
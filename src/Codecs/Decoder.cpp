@@ -5,17 +5,131 @@
 
 #include "Decoder.h"
 #include <Codecs/DataSource.h>
+#include <Codecs/DataSourceBuffer.h>
 #include <Codecs/PresenceMap.h>
 #include <Codecs/TemplateRegistry.h>
 #include <Codecs/FieldInstruction.h>
+#include <Codecs/DecodePlan.h>
 #include <Messages/ValueMessageBuilder.h>
 #include <Common/Profiler.h>
 
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
 
+namespace
+{
+  // Inline versions of FieldInstructionInteger::decodeNop and decodeCopy for use by DecodePlans.
+  // The uncommon cases are delegated back to the field instruction.
+  template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+  inline void decodePlanInteger(
+    DataSource & source,
+    Decoder & decoder,
+    const DecodePlan::Step & step,
+    INTEGER_TYPE & value)
+  {
+    if(SIGNED) // expect compile-time optimization here
+    {
+      FieldInstruction::decodeSignedInteger(
+        source, decoder, value, step.instruction->getName(), false, step.ignoreOverflow);
+    }
+    else
+    {
+      FieldInstruction::decodeUnsignedInteger(
+        source, decoder, value, step.instruction->getName(), step.ignoreOverflow);
+    }
+  }
+
+  template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+  void decodePlanIntegerNop(
+    DataSource & source,
+    Decoder & decoder,
+    const DecodePlan::Step & step,
+    Messages::ValueMessageBuilder & builder)
+  {
+    INTEGER_TYPE value = 0;
+    decodePlanInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>(source, decoder, step, value);
+    // not mandatory means it's nullable
+    if(step.mandatory || !FieldInstruction::checkNullInteger(value))
+    {
+      builder.addValue(step.instruction->getIdentity(), VALUE_TYPE, value);
+    }
+  }
+
+  template<typename INTEGER_TYPE, ValueType::Type VALUE_TYPE, bool SIGNED>
+  void decodePlanIntegerCopy(
+    DataSource & source,
+    PresenceMap & pmap,
+    Decoder & decoder,
+    const DecodePlan::Step & step,
+    Messages::ValueMessageBuilder & builder)
+  {
+    if(pmap.checkNextField())
+    {
+      INTEGER_TYPE value = 0;
+      decodePlanInteger<INTEGER_TYPE, VALUE_TYPE, SIGNED>(source, decoder, step, value);
+      if(!step.mandatory && FieldInstruction::checkNullInteger(value))
+      {
+        decoder.setDictionaryValueNull(step.dictionaryIndex);
+      }
+      else
+      {
+        builder.addValue(step.instruction->getIdentity(), VALUE_TYPE, value);
+        decoder.setDictionaryValue(step.dictionaryIndex, value);
+      }
+    }
+    else
+    {
+      INTEGER_TYPE previousValue = 0;
+      if(decoder.getDictionaryValue(step.dictionaryIndex, previousValue) == Context::OK_VALUE)
+      {
+        builder.addValue(step.instruction->getIdentity(), VALUE_TYPE, previousValue);
+      }
+      else
+      {
+        // initial values and error reporting are handled by the instruction.
+        step.instruction->decodeCopy(source, false, decoder, builder);
+      }
+    }
+  }
+}
+
+/// Nested segments (groups, sequence entries and templates) each need a presence map.
+/// Rather than constructing one on the stack each time, reuse the one for this nesting depth.
+class Decoder::PresenceMapScope
+{
+public:
+  PresenceMapScope(Decoder & decoder, size_t bitCount)
+    : decoder_(decoder)
+  {
+    size_t depth = decoder_.presenceMapDepth_;
+    if(depth >= decoder_.presenceMaps_.size())
+    {
+      decoder_.presenceMaps_.push_back(PresenceMapPtr(new PresenceMap(bitCount)));
+    }
+    pmap_ = decoder_.presenceMaps_[depth].get();
+    pmap_->setVerbose(decoder_.verboseOut_);
+    decoder_.presenceMapDepth_ = depth + 1;
+  }
+
+  ~PresenceMapScope()
+  {
+    decoder_.presenceMapDepth_ -= 1;
+  }
+
+  PresenceMap & pmap()
+  {
+    return *pmap_;
+  }
+
+private:
+  Decoder & decoder_;
+  PresenceMap * pmap_;
+};
+
 Decoder::Decoder(Codecs::TemplateRegistryPtr registry)
 : Context(registry)
+, useDecodePlan_(false)
+, presenceMapDepth_(0)
 {
 }
 
@@ -32,42 +146,46 @@ Decoder::decodeMessage(
   PROFILE_POINT("decode");
   source.beginMessage();
 
-  Codecs::PresenceMap pmap(getTemplateRegistry()->presenceMapBits());
-  if(this->verboseOut_)
-  {
-    pmap.setVerbose(verboseOut_);
-  }
+  PresenceMapScope scope(*this, getTemplateRegistry()->presenceMapBits());
+  Codecs::PresenceMap & pmap = scope.pmap();
 
   static const std::string pmp("PMAP");
-  source.beginField(pmp);
+  if(QUICKFAST_DIAGNOSTICS)
+  {
+    source.beginField(pmp);
+  }
   pmap.decode(source);
 
   static const std::string tid("templateID");
-  source.beginField(tid);
+  if(QUICKFAST_DIAGNOSTICS)
+  {
+    source.beginField(tid);
+  }
   if(pmap.checkNextField())
   {
     template_id_t id;
     FieldInstruction::decodeUnsignedInteger(source, *this, id, tid);
     setTemplateId(id);
   }
-  if(verboseOut_)
+  if(QUICKFAST_DIAGNOSTICS && verboseOut_)
   {
     (*verboseOut_) << "Template ID: " << getTemplateId() << std::endl;
   }
-  Codecs::TemplateCPtr templatePtr;
-  if(getTemplateRegistry()->getTemplate(templateId_, templatePtr))
+  const Codecs::Template * templatePtr = getTemplateRegistry()->findTemplate(templateId_);
+  if(templatePtr != 0)
   {
     if(templatePtr->getReset())
     {
       reset(false);
     }
+    messageBuilder.selectTemplate(templateId_);
     Messages::ValueMessageBuilder & bodyBuilder(
       messageBuilder.startMessage(
         templatePtr->getApplicationType(),
         templatePtr->getApplicationTypeNamespace(),
         templatePtr->fieldCount()));
 
-    decodeSegmentBody(source, pmap, templatePtr, bodyBuilder);
+    decodeSegmentBody(source, pmap, *templatePtr, bodyBuilder);
     if(templatePtr->getIgnore())
     {
       messageBuilder.ignoreMessage(bodyBuilder);
@@ -90,36 +208,62 @@ Decoder::decodeMessage(
   return;
 }
 
+size_t
+Decoder::decodeBatch(
+  const uchar * data,
+  size_t length,
+  Messages::ValueMessageBuilder & builder,
+  size_t & bytesUsed,
+  size_t maxMessages)
+{
+  PROFILE_POINT("decodeBatch");
+  DataSourceBuffer source(data, length);
+  size_t messageCount = 0;
+  bytesUsed = 0;
+  // bytesAvailable() loads the buffer the first time through.
+  while(source.bytesAvailable() > 0 && (maxMessages == 0 || messageCount < maxMessages))
+  {
+    decodeMessage(source, builder);
+    ++messageCount;
+    // kept current so the caller knows what was consumed if the next message throws.
+    bytesUsed = length - source.currentBytesAvailable();
+  }
+  return messageCount;
+}
+
 void
 Decoder::decodeNestedTemplate(
    DataSource & source,
    Messages::ValueMessageBuilder & messageBuilder,
    const Messages::FieldIdentity & identity)
 {
-  Codecs::PresenceMap pmap(getTemplateRegistry()->presenceMapBits());
-  if(this->verboseOut_)
-  {
-    pmap.setVerbose(verboseOut_);
-  }
+  PresenceMapScope scope(*this, getTemplateRegistry()->presenceMapBits());
+  Codecs::PresenceMap & pmap = scope.pmap();
 
   static const std::string pmp("PMAP");
-  source.beginField(pmp);
+  if(QUICKFAST_DIAGNOSTICS)
+  {
+    source.beginField(pmp);
+  }
   pmap.decode(source);
 
   static const std::string tid("templateID");
-  source.beginField(tid);
+  if(QUICKFAST_DIAGNOSTICS)
+  {
+    source.beginField(tid);
+  }
   if(pmap.checkNextField())
   {
     template_id_t id;
     FieldInstruction::decodeUnsignedInteger(source, *this, id, tid);
     setTemplateId(id);
   }
-  if(verboseOut_)
+  if(QUICKFAST_DIAGNOSTICS && verboseOut_)
   {
     (*verboseOut_) << "Nested Template ID: " << getTemplateId() << std::endl;
   }
-  Codecs::TemplateCPtr templatePtr;
-  if(getTemplateRegistry()->getTemplate(getTemplateId(), templatePtr))
+  const Codecs::Template * templatePtr = getTemplateRegistry()->findTemplate(getTemplateId());
+  if(templatePtr != 0)
   {
     if(templatePtr->getReset())
     {
@@ -132,7 +276,7 @@ Decoder::decodeNestedTemplate(
         templatePtr->getApplicationTypeNamespace(),
         templatePtr->fieldCount()));
 
-    decodeSegmentBody(source, pmap, templatePtr, groupBuilder);
+    decodeSegmentBody(source, pmap, *templatePtr, groupBuilder);
     messageBuilder.endGroup(identity, groupBuilder);
   }
   else
@@ -151,39 +295,135 @@ Decoder::decodeGroup(
   Messages::ValueMessageBuilder & messageBuilder)
 {
   size_t presenceMapBits = group->presenceMapBitCount();
-  Codecs::PresenceMap pmap(presenceMapBits);
-  if(this->verboseOut_)
-  {
-    pmap.setVerbose(verboseOut_);
-  }
+  PresenceMapScope scope(*this, presenceMapBits);
+  Codecs::PresenceMap & pmap = scope.pmap();
 
   if(presenceMapBits > 0)
   {
     static const std::string pm("PMAP");
-    source.beginField(pm);
+    if(QUICKFAST_DIAGNOSTICS)
+    {
+      source.beginField(pm);
+    }
     pmap.decode(source);
   }
+  else
+  {
+    pmap.reset();
+  }
 // for debugging:  pmap.setVerbose(source.getEcho());
-  decodeSegmentBody(source, pmap, group, messageBuilder);
+  decodeSegmentBody(source, pmap, *group, messageBuilder);
 }
 
 void
 Decoder::decodeSegmentBody(
   DataSource & source,
   Codecs::PresenceMap & pmap,
-  const Codecs::SegmentBodyCPtr & segment,
+  const Codecs::SegmentBody & segment,
   Messages::ValueMessageBuilder & messageBuilder)
 {
-  size_t instructionCount = segment->size();
+  if(useDecodePlan_ && (!QUICKFAST_DIAGNOSTICS || verboseOut_ == 0))
+  {
+    const DecodePlan & plan = segment.getDecodePlan();
+    if(plan.isCompiled())
+    {
+      decodeSegmentPlan(source, pmap, plan, messageBuilder);
+      return;
+    }
+  }
+
+  size_t instructionCount = segment.size();
   for( size_t nField = 0; nField < instructionCount; ++nField)
   {
     PROFILE_POINT("decode field");
-    const Codecs::FieldInstructionCPtr & instruction = segment->getInstruction(nField);
-    if(verboseOut_)
+    const Codecs::FieldInstructionCPtr & instruction = segment.getInstruction(nField);
+    if(QUICKFAST_DIAGNOSTICS && verboseOut_)
     {
       (*verboseOut_) <<std::endl << "Decode instruction[" <<nField << "]: " << instruction->getIdentity().name() << std::endl;
     }
-    source.beginField(instruction->getIdentity().name());
+    if(QUICKFAST_DIAGNOSTICS)
+    {
+      source.beginField(instruction->getIdentity().name());
+    }
     (void)instruction->decode(source, pmap, *this, messageBuilder);
   }
 }
+
+void
+Decoder::decodeSegmentPlan(
+  DataSource & source,
+  Codecs::PresenceMap & pmap,
+  const DecodePlan & plan,
+  Messages::ValueMessageBuilder & messageBuilder)
+{
+  bool notifySource = QUICKFAST_DIAGNOSTICS && source.getEcho() != 0;
+  size_t stepCount = plan.size();
+  for(size_t nStep = 0; nStep < stepCount; ++nStep)
+  {
+    PROFILE_POINT("decode step");
+    const DecodePlan::Step & step = plan[nStep];
+    const FieldInstruction & instruction = *step.instruction;
+    if(notifySource)
+    {
+      source.beginField(instruction.getName());
+    }
+    switch(step.opCode)
+    {
+    case DecodePlan::NOP:
+      instruction.decodeNop(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::CONSTANT:
+      instruction.decodeConstant(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::DEFAULT:
+      instruction.decodeDefault(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::COPY:
+      instruction.decodeCopy(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::COPY_PMAP_BIT:
+      instruction.decodeCopy(source, pmap.checkSpecificField(step.pmapBit), *this, messageBuilder);
+      break;
+    case DecodePlan::DELTA:
+      instruction.decodeDelta(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::INCREMENT:
+      instruction.decodeIncrement(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::INCREMENT_PMAP_BIT:
+      instruction.decodeIncrement(source, pmap.checkSpecificField(step.pmapBit), *this, messageBuilder);
+      break;
+    case DecodePlan::TAIL:
+      instruction.decodeTail(source, pmap, *this, messageBuilder);
+      break;
+    case DecodePlan::UINT32_NOP:
+      decodePlanIntegerNop<uint32, ValueType::UINT32, false>(source, *this, step, messageBuilder);
+      break;
+    case DecodePlan::INT32_NOP:
+      decodePlanIntegerNop<int32, ValueType::INT32, true>(source, *this, step, messageBuilder);
+      break;
+    case DecodePlan::UINT64_NOP:
+      decodePlanIntegerNop<uint64, ValueType::UINT64, false>(source, *this, step, messageBuilder);
+      break;
+    case DecodePlan::INT64_NOP:
+      decodePlanIntegerNop<int64, ValueType::INT64, true>(source, *this, step, messageBuilder);
+      break;
+    case DecodePlan::UINT32_COPY:
+      decodePlanIntegerCopy<uint32, ValueType::UINT32, false>(source, pmap, *this, step, messageBuilder);
+      break;
+    case DecodePlan::INT32_COPY:
+      decodePlanIntegerCopy<int32, ValueType::INT32, true>(source, pmap, *this, step, messageBuilder);
+      break;
+    case DecodePlan::UINT64_COPY:
+      decodePlanIntegerCopy<uint64, ValueType::UINT64, false>(source, pmap, *this, step, messageBuilder);
+      break;
+    case DecodePlan::INT64_COPY:
+      decodePlanIntegerCopy<int64, ValueType::INT64, true>(source, pmap, *this, step, messageBuilder);
+      break;
+    case DecodePlan::GENERIC:
+    default:
+      instruction.decode(source, pmap, *this, messageBuilder);
+      break;
+    }
+  }
+}
@@ -13,7 +13,9 @@
 #include <Codecs/PresenceMap_fwd.h>
 #include <Codecs/Template.h>
 #include <Codecs/SegmentBody_fwd.h>
+#include <Codecs/DecodePlan_fwd.h>
 #include <Messages/ValueMessageBuilder_fwd.h>
+#include <Messages/SymbolTable_fwd.h>
 
 #include <Common/Exceptions.h>
 
@@ -31,6 +33,43 @@ namespace QuickFAST{
       /// @param registry A registry containing all templates to be used to decode messages.
       explicit Decoder(TemplateRegistryPtr registry);
 
+      /// @brief Enable or disable decoding via precompiled DecodePlans
+      ///
+      /// When enabled, segment bodies are decoded by running the DecodePlan that
+      /// was built when the TemplateRegistry was finalized rather than dispatching
+      /// each field through its FieldOp.  The decoded results are identical.
+      ///
+      /// DataSource::beginField() is only called in this mode if the DataSource is echoing
+      /// its input, and verbose decoding (setVerboseOutput) always uses the normal path.
+      /// @param useDecodePlan true to enable the precompiled decoding plans.
+      void setUseDecodePlan(bool useDecodePlan)
+      {
+        useDecodePlan_ = useDecodePlan;
+      }
+
+      /// @brief Are precompiled DecodePlans being used?
+      /// @returns true if decoding uses precompiled plans.
+      bool getUseDecodePlan()const
+      {
+        return useDecodePlan_;
+      }
+
+      /// @brief Intern short ASCII values in a SymbolTable.
+      ///
+      /// Builders receive interned values through ValueMessageBuilder::addSymbol().
+      /// @param symbols is the table to use.  An empty pointer disables interning.
+      void setSymbolTable(Messages::SymbolTablePtr symbols)
+      {
+        symbols_ = symbols;
+      }
+
+      /// @brief Access the SymbolTable (if any)
+      /// @returns a pointer to the table or zero if values are not being interned.
+      Messages::SymbolTable * getSymbolTable()const
+      {
+        return symbols_.get();
+      }
+
       /// @brief Decode the next message.
       /// @param[in] source where to read the incoming message(s).
       /// @param[out] message an empty message into which the decoded fields will be stored.
@@ -38,6 +77,26 @@ namespace QuickFAST{
         DataSource & source,
         Messages::ValueMessageBuilder & message);
 
+      /// @brief Decode consecutive messages from a contiguous buffer.
+      ///
+      /// Intended for packets that carry many messages with no headers between them.
+      /// Decodes until the buffer is exhausted or maxMessages have been decoded.
+      /// Cheaper than calling decodeMessage() with a DataSource for each message.
+      /// @param[in] data points to the first byte of the first message.
+      /// @param[in] length is the number of bytes in the buffer.
+      /// @param[out] builder receives the decoded messages
+      /// @param[out] bytesUsed is the number of bytes consumed by the decoded messages.
+      /// @param[in] maxMessages limits the number of messages decoded (0 means no limit).
+      /// @returns the number of messages decoded.
+      /// @throws EncodingError if a message is invalid or truncated.  bytesUsed is then the
+      ///         number of bytes consumed by the messages decoded before it.
+      size_t decodeBatch(
+        const uchar * data,
+        size_t length,
+        Messages::ValueMessageBuilder & builder,
+        size_t & bytesUsed,
+        size_t maxMessages = 0);
+
       /// @brief Decode a group field.
       ///
       /// If the application type of the group matches the application type of the
@@ -72,11 +131,46 @@ namespace QuickFAST{
       ///        in the input.
       /// @param[in] segment defines the expected fields [part of a template]
       /// @param[in] messageBuilder to which the decoded fields will be added
+      void decodeSegmentBody(
+        DataSource & source,
+        PresenceMap & pmap,
+        const SegmentBody & segment,
+        Messages::ValueMessageBuilder & messageBuilder);
+
+      /// @brief Decode the body of a segment into a messageBuilder.
+      ///
+      /// For compatibility with callers that hold a smart pointer to the segment.
+      /// @param[in] source supplies the FAST encoded data.
+      /// @param[in] pmap is used to determine which fields are present
+      ///        in the input.
+      /// @param[in] segment defines the expected fields [part of a template]
+      /// @param[in] messageBuilder to which the decoded fields will be added
       void decodeSegmentBody(
         DataSource & source,
         PresenceMap & pmap,
         const SegmentBodyCPtr & segment,
+        Messages::ValueMessageBuilder & messageBuilder)
+      {
+        decodeSegmentBody(source, pmap, *segment, messageBuilder);
+      }
+
+    private:
+      void decodeSegmentPlan(
+        DataSource & source,
+        PresenceMap & pmap,
+        const DecodePlan & plan,
         Messages::ValueMessageBuilder & messageBuilder);
+
+      /// Borrows a PresenceMap from presenceMaps_ for the duration of a scope.
+      class PresenceMapScope;
+      friend class PresenceMapScope;
+
+    private:
+      bool useDecodePlan_;
+      /// Presence maps reused by decodeMessage and nested segments; one per nesting depth.
+      std::vector<PresenceMapPtr> presenceMaps_;
+      size_t presenceMapDepth_;
+      Messages::SymbolTablePtr symbols_;
     };
   }
 }
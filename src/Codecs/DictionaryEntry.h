@@ -0,0 +1,318 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef DICTIONARYENTRY_H
+#define DICTIONARYENTRY_H
+#include <Common/Types.h>
+#include <Common/Decimal.h>
+
+namespace QuickFAST
+{
+  namespace Codecs
+  {
+    /// @brief One entry in a Context's dictionary.
+    ///
+    /// A compact tagged union: sixteen bytes, so four entries share a cache line.
+    /// Integers and decimal mantissas are stored in the entry.  Strings are
+    /// stored out of line in an arena owned by the Context; the entry holds the
+    /// string's offset and length.
+    ///
+    /// The generation identifies the Context::reset() period in which the
+    /// entry was last written.
+    class DictionaryEntry
+    {
+    public:
+      /// @brief What kind of value is stored.
+      enum EntryClass
+      {
+        UNDEFINED,
+        EMPTY,
+        SIGNEDINTEGER,
+        UNSIGNEDINTEGER,
+        DECIMAL,
+        STRING
+      };
+
+      DictionaryEntry()
+        : generation_(0)
+        , class_(UNDEFINED)
+        , exponent_(0)
+        , hasBlock_(false)
+      {
+        value_.unsignedInteger_ = 0;
+      }
+
+      /// @brief The generation in which this entry was last written.
+      uint32 generation()const
+      {
+        return generation_;
+      }
+
+      /// @brief Set the generation in which this entry was last written.
+      void setGeneration(uint32 generation)
+      {
+        generation_ = generation;
+      }
+
+      /// @brief Has a value (possibly null) been stored?
+      bool isDefined()const
+      {
+        return class_ != UNDEFINED;
+      }
+
+      /// @brief Is the stored value null?
+      bool isNull()const
+      {
+        return class_ == EMPTY;
+      }
+
+      /// @brief Set the value to null.
+      void setNull()
+      {
+        class_ = EMPTY;
+      }
+
+      /// @brief Forget the value.
+      void setUndefined()
+      {
+        class_ = UNDEFINED;
+      }
+
+      /// @brief Forget the value and the string block.
+      void erase()
+      {
+        class_ = UNDEFINED;
+        hasBlock_ = false;
+        generation_ = 0;
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const int64 value)
+      {
+        setSigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const uint64 value)
+      {
+        setUnsigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const int32 value)
+      {
+        setSigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const uint32 value)
+      {
+        setUnsigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const int16 value)
+      {
+        setSigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const uint16 value)
+      {
+        setUnsigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const int8 value)
+      {
+        setSigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const uchar value)
+      {
+        setUnsigned(value);
+      }
+
+      /// @brief assign a value
+      /// @param value is the value to be assigned
+      void setValue(const Decimal & value)
+      {
+        class_ = DECIMAL;
+        hasBlock_ = false;
+        value_.signedInteger_ = value.getMantissa();
+        exponent_ = value.getExponent();
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(int64 & value) const
+      {
+        return getSigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(uint64 & value) const
+      {
+        return getUnsigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(int32 & value) const
+      {
+        return getSigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(uint32 & value) const
+      {
+        return getUnsigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(int16 & value) const
+      {
+        return getSigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(uint16 & value) const
+      {
+        return getUnsigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(int8 & value) const
+      {
+        return getSigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(uchar & value) const
+      {
+        return getUnsigned(value);
+      }
+
+      /// @brief get the value
+      /// @param value receives the data
+      bool getValue(Decimal & value) const
+      {
+        if(class_ == DECIMAL)
+        {
+          value = Decimal(value_.signedInteger_, exponent_);
+          return true;
+        }
+        return false;
+      }
+
+      /// @brief Is the stored value a string?
+      bool isString()const
+      {
+        return class_ == STRING;
+      }
+
+      /// @brief Does this entry own a block in the string arena?
+      bool hasBlock()const
+      {
+        return hasBlock_;
+      }
+
+      /// @brief Store a string that occupies the entry's block in the arena.
+      /// @param offset of the block in the arena
+      /// @param length of the string
+      void setString(uint32 offset, uint32 length)
+      {
+        class_ = STRING;
+        hasBlock_ = true;
+        value_.string_.offset_ = offset;
+        value_.string_.length_ = length;
+      }
+
+      /// @brief The offset of the entry's block in the arena.  Requires hasBlock().
+      uint32 stringOffset()const
+      {
+        return value_.string_.offset_;
+      }
+
+      /// @brief The length of the string in the entry's block.  Requires hasBlock().
+      uint32 stringLength()const
+      {
+        return value_.string_.length_;
+      }
+
+    private:
+      template<typename INTEGER>
+      void setSigned(INTEGER value)
+      {
+        class_ = SIGNEDINTEGER;
+        hasBlock_ = false;
+        value_.signedInteger_ = value;
+      }
+
+      template<typename INTEGER>
+      void setUnsigned(INTEGER value)
+      {
+        class_ = UNSIGNEDINTEGER;
+        hasBlock_ = false;
+        value_.unsignedInteger_ = value;
+      }
+
+      template<typename INTEGER>
+      bool getSigned(INTEGER & value)const
+      {
+        if(class_ == SIGNEDINTEGER)
+        {
+          value = static_cast<INTEGER>(value_.signedInteger_);
+          return true;
+        }
+        return false;
+      }
+
+      template<typename INTEGER>
+      bool getUnsigned(INTEGER & value)const
+      {
+        if(class_ == UNSIGNEDINTEGER)
+        {
+          value = static_cast<INTEGER>(value_.unsignedInteger_);
+          return true;
+        }
+        return false;
+      }
+
+    private:
+      union
+      {
+        int64 signedInteger_;
+        uint64 unsignedInteger_;
+        struct
+        {
+          uint32 offset_;
+          uint32 length_;
+        } string_;
+      } value_;
+      uint32 generation_;
+      uchar class_;
+      exponent_t exponent_;
+      bool hasBlock_;
+    };
+  }
+}
+#endif // DICTIONARYENTRY_H
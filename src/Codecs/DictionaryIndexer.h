@@ -17,6 +17,10 @@ namespace QuickFAST{
     /// Note that this simply assigns index values before encoding/decoding begins.
     /// The actual array of dictionary entries will be created by the Context
     /// when the Encoder or Decoder is created.
+    ///
+    /// Indexes are assigned in the order fields are finalized, template by template,
+    /// so the entries used by one template are adjacent in the Context's array
+    /// (except for keys shared with a template that was finalized earlier).
     class QuickFAST_Export DictionaryIndexer
     {
     public:
@@ -9,10 +9,32 @@
 #include <Codecs/PresenceMap.h>
 #include <Codecs/TemplateRegistry.h>
 #include <Codecs/FieldInstruction.h>
+#include <Codecs/PositionedAccessor.h>
+#include <Messages/FieldSet.h>
 
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
 
+namespace
+{
+  /// @brief Mark a PositionIndex in use until the end of a scope.
+  class BusyGuard
+  {
+  public:
+    explicit BusyGuard(bool & busy)
+      : busy_(busy)
+    {
+      busy_ = true;
+    }
+    ~BusyGuard()
+    {
+      busy_ = false;
+    }
+  private:
+    bool & busy_;
+  };
+}
+
 Encoder::Encoder(Codecs::TemplateRegistryPtr registry)
 : Context(registry)
 {
@@ -58,7 +80,8 @@ Encoder::encodeSegment(
     Codecs::PresenceMap pmap(templatePtr->presenceMapBitCount());
 
     DataDestination::BufferHandle header = destination.startBuffer();
-    destination.startBuffer();
+    // leave room to back-patch the presence map into the header
+    destination.startBuffer(PresenceMap::maxEncodedSize(templatePtr->presenceMapBitCount()));
     // can we "copy" the template ID?
     if(templateId == templateId_)
     {
@@ -102,7 +125,7 @@ Encoder::encodeGroup(
   DataDestination::BufferHandle bodyBuffer = pmapBuffer;
   if(presenceMapBits > 0)
   {
-    bodyBuffer = destination.startBuffer();
+    bodyBuffer = destination.startBuffer(PresenceMap::maxEncodedSize(presenceMapBits));
   }
   encodeSegmentBody(destination, pmap, group, accessor);
   // remember the buffer we're presently working on
@@ -127,12 +150,36 @@ Encoder::encodeSegmentBody(
   const Codecs::SegmentBodyCPtr & segment,
   const Messages::MessageAccessor & accessor)
 {
-  size_t instructionCount = segment->size();
+  // Find a FieldSet's fields by position rather than searching for each one.
+  // The index belongs to this Encoder; the message is not changed.
+  const Messages::FieldSet * fields = dynamic_cast<const Messages::FieldSet *>(&accessor);
+  if(fields != 0)
+  {
+    PositionIndex & index = positionIndexes_[segment.get()];
+    if(!index.busy_)
+    {
+      BusyGuard guard(index.busy_);
+      PositionedAccessor positioned(*fields, *segment, index.fieldIndex_);
+      encodeInstructions(destination, pmap, *segment, positioned);
+      return;
+    }
+  }
+  encodeInstructions(destination, pmap, *segment, accessor);
+}
+
+void
+Encoder::encodeInstructions(
+  DataDestination & destination,
+  Codecs::PresenceMap & pmap,
+  const Codecs::SegmentBody & segment,
+  const Messages::MessageAccessor & accessor)
+{
+  size_t instructionCount = segment.size();
   for( size_t nField = 0; nField < instructionCount; ++nField)
   {
     PROFILE_POINT("encode field");
     Codecs::FieldInstructionCPtr instruction;
-    if(segment->getInstruction(nField, instruction))
+    if(segment.getInstruction(nField, instruction))
     {
       destination.startField(instruction->getIdentity());
       instruction->encode(destination, pmap, *this, accessor);
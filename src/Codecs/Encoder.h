@@ -85,7 +85,30 @@ namespace QuickFAST{
         Codecs::PresenceMap & presenceMap,
         const Codecs::SegmentBodyCPtr & segment,
         const Messages::MessageAccessor & accessor);
+
+    private:
+      /// @brief Encode the instructions of a segment from an accessor.
+      void encodeInstructions(
+        DataDestination & destination,
+        Codecs::PresenceMap & presenceMap,
+        const Codecs::SegmentBody & segment,
+        const Messages::MessageAccessor & accessor);
+
     private:
+      /// @brief Where each instruction's field was found in a FieldSet.
+      struct PositionIndex
+      {
+        PositionIndex()
+          : busy_(false)
+        {
+        }
+        /// FieldSet index by instruction; reused for each message
+        std::vector<size_t> fieldIndex_;
+        /// Is the segment being encoded (i.e. recursively)?
+        bool busy_;
+      };
+      typedef std::map<const SegmentBody *, PositionIndex> PositionIndexes;
+      PositionIndexes positionIndexes_;
     };
   }
 }
@@ -38,6 +38,7 @@ FieldInstruction::~FieldInstruction()
 void
 FieldInstruction::finalize(Codecs::TemplateRegistry & /*registry*/)
 {
+  identity_.intern();
   presenceMapBitsUsed_ = 0;
   /// Note: do not use fieldOp_ directly here.  GetFieldOp may resolve to a "subfield"
   if(getFieldOp()->usesPresenceMap(isMandatory()))
@@ -241,6 +242,19 @@ FieldInstruction::decodeAscii(
   Codecs::DataSource & source,
   WorkingBuffer & workingBuffer)
 {
+  // Fast path: if the whole string is in the source's current buffer
+  // find the stop bit there and copy the string as a block.
+  const uchar * data = 0;
+  size_t length = 0;
+  if(source.findStopBit(data, length))
+  {
+    workingBuffer.clear(false, length);
+    workingBuffer.append(data, length - 1);
+    workingBuffer.push(data[length - 1] & dataBits);
+    source.skipContiguous(length);
+    return true;
+  }
+
   workingBuffer.clear(false);
   uchar byte = 0;
   if(!source.getByte(byte))
@@ -311,6 +325,60 @@ FieldInstruction::decodeByteVector(
   }
 }
 
+void
+FieldInstruction::decodeByteVector(
+  Codecs::Context & decoder,
+  Codecs::DataSource & source,
+  const std::string & name,
+  WorkingBuffer & buffer,
+  size_t length,
+  const uchar *& value)
+{
+  if(source.hasContiguous(length, value))
+  {
+    // The value is entirely within the source's current buffer.  Use it in place.
+    source.skipContiguous(length);
+  }
+  else
+  {
+    decodeByteVector(decoder, source, name, buffer, length);
+    value = buffer.begin();
+  }
+}
+
+size_t
+FieldInstruction::prepareStringDictionary(Codecs::Context & context)const
+{
+  const uchar * previous = 0;
+  size_t previousLength = 0;
+  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(context, previous, previousLength);
+  if(previousStatus == Context::OK_VALUE)
+  {
+    return previousLength;
+  }
+  if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
+  {
+    fieldOp_->setDictionaryValue(context, fieldOp_->getValue());
+    return fieldOp_->getValue().size();
+  }
+  fieldOp_->setDictionaryValue(context, reinterpret_cast<const uchar *>(""), 0);
+  return 0;
+}
+
+void
+FieldInstruction::spliceStringDictionary(
+  Codecs::Context & context,
+  size_t pos,
+  size_t removeLength,
+  const uchar * insert,
+  size_t insertLength,
+  const uchar *& value,
+  size_t & length)const
+{
+  fieldOp_->replaceDictionaryString(context, pos, removeLength, insert, insertLength);
+  (void)fieldOp_->getDictionaryValue(context, value, length);
+}
+
 void
 FieldInstruction::indexDictionaries(
   DictionaryIndexer & indexer,
@@ -362,6 +430,15 @@ FieldInstruction::setDefaultValueTail()
 {
 }
 
+namespace
+{
+  // The unrolled encoders stage the bytes then write them to the destination at once.
+  inline void stageByte(uchar * bytes, size_t & count, uchar byte)
+  {
+    bytes[count++] = byte;
+  }
+}
+
 #if 0 // Unrolled version is about 15% faster
 namespace
 {
@@ -407,92 +484,94 @@ FieldInstruction::encodeSignedInteger(DataDestination & destination, WorkingBuff
 void
 FieldInstruction::encodeSignedInteger(DataDestination & destination, WorkingBuffer & buffer, int64 value)
 {
+  uchar bytes[10];
+  size_t count = 0;
   if (value >= 0)
   {
     if (value < 0x0000000000000040LL)
     {
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0000000000002000LL)
     {
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0000000000100000LL)
     {
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0000000008000000LL)
     {
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0000000400000000LL)
     {
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0000020000000000LL)
     {
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0001000000000000LL)
     {
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x0080000000000000LL)
     {
-      destination.putByte(((value >> 49)  & 0x7F)); // ..FE .... .... ....
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 49)  & 0x7F)); // ..FE .... .... ....
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else if (value < 0x4000000000000000LL)
     {
-      destination.putByte(((value >> 56)  & 0x7F)); // 7F.. .... .... ....
-      destination.putByte(((value >> 49)  & 0x7F)); // ..FE .... .... ....
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 56)  & 0x7F)); // 7F.. .... .... ....
+      stageByte(bytes, count, ((value >> 49)  & 0x7F)); // ..FE .... .... ....
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
     else
     {
-      destination.putByte(((value >> 63)  & 0x7F)); // 8... .... .... ....  (this will always be zero)
-      destination.putByte(((value >> 56)  & 0x7F)); // 7F.. .... .... ....
-      destination.putByte(((value >> 49)  & 0x7F)); // ..FE .... .... ....
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ..1F C...
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte(((value & 0x7F) | 0x80)); // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 63)  & 0x7F)); // 8... .... .... ....  (this will always be zero)
+      stageByte(bytes, count, ((value >> 56)  & 0x7F)); // 7F.. .... .... ....
+      stageByte(bytes, count, ((value >> 49)  & 0x7F)); // ..FE .... .... ....
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ..1F C...
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, ((value & 0x7F) | 0x80)); // .... .... .... ..7f
     }
   }
   else
@@ -503,90 +582,91 @@ FieldInstruction::encodeSignedInteger(DataDestination & destination, WorkingBuff
     if((value << 1) == 0)
     {
       // encode the most negative possible number
-      destination.putByte(0x7F);    // 8... .... .... ....
-      destination.putByte(0x00);    // 7F.. .... .... ....
-      destination.putByte(0x00);    // . FE .... .... ....
-      destination.putByte(0x00);    // ...1 FC.. .... ....
-      destination.putByte(0x00);    // .... .3F8 .... ....
-      destination.putByte(0x00);    // .... ...7 F... ....
-      destination.putByte(0x00);    // .... .... .FE. ....
-      destination.putByte(0x00);    // .... .... ...1 FC..
-      destination.putByte(0x00);    // .... .... .... 3F8.
-      destination.putByte(0x80);    // .... .... .... ..7f
+      stageByte(bytes, count, 0x7F);    // 8... .... .... ....
+      stageByte(bytes, count, 0x00);    // 7F.. .... .... ....
+      stageByte(bytes, count, 0x00);    // . FE .... .... ....
+      stageByte(bytes, count, 0x00);    // ...1 FC.. .... ....
+      stageByte(bytes, count, 0x00);    // .... .3F8 .... ....
+      stageByte(bytes, count, 0x00);    // .... ...7 F... ....
+      stageByte(bytes, count, 0x00);    // .... .... .FE. ....
+      stageByte(bytes, count, 0x00);    // .... .... ...1 FC..
+      stageByte(bytes, count, 0x00);    // .... .... .... 3F8.
+      stageByte(bytes, count, 0x80);    // .... .... .... ..7f
     }
     else if (absv <= 0x0000000000000040LL)
     {
-      destination.putByte(value & 0xFF); // .... .... .... ..7f
+      stageByte(bytes, count, value & 0xFF); // .... .... .... ..7f
     }
     else if (absv <= 0x0000000000002000LL)
     {
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0000000000100000LL)
     {
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0000000008000000LL)
     {
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0000000400000000LL)
     {
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0000020000000000LL)
     {
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0001000000000000LL)
     {
-      destination.putByte(((value >> 42)  & 0x7F));// ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 42)  & 0x7F));// ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else if (absv <= 0x0080000000000000LL)
     {
-      destination.putByte(((value >> 49)  & 0x7F)); // ..FE .... .... ....
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 49)  & 0x7F)); // ..FE .... .... ....
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
     else
     {
-      destination.putByte(((value >> 56)  & 0x7F)); // 7F.. .... .... ....
-      destination.putByte(((value >> 49)  & 0x7F)); // ..FE .... .... ....
-      destination.putByte(((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
-      destination.putByte(((value >> 35)  & 0x7F)); // .... .3F8 .... ....
-      destination.putByte(((value >> 28)  & 0x7F)); // .... ...7 F... ....
-      destination.putByte(((value >> 21)  & 0x7F)); // .... .... .FE. ....
-      destination.putByte(((value >> 14)  & 0x7F)); // .... .... ...1 FC..
-      destination.putByte(((value >> 7)   & 0x7F)); // .... .... .... 3F8.
-      destination.putByte((value & 0x7F)  | 0x80);  // .... .... .... ..7f
+      stageByte(bytes, count, ((value >> 56)  & 0x7F)); // 7F.. .... .... ....
+      stageByte(bytes, count, ((value >> 49)  & 0x7F)); // ..FE .... .... ....
+      stageByte(bytes, count, ((value >> 42)  & 0x7F)); // ...1 FC.. .... ....
+      stageByte(bytes, count, ((value >> 35)  & 0x7F)); // .... .3F8 .... ....
+      stageByte(bytes, count, ((value >> 28)  & 0x7F)); // .... ...7 F... ....
+      stageByte(bytes, count, ((value >> 21)  & 0x7F)); // .... .... .FE. ....
+      stageByte(bytes, count, ((value >> 14)  & 0x7F)); // .... .... ...1 FC..
+      stageByte(bytes, count, ((value >> 7)   & 0x7F)); // .... .... .... 3F8.
+      stageByte(bytes, count, (value & 0x7F)  | 0x80);  // .... .... .... ..7f
     }
   }
+  destination.putBytes(bytes, count);
 }
 #endif
 #if 0
@@ -616,91 +696,94 @@ FieldInstruction::encodeUnsignedInteger(DataDestination & destination, WorkingBu
 void
 FieldInstruction::encodeUnsignedInteger(DataDestination & destination, WorkingBuffer & buffer, uint64 value)
 {
+  uchar bytes[10];
+  size_t count = 0;
   if (value <      0x0000000000000080ULL)
   {
-    destination.putByte(((value & 0x7f) | 0x80));
+    stageByte(bytes, count, ((value & 0x7f) | 0x80));
   }
   else if (value < 0x0000000000004000ULL)
   {
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0000000000200000ULL)
   {
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0000000010000000ULL)
   {
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0000000800000000ULL) // 1000 0000 0000 0000 0000 0000 0000 0000 0000
   {
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0000040000000000ULL) // 100 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000
   {
-    destination.putByte(((value >> 35) & 0x7F));
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 35) & 0x7F));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0002000000000000ULL) //
   {
-    destination.putByte(((value >> 42) & 0x7F));
-    destination.putByte(((value >> 35) & 0x7F));
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 42) & 0x7F));
+    stageByte(bytes, count, ((value >> 35) & 0x7F));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x0100000000000000ULL) // 1 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000 0000
   {
-    destination.putByte(((value >> 49) & 0x7F));
-    destination.putByte(((value >> 42) & 0x7F));
-    destination.putByte(((value >> 35) & 0x7F));
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 49) & 0x7F));
+    stageByte(bytes, count, ((value >> 42) & 0x7F));
+    stageByte(bytes, count, ((value >> 35) & 0x7F));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else if (value < 0x8000000000000000ULL) //
  {
-    destination.putByte(((value >> 56) & 0x7F));
-    destination.putByte(((value >> 49) & 0x7F));
-    destination.putByte(((value >> 42) & 0x7F));
-    destination.putByte(((value >> 35) & 0x7F));
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 56) & 0x7F));
+    stageByte(bytes, count, ((value >> 49) & 0x7F));
+    stageByte(bytes, count, ((value >> 42) & 0x7F));
+    stageByte(bytes, count, ((value >> 35) & 0x7F));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
   else
   {
-    destination.putByte(((value >> 63) & 0x7F));
-    destination.putByte(((value >> 56) & 0x7F));
-    destination.putByte(((value >> 49) & 0x7F));
-    destination.putByte(((value >> 42) & 0x7F));
-    destination.putByte(((value >> 35) & 0x7F));
-    destination.putByte(((value >> 28) & 0x7F));
-    destination.putByte(((value >> 21) & 0x7F));
-    destination.putByte(((value >> 14) & 0x7F));
-    destination.putByte(((value >> 7) & 0x7F));
-    destination.putByte(((value & 0x7F) | 0x80));
+    stageByte(bytes, count, ((value >> 63) & 0x7F));
+    stageByte(bytes, count, ((value >> 56) & 0x7F));
+    stageByte(bytes, count, ((value >> 49) & 0x7F));
+    stageByte(bytes, count, ((value >> 42) & 0x7F));
+    stageByte(bytes, count, ((value >> 35) & 0x7F));
+    stageByte(bytes, count, ((value >> 28) & 0x7F));
+    stageByte(bytes, count, ((value >> 21) & 0x7F));
+    stageByte(bytes, count, ((value >> 14) & 0x7F));
+    stageByte(bytes, count, ((value >> 7) & 0x7F));
+    stageByte(bytes, count, ((value & 0x7F) | 0x80));
   }
+  destination.putBytes(bytes, count);
 }
 #endif
 
@@ -727,10 +810,7 @@ FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer
     {
       destination.putByte(leadingZeroBytePreamble);
     }
-    for(size_t pos = 0; pos + 1 < value.size(); ++pos)
-    {
-      destination.putByte(static_cast<uchar>(value[pos]));
-    }
+    destination.putBytes(value.c_str(), value.size() - 1);
     destination.putByte(value[value.size() - 1] | stopBit);
   }
 }
@@ -739,10 +819,7 @@ FieldInstruction::encodeAscii(DataDestination & destination, const StringBuffer
 void
 FieldInstruction::encodeBlobData(DataDestination & destination, const StringBuffer & value)
 {
-  for(size_t pos = 0; pos < value.size(); ++pos)
-  {
-    destination.putByte(static_cast<uchar>(value[pos]));
-  }
+  destination.putBytes(value.c_str(), value.size());
 }
 
 size_t
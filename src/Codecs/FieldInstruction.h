@@ -13,6 +13,7 @@
 #include <Common/Constants.h>
 #include <Common/WorkingBuffer.h>
 #include <Common/Exceptions.h>
+#include <Common/StopBitScanner.h>
 #include <Messages/Message_fwd.h>
 #include <Messages/ValueMessageBuilder_fwd.h>
 #include <Messages/FieldIdentity.h>
@@ -90,6 +91,13 @@ namespace QuickFAST{
         identity_.setNamespace(fieldNamespace);
       }
 
+      /// @brief record the position of this field instruction within its segment
+      /// @param position is the index of this instruction in the SegmentBody plus the segment's position base
+      void setPosition(size_t position)
+      {
+        identity_.setPosition(position);
+      }
+
       /// @brief Indicate that the field is mandatory in the application record.
       /// Default if not specified is true.
       /// @param mandatory true for presence="mandatory"; false for presence="optional"
@@ -157,6 +165,13 @@ namespace QuickFAST{
         return mandatory_;
       }
 
+      /// @brief Should integer overflow be ignored when decoding this field?
+      /// @returns true if overflow checking is disabled.
+      bool getIgnoreOverflow()const
+      {
+        return ignoreOverflow_;
+      }
+
       /// @brief Implement the dictionary= attribute.
       ///
       /// Defines an dictionary to be used for this element.
@@ -191,6 +206,16 @@ namespace QuickFAST{
       /// @brief parent SegmentBody is needed to check for merge
       virtual size_t fieldCount(const SegmentBody & parent)const;
 
+      /// @brief How many positions are used by fields this instruction merges into its parent?
+      ///
+      /// The parent numbers its own fields from here so positions in a FieldSet are unique.
+      /// @param parent SegmentBody is needed to check for merge
+      /// @returns the position limit of the merged segment or zero if nothing is merged.
+      virtual size_t mergedPositionLimit(const SegmentBody & /*parent*/)const
+      {
+        return 0;
+      }
+
       /// @brief Assign a dictionary index to this field and any subfields.
       /// @param indexer assigns the index.
       /// @param dictionaryName is the parent's dictionary name (inherited unless overridden)
@@ -597,6 +622,54 @@ namespace QuickFAST{
         WorkingBuffer & buffer,
         size_t length);
 
+      /// @brief Decode a ByteVector or Utf8 string without copying it when possible
+      ///
+      /// If the entire value is within the DataSource's current buffer, value points
+      /// into that buffer and no copy is made.  Otherwise the bytes are collected in
+      /// buffer and value points there.  In either case value is only good until the
+      /// next byte is read from the source.
+      /// @param[in] decoder for which this decoding is being done
+      /// @param[in] source supplies the data
+      /// @param[in] name of this field to be used in error messages
+      /// @param buffer is used if the value is split between source buffers
+      /// @param[in] length expected
+      /// @param[out] value points to the decoded bytes.
+      /// @throws EncodingError if not enough data is available
+      static void decodeByteVector(
+        Codecs::Context & decoder,
+        Codecs::DataSource & source,
+        const std::string & name,
+        WorkingBuffer & buffer,
+        size_t length,
+        const uchar *& value);
+
+      /// @brief Find the base value for a string delta or tail operator.
+      ///
+      /// Leaves the base value (the previous value, the initial value, or an empty
+      /// string) in the dictionary so the operator can modify it in place.
+      /// @param context holds the dictionary
+      /// @returns the length of the base value
+      size_t prepareStringDictionary(Codecs::Context & context)const;
+
+      /// @brief Apply a string delta or tail to the dictionary value in place.
+      ///
+      /// prepareStringDictionary() must have been called first.
+      /// @param context holds the dictionary
+      /// @param pos is the position of the first byte to be replaced.
+      /// @param removeLength is the number of bytes to be replaced.
+      /// @param insert is the replacement data.
+      /// @param insertLength is the number of bytes of replacement data.
+      /// @param[out] value points to the new value in the dictionary.
+      /// @param[out] length is the length of the new value.
+      void spliceStringDictionary(
+        Codecs::Context & context,
+        size_t pos,
+        size_t removeLength,
+        const uchar * insert,
+        size_t insertLength,
+        const uchar *& value,
+        size_t & length)const;
+
       /// @brief do final processing of this field instruction after parsing entire template set.
       virtual void finalize(Codecs::TemplateRegistry & registry);
 
@@ -668,8 +741,46 @@ namespace QuickFAST{
       bool ignoreOverflow)
     {
       PROFILE_POINT("decodeSignedInteger");
+      const uchar * data = 0;
+      if(source.hasContiguous(sizeof(uint64), data))
+      {
+        // Decode up to eight bytes in one step.  Fall through to the byte-at-a-time
+        // decoding below if the value is longer or any overflow check would fail.
+        size_t length = 0;
+        uint64 groups = 0;
+        if(StopBitScanner::decodeWord(data, length, groups))
+        {
+          // sign extend from the 7 * length bits that were decoded
+          const size_t unused = 64 - dataShift * length;
+          int64 result = static_cast<int64>(groups << unused) >> unused;
+          size_t shift = sizeof(IntType) * byteSize - (dataShift + 1);
+          if(oversize)
+          {
+            shift += 1;
+          }
+          // The checks below compare each partial value to the overflow mask.
+          // The partial values grow monotonically so checking the last one is enough.
+          int64 partial = result >> dataShift;
+          if(ignoreOverflow || (partial >> shift) == (result < 0 ? int64(-1) : int64(0)))
+          {
+            value = static_cast<IntType>(result);
+            source.skipContiguous(length);
+            return;
+          }
+        }
+      }
+
+      // If the whole integer is in the source's buffer, read it from there
+      // rather than one getByte() at a time.
+      size_t length = 0;
+      size_t pos = 0;
+      bool contiguous = source.findStopBit(data, length);
       uchar byte = 0;
-      if(!source.getByte(byte))
+      if(contiguous)
+      {
+        byte = data[0];
+      }
+      else if(!source.getByte(byte))
       {
         context.reportFatal("[ERR U03]", "Unexpected end of data decoding signedinteger", name);
       }
@@ -700,11 +811,19 @@ namespace QuickFAST{
         }
         value <<= dataShift;
         value |= byte;
-        if(!source.getByte(byte))
+        if(contiguous)
+        {
+          byte = data[++pos];
+        }
+        else if(!source.getByte(byte))
         {
           context.reportFatal("[ERR D2]", "Unexpected EOF in signed integer field.", name);
         }
       }
+      if(contiguous)
+      {
+        source.skipContiguous(length);
+      }
       // include the last byte (the one with the stop bit)
       if(!ignoreOverflow && (value & overflowMask) != overflowCheck)
       {
@@ -1011,8 +1130,38 @@ namespace QuickFAST{
       bool ignoreOverflow)
     {
       PROFILE_POINT("decodeUnsignedInteger");
+      const uchar * data = 0;
+      if(source.hasContiguous(sizeof(uint64), data))
+      {
+        // Decode up to eight bytes in one step.  Fall through to the byte-at-a-time
+        // decoding below if the value is longer or any overflow check would fail.
+        size_t length = 0;
+        uint64 groups = 0;
+        if(StopBitScanner::decodeWord(data, length, groups))
+        {
+          unsigned short shift = ((sizeof(UnsignedIntType) * byteSize) / dataShift) * dataShift;
+          // The checks below compare each partial value to the overflow mask.
+          // The partial values grow monotonically so checking the last one is enough.
+          if(ignoreOverflow || ((groups >> dataShift) >> shift) == 0)
+          {
+            value = static_cast<UnsignedIntType>(groups);
+            source.skipContiguous(length);
+            return;
+          }
+        }
+      }
+
+      // If the whole integer is in the source's buffer, read it from there
+      // rather than one getByte() at a time.
+      size_t length = 0;
+      size_t pos = 0;
+      bool contiguous = source.findStopBit(data, length);
       uchar byte = 0;
-      if(!source.getByte(byte))
+      if(contiguous)
+      {
+        byte = data[0];
+      }
+      else if(!source.getByte(byte))
       {
         context.reportFatal("[ERR U03]", "Unexpected end of data decoding unsigned integer", name);
       }
@@ -1034,11 +1183,19 @@ namespace QuickFAST{
         }
         value <<= dataShift;
         value |= byte;
-        if(!source.getByte(byte))
+        if(contiguous)
+        {
+          byte = data[++pos];
+        }
+        else if(!source.getByte(byte))
         {
           context.reportFatal("[ERR U03]", "End of file without stop bit decoding unsigned integer.", name);
         }
       }
+      if(contiguous)
+      {
+        source.skipContiguous(length);
+      }
       if(!ignoreOverflow && (value & overflowMask) != overflowCheck)
       {
         context.reportError("[ERR D2]", "Unsigned Integer Field overflow..", name);
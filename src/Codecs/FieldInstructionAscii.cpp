@@ -10,6 +10,7 @@
 #include <Messages/ValueMessageBuilder.h>
 #include <Messages/MessageAccessor.h>
 #include <Messages/FieldAscii.h>
+#include <Messages/SymbolTable.h>
 
 #include <Common/Profiler.h>
 
@@ -68,7 +69,7 @@ FieldInstructionAscii::decodeNop(
   WorkingBuffer & buffer = decoder.getWorkingBuffer();
   if(decodeAsciiFromSource(source, isMandatory(), buffer))
   {
-    builder.addValue(identity_, ValueType::ASCII, buffer.begin(), buffer.size());
+    addAscii(decoder, builder, buffer.begin(), buffer.size());
   }
 }
 
@@ -76,15 +77,15 @@ void
 FieldInstructionAscii::decodeConstant(
   Codecs::DataSource & /*source*/,
   Codecs::PresenceMap & pmap,
-  Codecs::Decoder & /*decoder*/,
+  Codecs::Decoder & decoder,
   Messages::ValueMessageBuilder & builder) const
 {
   PROFILE_POINT("ascii::decodeConstant");
   if(isMandatory())
   {
-    builder.addValue(
-      identity_,
-      ValueType::ASCII,
+    addAscii(
+      decoder,
+      builder,
       reinterpret_cast<const uchar *>(fieldOp_->getValue().c_str()),
       fieldOp_->getValue().size());
   }
@@ -92,9 +93,9 @@ FieldInstructionAscii::decodeConstant(
   {
     if(pmap.checkNextField())
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
+      addAscii(
+        decoder,
+        builder,
         reinterpret_cast<const uchar *>(fieldOp_->getValue().c_str()),
         fieldOp_->getValue().size());
     }
@@ -118,23 +119,18 @@ FieldInstructionAscii::decodeDefault(
     WorkingBuffer & buffer = decoder.getWorkingBuffer();
     if(decodeAsciiFromSource(source, isMandatory(), buffer))
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
-        buffer.begin(),
-        buffer.size());
+      addAscii(decoder, builder, buffer.begin(), buffer.size());
     }
   }
   else // pmap says nothing in stream
   {
     if(fieldOp_->hasValue())
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
+      addAscii(
+        decoder,
+        builder,
         reinterpret_cast<const uchar *>(fieldOp_->getValue().c_str()),
-        fieldOp_->getValue().size()
-        );
+        fieldOp_->getValue().size());
     }
     else if(isMandatory())
     {
@@ -157,12 +153,7 @@ FieldInstructionAscii::decodeCopy(
     WorkingBuffer & buffer = decoder.getWorkingBuffer();
     if(decodeAsciiFromSource(source, isMandatory(), buffer))
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
-        buffer.begin(),
-        buffer.size()
-        );
+      addAscii(decoder, builder, buffer.begin(), buffer.size());
       fieldOp_->setDictionaryValue(decoder, buffer.begin(), buffer.size());
     }
     else
@@ -177,13 +168,13 @@ FieldInstructionAscii::decodeCopy(
     Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, value, valueSize);
     if(previousStatus == Context::OK_VALUE)
     {
-      builder.addValue(identity_, ValueType::ASCII, value, valueSize);
+      addAscii(decoder, builder, value, valueSize);
     }
     else if(previousStatus == Context::UNDEFINED_VALUE && fieldOp_->hasValue())
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
+      addAscii(
+        decoder,
+        builder,
         reinterpret_cast<const uchar *>(fieldOp_->getValue().c_str()),
         fieldOp_->getValue().size());
       fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
@@ -217,27 +208,18 @@ FieldInstructionAscii::decodeDelta(
       return;
     }
   }
-  std::string deltaValue;
   WorkingBuffer & buffer = decoder.getWorkingBuffer();
+  const uchar * deltaValue = 0;
+  size_t deltaSize = 0;
   if(decodeAsciiFromSource(source, true, buffer))
   {
-    deltaValue = std::string(
-      reinterpret_cast<const char *>(buffer.begin()),
-      buffer.size());
-  }
-
-
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-  if(previousStatus == Context::UNDEFINED_VALUE)
-  {
-    if(fieldOp_->hasValue())
-    {
-      previousValue = fieldOp_->getValue();
-    }
+    deltaValue = buffer.begin();
+    deltaSize = buffer.size();
   }
 
-  size_t previousLength = previousValue.length();
+  // The delta is applied to the dictionary entry in place.
+  size_t previousLength = prepareStringDictionary(decoder);
+  size_t pos = 0;
   if( deltaLength < 0)
   {
     // operate on front of string
@@ -249,13 +231,6 @@ FieldInstructionAscii::decodeDelta(
       decoder.reportError("[ERR D7]", "ASCII tail delta front length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::int32(previousLength);
     }
-    std::string value = deltaValue + previousValue.substr(deltaLength);
-    builder.addValue(
-      identity_,
-      ValueType::ASCII,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
   }
   else
   { // operate on end of string
@@ -268,14 +243,12 @@ FieldInstructionAscii::decodeDelta(
       decoder.reportError("[ERR D7]", "ASCII tail delta back length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::uint32(previousLength);
     }
-    std::string value = previousValue.substr(0, previousLength - deltaLength) + deltaValue;
-    builder.addValue(
-      identity_,
-      ValueType::ASCII,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
+    pos = previousLength - deltaLength;
   }
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  spliceStringDictionary(decoder, pos, deltaLength, deltaValue, deltaSize, value, valueSize);
+  addAscii(decoder, builder, value, valueSize);
 }
 
 void
@@ -292,30 +265,17 @@ FieldInstructionAscii::decodeTail(
     WorkingBuffer & buffer = decoder.getWorkingBuffer();
     if(decodeAsciiFromSource(source, isMandatory(), buffer))
     {
-      const std::string tailValue(reinterpret_cast<const char *>(buffer.begin()), buffer.size());
-      size_t tailLength = tailValue.length();
-      std::string previousValue;
-      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-      if(previousStatus == Context::UNDEFINED_VALUE)
+      size_t tailLength = buffer.size();
+      size_t previousLength = prepareStringDictionary(decoder);
+      size_t removeLength = tailLength;
+      if(removeLength > previousLength)
       {
-        if(fieldOp_->hasValue())
-        {
-          previousValue = fieldOp_->getValue();
-          fieldOp_->setDictionaryValue(decoder, previousValue);
-        }
+        removeLength = previousLength;
       }
-      size_t previousLength = previousValue.length();
-      if(tailLength > previousLength)
-      {
-        tailLength = previousLength;
-      }
-      std::string value(previousValue.substr(0, previousLength - tailLength) + tailValue);
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
-        reinterpret_cast<const uchar *>(value.c_str()),
-        value.size());
-      fieldOp_->setDictionaryValue(decoder, value);
+      const uchar * value = 0;
+      size_t valueSize = 0;
+      spliceStringDictionary(decoder, previousLength - removeLength, removeLength, buffer.begin(), tailLength, value, valueSize);
+      addAscii(decoder, builder, value, valueSize);
     }
     else // null
     {
@@ -324,21 +284,18 @@ FieldInstructionAscii::decodeTail(
   }
   else // pmap says not in stream
   {
-    std::string previousValue;
-    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
+    const uchar * previousValue = 0;
+    size_t previousLength = 0;
+    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
     if(previousStatus == Context::OK_VALUE)
     {
-      Messages::FieldCPtr field = Messages::FieldAscii::create(previousValue);
-      builder.addValue(identity_,
-        ValueType::ASCII,
-        reinterpret_cast<const uchar *>(previousValue.c_str()),
-        previousValue.size());
+      addAscii(decoder, builder, previousValue, previousLength);
     }
     else if(fieldOp_->hasValue())
     {
-      builder.addValue(
-        identity_,
-        ValueType::ASCII,
+      addAscii(
+        decoder,
+        builder,
         reinterpret_cast<const uchar *>(fieldOp_->getValue().c_str()),
         fieldOp_->getValue().size());
       fieldOp_->setDictionaryValue(decoder, fieldOp_->getValue());
@@ -689,3 +646,23 @@ FieldInstructionAscii::fieldInstructionType()const
 {
   return ValueType::ASCII;
 }
+
+void
+FieldInstructionAscii::addAscii(
+  Codecs::Decoder & decoder,
+  Messages::ValueMessageBuilder & builder,
+  const uchar * value,
+  size_t length) const
+{
+  Messages::SymbolTable * symbols = decoder.getSymbolTable();
+  if(symbols != 0)
+  {
+    const Messages::Symbol * symbol = symbols->intern(value, length);
+    if(symbol != 0)
+    {
+      builder.addSymbol(identity_, ValueType::ASCII, *symbol);
+      return;
+    }
+  }
+  builder.addValue(identity_, ValueType::ASCII, value, length);
+}
@@ -117,6 +117,13 @@ namespace QuickFAST{
 
       void interpretValue(const std::string & value);
 
+      /// @brief Pass a decoded value to the builder, interning it if the decoder has a SymbolTable.
+      void addAscii(
+        Codecs::Decoder & decoder,
+        Messages::ValueMessageBuilder & builder,
+        const uchar * value,
+        size_t length) const;
+
 
     private:
       Messages::FieldCPtr initialValue_;
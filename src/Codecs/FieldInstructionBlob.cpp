@@ -35,7 +35,9 @@ FieldInstructionBlob::decodeBlobFromSource(
   Codecs::DataSource & source,
   Codecs::Context & context,
   bool mandatory,
-  WorkingBuffer & buffer) const
+  WorkingBuffer & buffer,
+  const uchar *& value,
+  size_t & valueSize) const
 {
   PROFILE_POINT("blob::decodeBlobFromSource");
   uint32 length;
@@ -48,7 +50,8 @@ FieldInstructionBlob::decodeBlobFromSource(
       return false;
     }
   }
-  decodeByteVector(context, source, identity_.name(), buffer, length);
+  decodeByteVector(context, source, identity_.name(), buffer, length, value);
+  valueSize = length;
   return true;
 }
 
@@ -63,10 +66,10 @@ FieldInstructionBlob::decodeNop(
   // note NOP never uses pmap.  It uses a null value instead for optional fields
   // so it's always safe to do the basic decode.
   WorkingBuffer& buffer = decoder.getWorkingBuffer();
-  if(decodeBlobFromSource(source, decoder, isMandatory(), buffer))
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  if(decodeBlobFromSource(source, decoder, isMandatory(), buffer, value, valueSize))
   {
-    const uchar * value = buffer.begin();
-    size_t valueSize = buffer.size();
     builder.addValue(identity_, type_, value, valueSize);
   }
 }
@@ -115,10 +118,10 @@ FieldInstructionBlob::decodeDefault(
   if(pmap.checkNextField())
   {
     WorkingBuffer& buffer = decoder.getWorkingBuffer();
-    if(decodeBlobFromSource(source, decoder, isMandatory(), buffer))
+    const uchar * value = 0;
+    size_t valueSize = 0;
+    if(decodeBlobFromSource(source, decoder, isMandatory(), buffer, value, valueSize))
     {
-      const uchar * value = buffer.begin();
-      size_t valueSize = buffer.size();
       builder.addValue(
         identity_,
         type_,
@@ -156,10 +159,10 @@ FieldInstructionBlob::decodeCopy(
   {
     // field is in the stream, use it
   WorkingBuffer& buffer = decoder.getWorkingBuffer();
-  if(decodeBlobFromSource(source, decoder, isMandatory(), buffer))
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  if(decodeBlobFromSource(source, decoder, isMandatory(), buffer, value, valueSize))
   {
-    const uchar * value = buffer.begin();
-    size_t valueSize = buffer.size();
       builder.addValue(
         identity_,
         type_,
@@ -220,26 +223,18 @@ FieldInstructionBlob::decodeDelta(
     }
   }
 
-  std::string deltaValue;
   WorkingBuffer& buffer = decoder.getWorkingBuffer();
-  if(decodeBlobFromSource(source, decoder, true /*isMandatory()*/, buffer))
-  {
-    const uchar * value = buffer.begin();
-    size_t valueSize = buffer.size();
-    deltaValue = std::string(reinterpret_cast<const char *>(value), valueSize);
-  }
-
-  std::string previousValue;
-  Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-  if(previousStatus == Context::UNDEFINED_VALUE)
+  const uchar * deltaValue = 0;
+  size_t deltaSize = 0;
+  if(!decodeBlobFromSource(source, decoder, true /*isMandatory()*/, buffer, deltaValue, deltaSize))
   {
-    if(fieldOp_->hasValue())
-    {
-      previousValue = fieldOp_->getValue();
-    }
+    deltaValue = 0;
+    deltaSize = 0;
   }
-  size_t previousLength = previousValue.size();
 
+  // The delta is applied to the dictionary entry in place.
+  size_t previousLength = prepareStringDictionary(decoder);
+  size_t pos = 0;
   if( deltaLength < 0)
   {
     // operate on front of string
@@ -251,13 +246,6 @@ FieldInstructionBlob::decodeDelta(
       decoder.reportError("[ERR D7]", "String tail delta front length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::int32(previousLength);
     }
-    std::string value = deltaValue + previousValue.substr(deltaLength);
-    builder.addValue(
-      identity_,
-      type_,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
   }
   else
   { // operate on end of string
@@ -270,15 +258,16 @@ FieldInstructionBlob::decodeDelta(
       decoder.reportError("[ERR D7]", "String tail delta back length exceeds length of previous string.", identity_);
       deltaLength = QuickFAST::uint32(previousLength);
     }
-
-    std::string value = previousValue.substr(0, previousLength - deltaLength) + deltaValue;
-    builder.addValue(
-      identity_,
-      type_,
-      reinterpret_cast<const uchar *>(value.c_str()),
-      value.size());
-    fieldOp_->setDictionaryValue(decoder, value);
+    pos = previousLength - deltaLength;
   }
+  const uchar * value = 0;
+  size_t valueSize = 0;
+  spliceStringDictionary(decoder, pos, deltaLength, deltaValue, deltaSize, value, valueSize);
+  builder.addValue(
+    identity_,
+    type_,
+    value,
+    valueSize);
 }
 
 void
@@ -293,33 +282,24 @@ FieldInstructionBlob::decodeTail(
   {
     // field is in the stream, use it
     WorkingBuffer& buffer = decoder.getWorkingBuffer();
-    if(decodeBlobFromSource(source, decoder, isMandatory(), buffer))
+    const uchar * value = 0;
+    size_t tailLength = 0;
+    if(decodeBlobFromSource(source, decoder, isMandatory(), buffer, value, tailLength))
     {
-      size_t tailLength = buffer.size();
-      std::string tailValue(reinterpret_cast<const char *>(buffer.begin()), tailLength);
-
-      std::string previousValue;
-      Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
-      if(previousStatus == Context::UNDEFINED_VALUE)
+      size_t previousLength = prepareStringDictionary(decoder);
+      size_t removeLength = tailLength;
+      if(removeLength > previousLength)
       {
-        if(fieldOp_->hasValue())
-        {
-          previousValue = fieldOp_->getValue();
-          fieldOp_->setDictionaryValue(decoder, previousValue);
-        }
+        removeLength = previousLength;
       }
-      size_t previousLength = previousValue.length();
-      if(tailLength > previousLength)
-      {
-        tailLength = previousLength;
-      }
-      std::string value(previousValue.substr(0, previousLength - tailLength) + tailValue);
+      const uchar * result = 0;
+      size_t resultSize = 0;
+      spliceStringDictionary(decoder, previousLength - removeLength, removeLength, value, tailLength, result, resultSize);
       builder.addValue(
         identity_,
         type_,
-        reinterpret_cast<const uchar *>(value.c_str()),
-        value.size());
-      fieldOp_->setDictionaryValue(decoder, value);
+        result,
+        resultSize);
     }
     else // null
     {
@@ -328,16 +308,16 @@ FieldInstructionBlob::decodeTail(
   }
   else // pmap says not in stream
   {
-    std::string previousValue;
-    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue);
+    const uchar * previousValue = 0;
+    size_t previousLength = 0;
+    Context::DictionaryStatus previousStatus = fieldOp_->getDictionaryValue(decoder, previousValue, previousLength);
     if(previousStatus == Context::OK_VALUE)
     {
-
       builder.addValue(
         identity_,
         type_,
-        reinterpret_cast<const uchar *>(previousValue.c_str()),
-        previousValue.size());
+        previousValue,
+        previousLength);
     }
     else if(fieldOp_->hasValue())
     {
@@ -127,12 +127,24 @@ namespace QuickFAST{
       void interpretValue(const std::string & value);
 
       /// @brief helper routine to decode the blob data
+      ///
+      /// When possible value points directly into the source's buffer; otherwise
+      /// the data is collected in buffer.  Use value before reading more data.
+      /// @param source supplies the data
+      /// @param context reports errors
+      /// @param mandatory true if field is presence="mandatory"
+      /// @param buffer is used if the data is not contiguous in the source
+      /// @param[out] value points to the decoded bytes
+      /// @param[out] valueSize is the number of bytes decoded
+      /// @returns false if the field is optional and not present
       bool
       decodeBlobFromSource(
         Codecs::DataSource & source,
         Codecs::Context & context,
         bool mandatory,
-        WorkingBuffer & buffer) const;
+        WorkingBuffer & buffer,
+        const uchar *& value,
+        size_t & valueSize) const;
 
       /// @brief helper routine to encode a nullable, but not null value
       void encodeNullableBlob(
@@ -613,6 +613,7 @@ FieldInstructionDecimal::finalize(TemplateRegistry & templateRegistry)
 {
   if(bool(exponentInstruction_))
   {
+    identity_.intern();
     exponentInstruction_->finalize(templateRegistry);
     mantissaInstruction_->finalize(templateRegistry);
     presenceMapBitsUsed_ =
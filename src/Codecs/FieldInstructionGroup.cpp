@@ -148,6 +148,16 @@ FieldInstructionGroup::fieldCount(const SegmentBody & parent)const
   }
 }
 
+size_t
+FieldInstructionGroup::mergedPositionLimit(const SegmentBody & parent)const
+{
+  if(parent.getApplicationType() == segmentBody_->getApplicationType())
+  {
+    return segmentBody_->getPositionLimit();
+  }
+  return 0;
+}
+
 void
 FieldInstructionGroup::indexDictionaries(
   DictionaryIndexer & indexer,
@@ -46,6 +46,7 @@ namespace QuickFAST{
       /// @brief how many fields are contained in this group?
       /// @param parent allows checking to see if group will be merged into parent segment
       virtual size_t fieldCount(const SegmentBody & parent)const;
+      virtual size_t mergedPositionLimit(const SegmentBody & parent)const;
 
       virtual void decodeNop(
         Codecs::DataSource & source,
@@ -68,7 +68,10 @@ FieldInstructionSequence::decodeNop(
   Messages::SingleValueBuilder<uint32> lengthSet;
   if(segment_->getLengthInstruction(lengthInstruction))
   {
-    source.beginField(lengthInstruction->getIdentity().name());
+    if(QUICKFAST_DIAGNOSTICS)
+    {
+      source.beginField(lengthInstruction->getIdentity().name());
+    }
     lengthInstruction->decode(source, pmap, decoder, lengthSet);
   }
   else
@@ -20,12 +20,14 @@ FieldInstructionStaticTemplateRef::FieldInstructionStaticTemplateRef(
   , templateNamespace_(fieldNamespace)
   , isFinalized_(false)
   , fieldCount_(0)
+  , positionLimit_(0)
 {
 }
 
 FieldInstructionStaticTemplateRef::FieldInstructionStaticTemplateRef()
   : isFinalized_(false)
   , fieldCount_(0)
+  , positionLimit_(0)
 {
 }
 
@@ -54,6 +56,8 @@ FieldInstructionStaticTemplateRef::finalize(TemplateRegistry & templateRegistry)
   // subtract one for the template ID
   presenceMapBitsUsed_ = target->presenceMapBitCount() - 1;
   fieldCount_ = target->fieldCount();
+  targetApplicationType_ = target->getApplicationType();
+  positionLimit_ = target->getPositionLimit();
   isFinalized_ = true;
 }
 
@@ -79,7 +83,7 @@ FieldInstructionStaticTemplateRef::decodeNop(
         target->getApplicationTypeNamespace(),
         target->fieldCount()));
 
-    decoder.decodeSegmentBody(source, pmap, target, groupBuilder);
+    decoder.decodeSegmentBody(source, pmap, *target, groupBuilder);
     messageBuilder.endGroup(
       identity_,
       groupBuilder);
@@ -95,7 +99,7 @@ FieldInstructionStaticTemplateRef::decodeNop(
     // templates could be transmitted with different sets of fields defined
     // by templateRefs, but the underlying application type should not reflect
     // the technique used to encode/decode it.
-    decoder.decodeSegmentBody(source, pmap, target, messageBuilder);
+    decoder.decodeSegmentBody(source, pmap, *target, messageBuilder);
   }
 }
 
@@ -151,6 +155,17 @@ FieldInstructionStaticTemplateRef::fieldCount(const SegmentBody & parent)const
   return fieldCount_;
 }
 
+size_t
+FieldInstructionStaticTemplateRef::mergedPositionLimit(const SegmentBody & parent)const
+{
+  // The decoder merges the target's fields when the application types match.
+  if(isFinalized_ && parent.getApplicationType() == targetApplicationType_)
+  {
+    return positionLimit_;
+  }
+  return 0;
+}
+
 ValueType::Type
 FieldInstructionStaticTemplateRef::fieldInstructionType()const
 {
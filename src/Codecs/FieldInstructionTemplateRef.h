@@ -31,6 +31,7 @@ namespace QuickFAST{
       virtual void finalize(TemplateRegistry & templateRegistry);
       virtual bool isPossiblyRecursive() const;
       virtual size_t fieldCount(const SegmentBody & parent)const;
+      virtual size_t mergedPositionLimit(const SegmentBody & parent)const;
       virtual void decodeNop(
         Codecs::DataSource & source,
         Codecs::PresenceMap & pmap,
@@ -43,6 +44,18 @@ namespace QuickFAST{
         const Messages::MessageAccessor & accessor) const;
       virtual ValueType::Type fieldInstructionType()const;
 
+      /// @brief Access the name of the referenced template.
+      const std::string & getTemplateName()const
+      {
+        return templateName_;
+      }
+
+      /// @brief Access the namespace of the referenced template.
+      const std::string & getTemplateNamespace()const
+      {
+        return templateNamespace_;
+      }
+
     private:
       void interpretValue(const std::string & value);
 
@@ -51,6 +64,8 @@ namespace QuickFAST{
       std::string templateNamespace_;
       bool isFinalized_;
       size_t fieldCount_; // how many fields are in the target template (valid after finalize has been called)
+      std::string targetApplicationType_; // decides whether the target is merged (valid after finalize)
+      size_t positionLimit_; // the target's position limit (valid after finalize)
     };
 
     /// @brief Implement dynamic &lt;templateRef> field instruction.
@@ -123,6 +123,20 @@ namespace QuickFAST{
         pmapBitValid_ = true;
       }
 
+      /// @brief Has an explicit pmap bit been assigned to this field?
+      /// @see setPMapBit()
+      bool hasPMapBit()const
+      {
+        return pmapBitValid_;
+      }
+
+      /// @brief Retrieve the explicit pmap bit assigned to this field
+      /// @returns the pmap bit.  Only meaningful if hasPMapBit() is true.
+      size_t getPMapBit()const
+      {
+        return pmapBit_;
+      }
+
       /// @brief Implement the key= attribute
       /// @param key is the value of the attribute.
       void setKey(const std::string & key)
@@ -271,6 +285,17 @@ namespace QuickFAST{
         context.setDictionaryValue(dictionaryIndex_, value);
       }
 
+      /// @brief replace part of the string in the dictionary entry for this field
+      /// @param context holds the dictionary
+      /// @param pos is the position of the first byte to be replaced.
+      /// @param removeLength is the number of bytes to be replaced.
+      /// @param value is the replacement data.
+      /// @param length is the number of bytes of replacement data.
+      void replaceDictionaryString(Context & context, size_t pos, size_t removeLength, const unsigned char * value, size_t length)
+      {
+        context.replaceDictionaryString(dictionaryIndex_, pos, removeLength, value, length);
+      }
+
       /// @brief retrieve the value of the dictionary entry for this field
       /// @param context holds the dictionary
       /// @param value is the value that was found
@@ -291,6 +316,16 @@ namespace QuickFAST{
         return context.getDictionaryValue(dictionaryIndex_, value, length);
       }
 
+      /// @brief Retrieve the index of this field's entry in the Context's dictionary.
+      ///
+      /// Only meaningful for operators that use a dictionary, and only after
+      /// the TemplateRegistry has been finalized.
+      /// @returns the dictionary index
+      size_t getDictionaryIndex()const
+      {
+        return dictionaryIndex_;
+      }
+
       /// @brief Return the FieldOp type of this field
       virtual OpType opType()const = 0;
 
@@ -0,0 +1,193 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FLATRECORD_H
+#define FLATRECORD_H
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Common/Decimal.h>
+#include <Codecs/FlatRecordLayout.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Read access to a record built by the FlatRecordBuilder.
+    ///
+    /// A FlatRecord is a lightweight view: a pointer to the record's bytes,
+    /// the layout that describes them, and the offset where this part of the
+    /// record starts.  Sequence entries and groups are FlatRecords too.
+    ///
+    /// Fields are identified by slot index.  Look the index up once with
+    /// FlatRecordLayout::findSlot(), then use it for every record.
+    /// Nothing is allocated and no names are compared while reading.
+    class FlatRecord
+    {
+    public:
+      /// @brief Construct a view
+      /// @param data points to the start of the record.
+      /// @param layout describes this part of the record.
+      /// @param base is the offset of this part from the start of the record.
+      FlatRecord(const uchar * data, const FlatRecordLayout & layout, size_t base = 0)
+        : data_(data)
+        , layout_(&layout)
+        , base_(base)
+      {
+      }
+
+      /// @brief Access the layout of this part of the record.
+      const FlatRecordLayout & layout()const
+      {
+        return *layout_;
+      }
+
+      /// @brief Was a value decoded for this slot?
+      /// @param slot is the slot index.
+      bool isPresent(size_t slot)const
+      {
+        return (data_[base_ + slot / 8] & (1 << (slot % 8))) != 0;
+      }
+
+      /// @brief Get the value of a signed integer field.
+      /// @param slot is the slot index.
+      /// @param[out] value receives the value.
+      /// @returns true if the field is present.
+      bool getSignedInteger(size_t slot, int64 & value)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        read(slot, 0, value);
+        return true;
+      }
+
+      /// @brief Get the value of an unsigned integer field.
+      /// @param slot is the slot index.
+      /// @param[out] value receives the value.
+      /// @returns true if the field is present.
+      bool getUnsignedInteger(size_t slot, uint64 & value)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        read(slot, 0, value);
+        return true;
+      }
+
+      /// @brief Get the value of a decimal field.
+      /// @param slot is the slot index.
+      /// @param[out] value receives the value.
+      /// @returns true if the field is present.
+      bool getDecimal(size_t slot, Decimal & value)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        int64 mantissa;
+        int64 exponent;
+        read(slot, 0, mantissa);
+        read(slot, sizeof(int64), exponent);
+        value = Decimal(mantissa_t(mantissa), exponent_t(exponent), false);
+        return true;
+      }
+
+      /// @brief Get the value of a string or byte vector field.
+      ///
+      /// The value points into the record, and is valid as long as the record is.
+      /// @param slot is the slot index.
+      /// @param[out] value receives a pointer to the first byte.
+      /// @param[out] length receives the length in bytes.
+      /// @returns true if the field is present.
+      bool getString(size_t slot, const uchar *& value, size_t & length)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        uint32 offset;
+        uint32 size;
+        read(slot, 0, offset);
+        read(slot, sizeof(uint32), size);
+        value = data_ + offset;
+        length = size;
+        return true;
+      }
+
+      /// @brief Get the value of a string field.
+      /// @param slot is the slot index.
+      /// @param[out] value receives a copy of the value.
+      /// @returns true if the field is present.
+      bool getString(size_t slot, std::string & value)const
+      {
+        const uchar * bytes;
+        size_t length;
+        if(!getString(slot, bytes, length))
+        {
+          return false;
+        }
+        value.assign(reinterpret_cast<const char *>(bytes), length);
+        return true;
+      }
+
+      /// @brief Get the number of entries in a sequence.
+      /// @param slot is the slot index.
+      /// @param[out] length receives the entry count.
+      /// @returns true if the sequence is present.
+      bool getSequenceLength(size_t slot, size_t & length)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        uint32 count;
+        read(slot, sizeof(uint32), count);
+        length = count;
+        return true;
+      }
+
+      /// @brief Access an entry in a sequence.
+      /// @param slot is the slot index of a present sequence.
+      /// @param index must be less than the sequence length.
+      /// @returns a view of the entry.
+      FlatRecord getSequenceEntry(size_t slot, size_t index)const
+      {
+        const FlatRecordLayout & entryLayout = *(*layout_)[slot].nested_;
+        uint32 offset;
+        read(slot, 0, offset);
+        return FlatRecord(data_, entryLayout, offset + index * entryLayout.size());
+      }
+
+      /// @brief Access a group.
+      /// @param slot is the slot index of a group.
+      /// @param[out] group receives a view of the group.
+      /// @returns true if the group is present.
+      bool getGroup(size_t slot, FlatRecord & group)const
+      {
+        if(!isPresent(slot))
+        {
+          return false;
+        }
+        const FlatRecordLayout::Slot & groupSlot = (*layout_)[slot];
+        group = FlatRecord(data_, *groupSlot.nested_, base_ + groupSlot.offset_);
+        return true;
+      }
+
+    private:
+      template<typename VALUE>
+      void read(size_t slot, size_t offset, VALUE & value)const
+      {
+        memcpy(&value, data_ + base_ + (*layout_)[slot].offset_ + offset, sizeof(value));
+      }
+
+    private:
+      const uchar * data_;
+      const FlatRecordLayout * layout_;
+      size_t base_;
+    };
+  }
+}
+#endif // FLATRECORD_H
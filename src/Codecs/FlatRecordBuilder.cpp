@@ -0,0 +1,321 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "FlatRecordBuilder.h"
+#include <Codecs/FlatRecord.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  const size_t alignment = 8;
+  const size_t initialRecordSize = 1024;
+}
+
+FlatRecordBuilder::FlatRecordBuilder(
+  const TemplateRegistry & registry,
+  FlatRecordConsumer & consumer)
+: schema_(new FlatRecordSchema(registry))
+, consumer_(consumer)
+, templateId_(0)
+, layout_(0)
+, record_(initialRecordSize)
+, used_(0)
+{
+}
+
+FlatRecordBuilder::FlatRecordBuilder(
+  FlatRecordSchemaCPtr schema,
+  FlatRecordConsumer & consumer)
+: schema_(schema)
+, consumer_(consumer)
+, templateId_(0)
+, layout_(0)
+, record_(initialRecordSize)
+, used_(0)
+{
+}
+
+FlatRecordBuilder::~FlatRecordBuilder()
+{
+}
+
+size_t
+FlatRecordBuilder::allocate(size_t size)
+{
+  size_t offset = used_;
+  used_ = (used_ + size + alignment - 1) & ~(alignment - 1);
+  if(used_ > record_.size())
+  {
+    record_.resize(std::max(used_, 2 * record_.size()));
+  }
+  memset(&record_[0] + offset, 0, used_ - offset);
+  return offset;
+}
+
+size_t
+FlatRecordBuilder::findSlot(const Frame & frame, const Messages::FieldIdentity & identity)const
+{
+  size_t slot = frame.layout_->slotFor(identity);
+  if(slot == FlatRecordLayout::NO_SLOT)
+  {
+    std::string error("FlatRecordBuilder: field is not in the record layout: ");
+    error += identity.name();
+    throw UsageError("Coding Error", error.c_str());
+  }
+  return slot;
+}
+
+uchar *
+FlatRecordBuilder::setPresent(const Messages::FieldIdentity & identity)
+{
+  const Frame & frame = frames_.back();
+  size_t slot = findSlot(frame, identity);
+  uchar * base = &record_[0] + frame.base_;
+  base[slot / 8] |= uchar(1 << (slot % 8));
+  return base + (*frame.layout_)[slot].offset_;
+}
+
+void
+FlatRecordBuilder::pushFrame(const FlatRecordLayout & layout, size_t base, size_t entryCount)
+{
+  Frame frame;
+  frame.layout_ = &layout;
+  frame.base_ = base;
+  frame.entries_ = base;
+  frame.entryCount_ = entryCount;
+  frame.entryIndex_ = 0;
+  frames_.push_back(frame);
+}
+
+const std::string &
+FlatRecordBuilder::getApplicationType()const
+{
+  if(frames_.empty())
+  {
+    throw UsageError("Coding Error", "FlatRecordBuilder: no message has been started.");
+  }
+  return frames_.back().layout_->getApplicationType();
+}
+
+const std::string &
+FlatRecordBuilder::getApplicationTypeNs()const
+{
+  if(frames_.empty())
+  {
+    throw UsageError("Coding Error", "FlatRecordBuilder: no message has been started.");
+  }
+  return frames_.back().layout_->getApplicationTypeNs();
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int64 value)
+{
+  write(setPresent(identity), int64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint64 value)
+{
+  write(setPresent(identity), uint64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int32 value)
+{
+  write(setPresent(identity), int64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint32 value)
+{
+  write(setPresent(identity), uint64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int16 value)
+{
+  write(setPresent(identity), int64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uint16 value)
+{
+  write(setPresent(identity), uint64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const int8 value)
+{
+  write(setPresent(identity), int64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const uchar value)
+{
+  write(setPresent(identity), uint64(value));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const Decimal& value)
+{
+  uchar * slot = setPresent(identity);
+  write(slot, int64(value.getMantissa()));
+  write(slot + sizeof(int64), int64(value.getExponent()));
+}
+
+void
+FlatRecordBuilder::addValue(const Messages::FieldIdentity & identity, ValueType::Type /*type*/, const unsigned char * value, size_t length)
+{
+  // Append first: growing the record invalidates pointers into it.
+  size_t offset = allocate(length);
+  if(length > 0)
+  {
+    memcpy(&record_[0] + offset, value, length);
+  }
+  uchar * slot = setPresent(identity);
+  write(slot, uint32(offset));
+  write(slot + sizeof(uint32), uint32(length));
+}
+
+void
+FlatRecordBuilder::selectTemplate(template_id_t templateId)
+{
+  if(layout_ == 0 || templateId != templateId_)
+  {
+    layout_ = schema_->findLayout(templateId);
+    templateId_ = templateId;
+  }
+}
+
+Messages::ValueMessageBuilder &
+FlatRecordBuilder::startMessage(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  if(layout_ == 0)
+  {
+    throw UsageError("Coding Error", "FlatRecordBuilder: no layout selected for message.");
+  }
+  frames_.clear();
+  used_ = 0;
+  pushFrame(*layout_, allocate(layout_->size()));
+  return *this;
+}
+
+bool
+FlatRecordBuilder::endMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  frames_.clear();
+  return consumer_.consumeRecord(FlatRecord(&record_[0], *layout_));
+}
+
+bool
+FlatRecordBuilder::ignoreMessage(Messages::ValueMessageBuilder & /*messageBuilder*/)
+{
+  frames_.clear();
+  return true;
+}
+
+Messages::ValueMessageBuilder &
+FlatRecordBuilder::startSequence(
+  const Messages::FieldIdentity & identity,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*fieldCount*/,
+  const Messages::FieldIdentity & /*lengthIdentity*/,
+  size_t length)
+{
+  const Frame & frame = frames_.back();
+  const FlatRecordLayout::Slot & slot = (*frame.layout_)[findSlot(frame, identity)];
+  const FlatRecordLayout & entryLayout = *slot.nested_;
+  size_t entries = allocate(length * entryLayout.size());
+  uchar * sequence = setPresent(identity);
+  write(sequence, uint32(entries));
+  write(sequence + sizeof(uint32), uint32(length));
+  pushFrame(entryLayout, entries, length);
+  return *this;
+}
+
+void
+FlatRecordBuilder::endSequence(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*sequenceBuilder*/)
+{
+  frames_.pop_back();
+}
+
+Messages::ValueMessageBuilder &
+FlatRecordBuilder::startSequenceEntry(
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  Frame & frame = frames_.back();
+  if(frame.entryIndex_ >= frame.entryCount_)
+  {
+    throw UsageError("Coding Error", "FlatRecordBuilder: too many sequence entries.");
+  }
+  frame.base_ = frame.entries_ + frame.entryIndex_ * frame.layout_->size();
+  return *this;
+}
+
+void
+FlatRecordBuilder::endSequenceEntry(Messages::ValueMessageBuilder & /*entry*/)
+{
+  ++frames_.back().entryIndex_;
+}
+
+Messages::ValueMessageBuilder &
+FlatRecordBuilder::startGroup(
+  const Messages::FieldIdentity & identity,
+  const std::string & /*applicationType*/,
+  const std::string & /*applicationTypeNamespace*/,
+  size_t /*size*/)
+{
+  const Frame & frame = frames_.back();
+  const FlatRecordLayout::Slot & slot = (*frame.layout_)[findSlot(frame, identity)];
+  if(!slot.nested_)
+  {
+    throw UsageError("Coding Error", "FlatRecordBuilder does not support dynamic template references.");
+  }
+  setPresent(identity);
+  pushFrame(*slot.nested_, frame.base_ + slot.offset_);
+  return *this;
+}
+
+void
+FlatRecordBuilder::endGroup(
+  const Messages::FieldIdentity & /*identity*/,
+  Messages::ValueMessageBuilder & /*groupBuilder*/)
+{
+  frames_.pop_back();
+}
+
+bool
+FlatRecordBuilder::wantLog(unsigned short level)
+{
+  return consumer_.wantLog(level);
+}
+
+bool
+FlatRecordBuilder::logMessage(unsigned short level, const std::string & logMessage)
+{
+  return consumer_.logMessage(level, logMessage);
+}
+
+bool
+FlatRecordBuilder::reportDecodingError(const std::string & errorMessage)
+{
+  return consumer_.reportDecodingError(errorMessage);
+}
+
+bool
+FlatRecordBuilder::reportCommunicationError(const std::string & errorMessage)
+{
+  return consumer_.reportCommunicationError(errorMessage);
+}
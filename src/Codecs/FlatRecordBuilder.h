@@ -0,0 +1,149 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FLATRECORDBUILDER_H
+#define FLATRECORDBUILDER_H
+#include <Common/QuickFAST_Export.h>
+#include <Messages/ValueMessageBuilder.h>
+#include <Codecs/FlatRecordLayout.h>
+#include <Codecs/FlatRecordConsumer.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Build each decoded message into a contiguous, reusable record.
+    ///
+    /// An alternative to the GenericMessageBuilder for applications that want
+    /// the whole message, but not the cost of a Message and its Fields.
+    ///
+    /// The layout of every template is computed when the builder is constructed.
+    /// While decoding, each value is written directly into the record at its
+    /// precomputed offset.  Strings and sequence entries are appended to the
+    /// record's trailing area.  The record's buffer is reused for each message,
+    /// so in steady state nothing is allocated.
+    ///
+    /// Each completed record is passed to a FlatRecordConsumer.
+    /// @see FlatRecordLayout for the record format.
+    /// @see FlatRecord for reading records.
+    class QuickFAST_Export FlatRecordBuilder : public Messages::ValueMessageBuilder
+    {
+    public:
+      /// @brief Construct, computing the layouts for the templates in a registry.
+      /// @param registry must be finalized.
+      /// @param consumer receives the records.
+      FlatRecordBuilder(
+        const TemplateRegistry & registry,
+        FlatRecordConsumer & consumer);
+
+      /// @brief Construct using precomputed layouts.
+      ///
+      /// A schema may be shared by builders in several threads.
+      /// @param schema supplies the layouts.
+      /// @param consumer receives the records.
+      FlatRecordBuilder(
+        FlatRecordSchemaCPtr schema,
+        FlatRecordConsumer & consumer);
+
+      virtual ~FlatRecordBuilder();
+
+      /// @brief Access the layouts
+      ///
+      /// Consumers use this to find slot indexes before decoding starts.
+      const FlatRecordSchema & schema()const
+      {
+        return *schema_;
+      }
+
+      //////////////////////////////
+      // Implement ValueMessageBuilder
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint64 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint32 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uint16 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const int8 value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const uchar value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const Decimal& value);
+      virtual void addValue(const Messages::FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+      virtual void selectTemplate(template_id_t templateId);
+      virtual Messages::ValueMessageBuilder & startMessage(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual bool endMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual bool ignoreMessage(Messages::ValueMessageBuilder & messageBuilder);
+      virtual Messages::ValueMessageBuilder & startSequence(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t fieldCount,
+        const Messages::FieldIdentity & lengthIdentity,
+        size_t length);
+      virtual void endSequence(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & sequenceBuilder);
+      virtual Messages::ValueMessageBuilder & startSequenceEntry(
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endSequenceEntry(Messages::ValueMessageBuilder & entry);
+      virtual Messages::ValueMessageBuilder & startGroup(
+        const Messages::FieldIdentity & identity,
+        const std::string & applicationType,
+        const std::string & applicationTypeNamespace,
+        size_t size);
+      virtual void endGroup(
+        const Messages::FieldIdentity & identity,
+        Messages::ValueMessageBuilder & groupBuilder);
+
+      ///////////////////
+      // Implement Logger
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      /// The part of the record being built: the message, a group, or a sequence.
+      struct Frame
+      {
+        const FlatRecordLayout * layout_;
+        size_t base_;
+        size_t entries_;
+        size_t entryCount_;
+        size_t entryIndex_;
+      };
+
+      size_t allocate(size_t size);
+      size_t findSlot(const Frame & frame, const Messages::FieldIdentity & identity)const;
+      uchar * setPresent(const Messages::FieldIdentity & identity);
+      void pushFrame(const FlatRecordLayout & layout, size_t base, size_t entryCount = 0);
+
+      template<typename VALUE>
+      void write(uchar * slot, VALUE value)
+      {
+        memcpy(slot, &value, sizeof(value));
+      }
+
+    private:
+      FlatRecordBuilder(const FlatRecordBuilder &);
+      FlatRecordBuilder & operator=(const FlatRecordBuilder &);
+
+    private:
+      FlatRecordSchemaCPtr schema_;
+      FlatRecordConsumer & consumer_;
+      template_id_t templateId_;
+      const FlatRecordLayout * layout_;
+      std::vector<uchar> record_;
+      size_t used_;
+      std::vector<Frame> frames_;
+    };
+  }
+}
+#endif // FLATRECORDBUILDER_H
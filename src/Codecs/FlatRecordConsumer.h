@@ -0,0 +1,30 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FLATRECORDCONSUMER_H
+#define FLATRECORDCONSUMER_H
+#include <Common/QuickFAST_Export.h>
+#include <Common/Logger.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    class FlatRecord;
+
+    /// @brief interface to be implemented by a consumer of records from a FlatRecordBuilder.
+    class FlatRecordConsumer : public Common::Logger
+    {
+    public:
+      virtual ~FlatRecordConsumer(){}
+
+      /// @brief Accept a decoded record
+      /// @param record is the decoded record, valid for the life of this call.
+      ///        record.layout().templateId() identifies the template.
+      /// @returns true if decoding should continue; false to stop decoding
+      virtual bool consumeRecord(const FlatRecord & record) = 0;
+    };
+  }
+}
+#endif /* FLATRECORDCONSUMER_H */
@@ -0,0 +1,238 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "FlatRecordLayout.h"
+#include <Codecs/SegmentBody.h>
+#include <Codecs/Template.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldInstructionTemplateRef.h>
+#include <Common/Exceptions.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+const size_t FlatRecordLayout::NO_SLOT;
+
+namespace
+{
+  const size_t alignment = 8;
+
+  size_t align(size_t offset)
+  {
+    return (offset + alignment - 1) & ~(alignment - 1);
+  }
+
+  /// @brief How many bytes the fixed part of a slot occupies.
+  size_t slotSize(const FlatRecordLayout::Slot & slot)
+  {
+    switch(slot.type_)
+    {
+    case ValueType::DECIMAL:
+      return 2 * sizeof(int64);
+    case ValueType::GROUP:
+      return slot.nested_->size();
+    case ValueType::TEMPLATEREF:
+      if(slot.nested_)
+      {
+        return slot.nested_->size();
+      }
+      return 0;
+    default:
+      // integers, (offset, length) for strings, and (offset, count) for sequences
+      return sizeof(uint64);
+    }
+  }
+}
+
+FlatRecordLayout::FlatRecordLayout(
+  const SegmentBody & segment,
+  const TemplateRegistry & registry,
+  template_id_t templateId,
+  const std::string & name)
+: templateId_(templateId)
+, name_(name)
+, applicationType_(segment.getApplicationType())
+, applicationTypeNs_(segment.getApplicationTypeNamespace())
+, size_(0)
+{
+  std::vector<const SegmentBody *> active;
+  active.push_back(&segment);
+  addSlots(segment, applicationType_, registry, active);
+  assignOffsets();
+}
+
+FlatRecordLayout::FlatRecordLayout(
+  const SegmentBody & segment,
+  const TemplateRegistry & registry,
+  const std::string & name,
+  std::vector<const SegmentBody *> & active)
+: templateId_(0)
+, name_(name)
+, applicationType_(segment.getApplicationType())
+, applicationTypeNs_(segment.getApplicationTypeNamespace())
+, size_(0)
+{
+  addSlots(segment, applicationType_, registry, active);
+  assignOffsets();
+}
+
+FlatRecordLayout::~FlatRecordLayout()
+{
+}
+
+void
+FlatRecordLayout::addSlots(
+  const SegmentBody & segment,
+  const std::string & applicationType,
+  const TemplateRegistry & registry,
+  std::vector<const SegmentBody *> & active)
+{
+  size_t instructionCount = segment.size();
+  for(size_t pos = 0; pos < instructionCount; ++pos)
+  {
+    const FieldInstructionCPtr & instruction = segment.getInstruction(pos);
+    Slot slot;
+    slot.identity_ = &instruction->getIdentity();
+    slot.type_ = instruction->fieldInstructionType();
+    slot.offset_ = 0;
+
+    const SegmentBody * nestedSegment = 0;
+    SegmentBodyPtr body;
+    TemplateCPtr target;
+    if(slot.type_ == ValueType::SEQUENCE || slot.type_ == ValueType::GROUP)
+    {
+      if(instruction->getSegmentBody(body))
+      {
+        nestedSegment = body.get();
+      }
+    }
+    else if(slot.type_ == ValueType::TEMPLATEREF)
+    {
+      const FieldInstructionStaticTemplateRef * templateRef =
+        dynamic_cast<const FieldInstructionStaticTemplateRef *>(instruction.get());
+      if(templateRef != 0)
+      {
+        if(!registry.findNamedTemplate(
+          templateRef->getTemplateName(),
+          templateRef->getTemplateNamespace(),
+          target))
+        {
+          throw TemplateDefinitionError("Unknown template name for static templateref: " + templateRef->getTemplateName());
+        }
+        nestedSegment = target.get();
+      }
+    }
+
+    if(nestedSegment != 0)
+    {
+      if(std::find(active.begin(), active.end(), nestedSegment) != active.end())
+      {
+        throw TemplateDefinitionError("Recursive template reference cannot have a flat record layout: " + slot.identity_->name());
+      }
+      active.push_back(nestedSegment);
+      if(slot.type_ == ValueType::TEMPLATEREF && target->getApplicationType() == applicationType)
+      {
+        // The decoder merges these fields into the containing segment.
+        addSlots(*target, applicationType, registry, active);
+        active.pop_back();
+        continue;
+      }
+      slot.nested_.reset(new FlatRecordLayout(*nestedSegment, registry, slot.identity_->getLocalName(), active));
+      active.pop_back();
+    }
+    slots_.push_back(slot);
+  }
+}
+
+void
+FlatRecordLayout::assignOffsets()
+{
+  size_t offset = align((slots_.size() + 7) / 8);
+  for(size_t nSlot = 0; nSlot < slots_.size(); ++nSlot)
+  {
+    Slot & slot = slots_[nSlot];
+    slot.offset_ = offset;
+    offset = align(offset + slotSize(slot));
+
+    size_t position = slot.identity_->position();
+    if(position != Messages::FieldIdentity::NO_POSITION)
+    {
+      if(position >= positionIndex_.size())
+      {
+        positionIndex_.resize(position + 1, NO_SLOT);
+      }
+      // Fields from segments merged side by side may share a position.
+      // The first one gets the fast lookup.
+      if(positionIndex_[position] == NO_SLOT)
+      {
+        positionIndex_[position] = nSlot;
+      }
+    }
+  }
+  size_ = offset;
+}
+
+size_t
+FlatRecordLayout::findIdentity(const Messages::FieldIdentity & identity)const
+{
+  for(size_t nSlot = 0; nSlot < slots_.size(); ++nSlot)
+  {
+    if(slots_[nSlot].identity_ == &identity)
+    {
+      return nSlot;
+    }
+  }
+  for(size_t nSlot = 0; nSlot < slots_.size(); ++nSlot)
+  {
+    if(*slots_[nSlot].identity_ == identity)
+    {
+      return nSlot;
+    }
+  }
+  return NO_SLOT;
+}
+
+bool
+FlatRecordLayout::findSlot(const std::string & name, size_t & index)const
+{
+  for(size_t nSlot = 0; nSlot < slots_.size(); ++nSlot)
+  {
+    if(slots_[nSlot].identity_->getLocalName() == name)
+    {
+      index = nSlot;
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////
+// FlatRecordSchema
+
+FlatRecordSchema::FlatRecordSchema(const TemplateRegistry & registry)
+{
+  for(TemplateRegistry::const_iterator it = registry.begin();
+    it != registry.end();
+    ++it)
+  {
+    const TemplateCPtr & templ = it->second;
+    layouts_[templ->getId()].reset(new FlatRecordLayout(*templ, registry, templ->getId(), templ->getTemplateName()));
+  }
+}
+
+FlatRecordSchema::~FlatRecordSchema()
+{
+}
+
+const FlatRecordLayout *
+FlatRecordSchema::findLayout(template_id_t templateId)const
+{
+  Layouts::const_iterator it = layouts_.find(templateId);
+  if(it == layouts_.end())
+  {
+    return 0;
+  }
+  return it->second.get();
+}
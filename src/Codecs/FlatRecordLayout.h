@@ -0,0 +1,193 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FLATRECORDLAYOUT_H
+#define FLATRECORDLAYOUT_H
+#include "FlatRecordLayout_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <Messages/FieldIdentity.h>
+#include <Codecs/SegmentBody_fwd.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief The fixed byte layout of the fields decoded from one SegmentBody.
+    ///
+    /// Every field instruction in the segment gets a slot at a fixed offset
+    /// within the layout.  The layout starts with a presence bitmap, one bit per slot,
+    /// followed by the slots, each aligned to eight bytes:
+    ///  - integers are stored as int64 or uint64.
+    ///  - decimals are stored as an int64 mantissa followed by an int64 exponent.
+    ///  - strings and byte vectors are stored as a uint32 offset and a uint32 length.
+    ///    The offset locates the bytes in the record's trailing area.
+    ///  - sequences are stored as a uint32 offset and a uint32 entry count.
+    ///    The entries are contiguous in the record's trailing area, each with the
+    ///    layout of the sequence's segment.
+    ///  - groups are stored inline with the layout of the group's segment.
+    ///
+    /// Static template references whose application type matches the containing
+    /// segment are flattened into the containing layout, just as the decoder
+    /// merges them into the containing message.  Others are treated as groups.
+    /// Dynamic template references have an empty slot. Their content cannot be
+    /// laid out in advance.
+    ///
+    /// All offsets are relative to the start of the record, so a record may be
+    /// copied or moved as a block.
+    class QuickFAST_Export FlatRecordLayout
+    {
+    public:
+      /// @brief Returned by slotFor() when there is no slot for a field.
+      static const size_t NO_SLOT = size_t(-1);
+
+      /// @brief The description of one field's storage
+      struct Slot
+      {
+        /// Identifies the field. Owned by the field instruction.
+        const Messages::FieldIdentity * identity_;
+        /// The type of the field.
+        ValueType::Type type_;
+        /// Offset from the start of the containing layout.
+        size_t offset_;
+        /// Layout of a group or a sequence entry.  Null for other fields.
+        FlatRecordLayoutCPtr nested_;
+      };
+
+      /// @brief Build the layout for a segment.
+      /// @param segment is a finalized segment body: a template, group or sequence.
+      /// @param registry is used to resolve static template references.
+      /// @param templateId identifies the template.  Zero for groups and sequences.
+      /// @param name is the name of the template, group or sequence.
+      /// @throws TemplateDefinitionError for recursive template references.
+      FlatRecordLayout(
+        const SegmentBody & segment,
+        const TemplateRegistry & registry,
+        template_id_t templateId = 0,
+        const std::string & name = "");
+
+      ~FlatRecordLayout();
+
+      /// @brief The template ID. Zero for groups and sequence entries.
+      template_id_t templateId()const
+      {
+        return templateId_;
+      }
+
+      /// @brief The name of the template, group or sequence.
+      const std::string & name()const
+      {
+        return name_;
+      }
+
+      /// @brief The application type of the segment.
+      const std::string & getApplicationType()const
+      {
+        return applicationType_;
+      }
+
+      /// @brief The namespace of the application type.
+      const std::string & getApplicationTypeNs()const
+      {
+        return applicationTypeNs_;
+      }
+
+      /// @brief The size of the fixed part of the layout, in bytes.
+      size_t size()const
+      {
+        return size_;
+      }
+
+      /// @brief How many slots are in the layout.
+      size_t slotCount()const
+      {
+        return slots_.size();
+      }
+
+      /// @brief Access a slot.
+      /// @param index must be less than slotCount()
+      const Slot & operator[](size_t index)const
+      {
+        return slots_[index];
+      }
+
+      /// @brief Find a slot by field name.
+      ///
+      /// Intended to be used once, before decoding starts, so that
+      /// values can later be read by slot index.
+      /// @param name is the local name of the field.
+      /// @param[out] index receives the slot index.
+      /// @returns true if the field is in this layout.
+      bool findSlot(const std::string & name, size_t & index)const;
+
+      /// @brief Find the slot for a decoded field.
+      ///
+      /// Fast when the identity belongs to one of this layout's field instructions.
+      /// @param identity identifies the field.
+      /// @returns the slot index or NO_SLOT.
+      size_t slotFor(const Messages::FieldIdentity & identity)const
+      {
+        size_t position = identity.position();
+        if(position < positionIndex_.size())
+        {
+          size_t index = positionIndex_[position];
+          if(index != NO_SLOT && slots_[index].identity_ == &identity)
+          {
+            return index;
+          }
+        }
+        return findIdentity(identity);
+      }
+
+    private:
+      void addSlots(
+        const SegmentBody & segment,
+        const std::string & applicationType,
+        const TemplateRegistry & registry,
+        std::vector<const SegmentBody *> & active);
+      void assignOffsets();
+      size_t findIdentity(const Messages::FieldIdentity & identity)const;
+
+    private:
+      FlatRecordLayout(const FlatRecordLayout &);
+      FlatRecordLayout & operator=(const FlatRecordLayout &);
+      FlatRecordLayout(
+        const SegmentBody & segment,
+        const TemplateRegistry & registry,
+        const std::string & name,
+        std::vector<const SegmentBody *> & active);
+
+    private:
+      template_id_t templateId_;
+      std::string name_;
+      std::string applicationType_;
+      std::string applicationTypeNs_;
+      std::vector<Slot> slots_;
+      std::vector<size_t> positionIndex_;
+      size_t size_;
+    };
+
+    /// @brief The FlatRecordLayouts for all the templates in a registry
+    class QuickFAST_Export FlatRecordSchema
+    {
+    public:
+      /// @brief Build a layout for every template in the registry.
+      /// @param registry must be finalized.
+      explicit FlatRecordSchema(const TemplateRegistry & registry);
+
+      ~FlatRecordSchema();
+
+      /// @brief Find the layout for a template
+      /// @param templateId identifies the template
+      /// @returns the layout or 0 if the template is unknown.
+      const FlatRecordLayout * findLayout(template_id_t templateId)const;
+
+    private:
+      typedef std::map<template_id_t, FlatRecordLayoutCPtr> Layouts;
+      Layouts layouts_;
+    };
+  }
+}
+#endif // FLATRECORDLAYOUT_H
@@ -0,0 +1,27 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FLATRECORDLAYOUT_FWD_H
+#define FLATRECORDLAYOUT_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class FlatRecordLayout;
+    /// @brief Smart pointer to a FlatRecordLayout.
+    typedef boost::shared_ptr<FlatRecordLayout> FlatRecordLayoutPtr;
+    /// @brief Smart pointer to a const FlatRecordLayout.
+    typedef boost::shared_ptr<const FlatRecordLayout> FlatRecordLayoutCPtr;
+    class FlatRecordSchema;
+    /// @brief Smart pointer to a FlatRecordSchema.
+    typedef boost::shared_ptr<FlatRecordSchema> FlatRecordSchemaPtr;
+    /// @brief Smart pointer to a const FlatRecordSchema.
+    typedef boost::shared_ptr<const FlatRecordSchema> FlatRecordSchemaCPtr;
+  }
+}
+#endif // FLATRECORDLAYOUT_FWD_H
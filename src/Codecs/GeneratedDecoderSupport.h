@@ -0,0 +1,365 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef GENERATEDDECODERSUPPORT_H
+#define GENERATEDDECODERSUPPORT_H
+// All inline, do not export.
+//#include <Common/QuickFAST_Export.h>
+#include <Common/Decimal.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/Context.h>
+#include <Codecs/DataSource.h>
+#include <Codecs/PresenceMap.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Decoding primitives used by code generated by the TemplateCodeGenerator.
+    ///
+    /// Each method implements one field type/operator combination with the same
+    /// semantics as the corresponding FieldInstruction::decodeXxx method.  Rather
+    /// than adding the value to a ValueMessageBuilder, the value is stored in
+    /// the value argument, and the return value indicates whether a value is present.
+    ///
+    /// Generated code passes literal constants for presence, dictionary index, and
+    /// initial values so the compiler can fold away any unused paths.
+    class GeneratedDecoderSupport
+    {
+    public:
+      /// @brief Decode a signed or unsigned integer
+      /// @param source supplies the data
+      /// @param context reports errors
+      /// @param ignoreOverflow disables overflow checking (see FieldInstruction::getIgnoreOverflow())
+      /// @param value receives the decoded value
+      /// @param name identifies the field for error messages
+      template<typename INTEGER_TYPE, bool SIGNED>
+      static void decodeInteger(
+        DataSource & source,
+        Context & context,
+        bool ignoreOverflow,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        if(SIGNED) // expect compile-time optimization here
+        {
+          FieldInstruction::decodeSignedInteger(source, context, value, name, false, ignoreOverflow);
+        }
+        else
+        {
+          FieldInstruction::decodeUnsignedInteger(source, context, value, name, ignoreOverflow);
+        }
+      }
+
+      /// @brief Integer field with no operator.
+      template<typename INTEGER_TYPE, bool SIGNED>
+      static bool integerNop(
+        DataSource & source,
+        Context & context,
+        bool mandatory,
+        bool ignoreOverflow,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        decodeInteger<INTEGER_TYPE, SIGNED>(source, context, ignoreOverflow, value, name);
+        return mandatory || !FieldInstruction::checkNullInteger(value);
+      }
+
+      /// @brief Integer field with constant operator.
+      template<typename INTEGER_TYPE>
+      static bool integerConstant(
+        PresenceMap & pmap,
+        bool mandatory,
+        INTEGER_TYPE constant,
+        INTEGER_TYPE & value)
+      {
+        if(!mandatory && !pmap.checkNextField())
+        {
+          return false;
+        }
+        value = constant;
+        return true;
+      }
+
+      /// @brief Integer field with default operator.
+      template<typename INTEGER_TYPE, bool SIGNED>
+      static bool integerDefault(
+        DataSource & source,
+        PresenceMap & pmap,
+        Context & context,
+        bool mandatory,
+        bool ignoreOverflow,
+        bool hasDefault,
+        INTEGER_TYPE defaultValue,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        if(pmap.checkNextField())
+        {
+          return integerNop<INTEGER_TYPE, SIGNED>(source, context, mandatory, ignoreOverflow, value, name);
+        }
+        if(hasDefault)
+        {
+          value = defaultValue;
+          return true;
+        }
+        if(mandatory)
+        {
+          context.reportError("[ERR D5]", "Mandatory default operator with no value.", name);
+        }
+        return false;
+      }
+
+      /// @brief Integer field with copy operator.
+      template<typename INTEGER_TYPE, bool SIGNED>
+      static bool integerCopy(
+        DataSource & source,
+        PresenceMap & pmap,
+        Context & context,
+        bool mandatory,
+        bool ignoreOverflow,
+        size_t dictionaryIndex,
+        bool hasInitial,
+        INTEGER_TYPE initialValue,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        if(pmap.checkNextField())
+        {
+          decodeInteger<INTEGER_TYPE, SIGNED>(source, context, ignoreOverflow, value, name);
+          if(!mandatory && FieldInstruction::checkNullInteger(value))
+          {
+            context.setDictionaryValueNull(dictionaryIndex);
+            return false;
+          }
+          context.setDictionaryValue(dictionaryIndex, value);
+          return true;
+        }
+        Context::DictionaryStatus previousStatus = context.getDictionaryValue(dictionaryIndex, value);
+        if(previousStatus == Context::OK_VALUE)
+        {
+          return true;
+        }
+        if(previousStatus == Context::UNDEFINED_VALUE && hasInitial)
+        {
+          value = initialValue;
+          context.setDictionaryValue(dictionaryIndex, value);
+          return true;
+        }
+        if(mandatory)
+        {
+          context.reportError("[ERR D5]", "Copy operator missing mandatory integer field/no initial value", name);
+          value = 0;
+          context.setDictionaryValue(dictionaryIndex, value);
+          return true;
+        }
+        return false;
+      }
+
+      /// @brief Integer field with increment operator.
+      template<typename INTEGER_TYPE, bool SIGNED>
+      static bool integerIncrement(
+        DataSource & source,
+        PresenceMap & pmap,
+        Context & context,
+        bool mandatory,
+        bool ignoreOverflow,
+        size_t dictionaryIndex,
+        bool hasInitial,
+        INTEGER_TYPE initialValue,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        if(pmap.checkNextField())
+        {
+          decodeInteger<INTEGER_TYPE, SIGNED>(source, context, ignoreOverflow, value, name);
+          if(!mandatory && FieldInstruction::checkNullInteger(value))
+          {
+            context.setDictionaryValueNull(dictionaryIndex);
+            return false;
+          }
+          context.setDictionaryValue(dictionaryIndex, value);
+          return true;
+        }
+        Context::DictionaryStatus previousStatus = context.getDictionaryValue(dictionaryIndex, value);
+        if(previousStatus == Context::OK_VALUE)
+        {
+          value += 1;
+        }
+        else if(previousStatus == Context::UNDEFINED_VALUE && hasInitial)
+        {
+          value = initialValue;
+        }
+        else if(mandatory)
+        {
+          context.reportError("[ERR D5]", "Missing initial value for mandatory integer with increment operator", name);
+          value = 0;
+        }
+        else
+        {
+          return false;
+        }
+        context.setDictionaryValue(dictionaryIndex, value);
+        return true;
+      }
+
+      /// @brief Integer field with delta operator.
+      template<typename INTEGER_TYPE>
+      static bool integerDelta(
+        DataSource & source,
+        Context & context,
+        bool mandatory,
+        size_t dictionaryIndex,
+        bool hasInitial,
+        INTEGER_TYPE initialValue,
+        INTEGER_TYPE & value,
+        const std::string & name)
+      {
+        int64 delta;
+        FieldInstruction::decodeSignedInteger(source, context, delta, name, true);
+        if(!mandatory && FieldInstruction::checkNullInteger(delta))
+        {
+          return false;
+        }
+        value = initialValue;
+        if(context.getDictionaryValue(dictionaryIndex, value) == Context::UNDEFINED_VALUE && hasInitial)
+        {
+          value = initialValue;
+        }
+        value = INTEGER_TYPE(value + delta);
+        context.setDictionaryValue(dictionaryIndex, value);
+        return true;
+      }
+
+      /// @brief ASCII field with no operator.
+      static bool asciiNop(
+        DataSource & source,
+        Context & context,
+        bool mandatory,
+        std::string & value)
+      {
+        WorkingBuffer & buffer = context.getWorkingBuffer();
+        FieldInstruction::decodeAscii(source, buffer);
+        if(!mandatory && FieldInstruction::checkNullAscii(buffer))
+        {
+          return false;
+        }
+        if(FieldInstruction::checkEmptyAscii(buffer))
+        {
+          value.clear();
+          return true;
+        }
+        value.assign(reinterpret_cast<const char *>(buffer.begin()), buffer.size());
+        return true;
+      }
+
+      /// @brief ASCII field with constant operator.
+      static bool asciiConstant(
+        PresenceMap & pmap,
+        bool mandatory,
+        const char * constant,
+        std::string & value)
+      {
+        if(!mandatory && !pmap.checkNextField())
+        {
+          return false;
+        }
+        value = constant;
+        return true;
+      }
+
+      /// @brief ASCII field with default operator.
+      static bool asciiDefault(
+        DataSource & source,
+        PresenceMap & pmap,
+        Context & context,
+        bool mandatory,
+        const char * defaultValue,
+        std::string & value,
+        const std::string & name)
+      {
+        if(pmap.checkNextField())
+        {
+          return asciiNop(source, context, mandatory, value);
+        }
+        if(defaultValue != 0)
+        {
+          value = defaultValue;
+          return true;
+        }
+        if(mandatory)
+        {
+          context.reportFatal("[ERR D5]", "Mandatory default operator with no value.", name);
+        }
+        return false;
+      }
+
+      /// @brief ASCII field with copy operator.
+      static bool asciiCopy(
+        DataSource & source,
+        PresenceMap & pmap,
+        Context & context,
+        bool mandatory,
+        size_t dictionaryIndex,
+        const char * initialValue,
+        std::string & value,
+        const std::string & name)
+      {
+        if(pmap.checkNextField())
+        {
+          if(asciiNop(source, context, mandatory, value))
+          {
+            context.setDictionaryValue(
+              dictionaryIndex,
+              reinterpret_cast<const unsigned char *>(value.data()),
+              value.size());
+            return true;
+          }
+          context.setDictionaryValueNull(dictionaryIndex);
+          return false;
+        }
+        const unsigned char * previous = 0;
+        size_t previousSize = 0;
+        Context::DictionaryStatus previousStatus = context.getDictionaryValue(dictionaryIndex, previous, previousSize);
+        if(previousStatus == Context::OK_VALUE)
+        {
+          value.assign(reinterpret_cast<const char *>(previous), previousSize);
+          return true;
+        }
+        if(previousStatus == Context::UNDEFINED_VALUE && initialValue != 0)
+        {
+          value = initialValue;
+          context.setDictionaryValue(dictionaryIndex, value);
+          return true;
+        }
+        if(mandatory)
+        {
+          context.reportFatal("[ERR D6]", "No value available for mandatory copy field.", name);
+        }
+        return false;
+      }
+
+      /// @brief Decimal field with a single (nop) operator.
+      static bool decimalNop(
+        DataSource & source,
+        Context & context,
+        bool mandatory,
+        Decimal & value,
+        const std::string & name)
+      {
+        exponent_t exponent = 0;
+        FieldInstruction::decodeSignedInteger(source, context, exponent, name);
+        if(!mandatory && FieldInstruction::checkNullInteger(exponent))
+        {
+          return false;
+        }
+        mantissa_t mantissa;
+        FieldInstruction::decodeSignedInteger(source, context, mantissa, name);
+        value = Decimal(mantissa, exponent);
+        return true;
+      }
+    };
+  }
+}
+#endif // GENERATEDDECODERSUPPORT_H
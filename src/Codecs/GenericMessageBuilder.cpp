@@ -13,6 +13,48 @@
 using namespace QuickFAST;
 using namespace Codecs;
 
+namespace
+{
+  Messages::FieldSetPtr createFieldSet(const FieldSetRecyclerPtr & recycler, size_t size)
+  {
+    if(!recycler)
+    {
+      return Messages::FieldSetPtr(new Messages::FieldSet(size));
+    }
+    Messages::FieldSet * fieldSet = recycler->acquire();
+    if(fieldSet == 0)
+    {
+      fieldSet = new Messages::FieldSet(size);
+    }
+    else
+    {
+      fieldSet->clear(size);
+    }
+    return recycler->share(fieldSet);
+  }
+
+  Messages::SequencePtr createSequence(
+    const SequenceRecyclerPtr & recycler,
+    const Messages::FieldIdentity & lengthIdentity,
+    size_t length)
+  {
+    if(!recycler)
+    {
+      return Messages::SequencePtr(new Messages::Sequence(lengthIdentity, length));
+    }
+    Messages::Sequence * sequence = recycler->acquire();
+    if(sequence == 0)
+    {
+      sequence = new Messages::Sequence(lengthIdentity, length);
+    }
+    else
+    {
+      sequence->reinitialize(lengthIdentity, length);
+    }
+    return recycler->share(sequence);
+  }
+}
+
 //////////////////////////
 // GenericSequenceBuilder
 
@@ -45,7 +87,24 @@ GenericSequenceBuilder::initialize(
   size_t length
   )
 {
-  this->sequence_.reset(new Messages::Sequence(lengthIdentity, length));
+  this->sequence_ = createSequence(sequences_, lengthIdentity, length);
+}
+
+void
+GenericSequenceBuilder::setRecyclers(
+  const FieldSetRecyclerPtr & fieldSets,
+  const SequenceRecyclerPtr & sequences)
+{
+  fieldSets_ = fieldSets;
+  sequences_ = sequences;
+  if(sequenceBuilder_)
+  {
+    sequenceBuilder_->setRecyclers(fieldSets, sequences);
+  }
+  if(groupBuilder_)
+  {
+    groupBuilder_->setRecyclers(fieldSets, sequences);
+  }
 }
 
 const std::string &
@@ -105,6 +164,7 @@ GenericSequenceBuilder::startSequence(
   if(!sequenceBuilder_)
   {
     sequenceBuilder_.reset(new GenericSequenceBuilder(this));
+    sequenceBuilder_->setRecyclers(fieldSets_, sequences_);
   }
   sequenceBuilder_->initialize(
     identity,
@@ -142,7 +202,7 @@ GenericSequenceBuilder::startSequenceEntry(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  fieldSet_.reset(new Messages::FieldSet(size));
+  fieldSet_ = createFieldSet(fieldSets_, size);
   fieldSet_->setApplicationType(
     applicationType,
     applicationTypeNamespace);
@@ -170,6 +230,7 @@ GenericSequenceBuilder::startGroup(
   if(!groupBuilder_)
   {
     groupBuilder_.reset(new GenericGroupBuilder(this));
+    groupBuilder_->setRecyclers(fieldSets_, sequences_);
   }
   groupBuilder_->initialize(
     identity,
@@ -258,10 +319,27 @@ GenericGroupBuilder::initialize(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  group_.reset(new Messages::FieldSet(size));
+  group_ = createFieldSet(fieldSets_, size);
   group_->setApplicationType(applicationType, applicationTypeNamespace);
 }
 
+void
+GenericGroupBuilder::setRecyclers(
+  const FieldSetRecyclerPtr & fieldSets,
+  const SequenceRecyclerPtr & sequences)
+{
+  fieldSets_ = fieldSets;
+  sequences_ = sequences;
+  if(sequenceBuilder_)
+  {
+    sequenceBuilder_->setRecyclers(fieldSets, sequences);
+  }
+  if(groupBuilder_)
+  {
+    groupBuilder_->setRecyclers(fieldSets, sequences);
+  }
+}
+
 const std::string &
 GenericGroupBuilder::getApplicationType()const
 {
@@ -318,6 +396,7 @@ GenericGroupBuilder::startSequence(
   if(!sequenceBuilder_)
   {
     sequenceBuilder_.reset(new GenericSequenceBuilder(this));
+    sequenceBuilder_->setRecyclers(fieldSets_, sequences_);
   }
   sequenceBuilder_->initialize(
     identity,
@@ -377,6 +456,7 @@ GenericGroupBuilder::startGroup(
   if(!groupBuilder_)
   {
     groupBuilder_.reset(new GenericGroupBuilder(this));
+    groupBuilder_->setRecyclers(fieldSets_, sequences_);
   }
   groupBuilder_->initialize(
     identity,
@@ -458,6 +538,25 @@ GenericMessageBuilder::~GenericMessageBuilder()
 {
 }
 
+void
+GenericMessageBuilder::setRecycling(bool enable, size_t maxFree)
+{
+  if(enable)
+  {
+    messages_.reset(new MessageRecycler(maxFree));
+    fieldSets_.reset(new FieldSetRecycler(maxFree));
+    sequences_.reset(new SequenceRecycler(maxFree));
+  }
+  else
+  {
+    messages_.reset();
+    fieldSets_.reset();
+    sequences_.reset();
+  }
+  sequenceBuilder_.setRecyclers(fieldSets_, sequences_);
+  groupBuilder_.setRecyclers(fieldSets_, sequences_);
+}
+
 const std::string &
 GenericMessageBuilder::getApplicationType()const
 {
@@ -484,7 +583,23 @@ GenericMessageBuilder::startMessage(
   const std::string & applicationTypeNamespace,
   size_t size)
 {
-  message_.reset(new Messages::Message(size));
+  if(messages_)
+  {
+    Messages::Message * message = messages_->acquire();
+    if(message == 0)
+    {
+      message = new Messages::Message(size);
+    }
+    else
+    {
+      message->clear(size);
+    }
+    message_ = messages_->share(message);
+  }
+  else
+  {
+    message_.reset(new Messages::Message(size));
+  }
   message_->setApplicationType(applicationType, applicationTypeNamespace);
   return *this;
 }
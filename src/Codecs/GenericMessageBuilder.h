@@ -13,12 +13,26 @@
 #include <Messages/FieldSet_fwd.h>
 #include <Messages/Sequence_fwd.h>
 #include <Messages/Group_fwd.h>
+#include <Messages/Recycler.h>
 namespace QuickFAST{
   namespace Codecs{
     class GenericSequenceBuilder;
     class GenericGroupBuilder;
     class GenericMessageBuilder;
 
+    /// @brief Recycles messages built by the GenericMessageBuilder
+    typedef Messages::Recycler<Messages::Message> MessageRecycler;
+    /// @brief Smart pointer to a MessageRecycler
+    typedef boost::shared_ptr<MessageRecycler> MessageRecyclerPtr;
+    /// @brief Recycles sequence entries and groups
+    typedef Messages::Recycler<Messages::FieldSet> FieldSetRecycler;
+    /// @brief Smart pointer to a FieldSetRecycler
+    typedef boost::shared_ptr<FieldSetRecycler> FieldSetRecyclerPtr;
+    /// @brief Recycles sequences
+    typedef Messages::Recycler<Messages::Sequence> SequenceRecycler;
+    /// @brief Smart pointer to a SequenceRecycler
+    typedef boost::shared_ptr<SequenceRecycler> SequenceRecyclerPtr;
+
     /// @brief Build a sequence during decoding
     class QuickFAST_Export GenericSequenceBuilder : public Messages::MessageBuilder
     {
@@ -54,6 +68,15 @@ namespace QuickFAST{
       /// @brief start over on a new sequence
       void reset();
 
+      /// @brief Take sequences and their entries from recyclers.
+      ///
+      /// Nested builders use the same recyclers.
+      /// @param fieldSets supplies sequence entries and groups.  Null means allocate them.
+      /// @param sequences supplies sequences.  Null means allocate them.
+      void setRecyclers(
+        const FieldSetRecyclerPtr & fieldSets,
+        const SequenceRecyclerPtr & sequences);
+
       //////////////////////////
       // Implement MessageBuilder
 
@@ -116,6 +139,8 @@ namespace QuickFAST{
       Messages::SequencePtr sequence_;
       boost::scoped_ptr<GenericSequenceBuilder> sequenceBuilder_;
       boost::scoped_ptr<GenericGroupBuilder> groupBuilder_;
+      FieldSetRecyclerPtr fieldSets_;
+      SequenceRecyclerPtr sequences_;
     };
 
     /// @brief Build a Group during decoding
@@ -152,6 +177,15 @@ namespace QuickFAST{
       /// @brief prepare to start over with a new group
       void reset();
 
+      /// @brief Take groups and nested sequences from recyclers.
+      ///
+      /// Nested builders use the same recyclers.
+      /// @param fieldSets supplies groups and sequence entries.  Null means allocate them.
+      /// @param sequences supplies sequences.  Null means allocate them.
+      void setRecyclers(
+        const FieldSetRecyclerPtr & fieldSets,
+        const SequenceRecyclerPtr & sequences);
+
       //////////////////////////
       // Implement MessageBuilder
 
@@ -210,6 +244,8 @@ namespace QuickFAST{
 
       boost::scoped_ptr<GenericSequenceBuilder> sequenceBuilder_;
       boost::scoped_ptr<GenericGroupBuilder> groupBuilder_;
+      FieldSetRecyclerPtr fieldSets_;
+      SequenceRecyclerPtr sequences_;
     };
 
     /// @brief Build a generic message during decoding
@@ -224,6 +260,30 @@ namespace QuickFAST{
       /// @brief Virtual destructor
       virtual ~GenericMessageBuilder();
 
+      /// @brief Reuse messages, sequences, sequence entries and groups.
+      ///
+      /// When recycling is enabled, objects released by the consumer are
+      /// cleared and kept, with their field capacity, for the next message
+      /// rather than being deleted.  Consumers that keep a reference to a
+      /// sequence or group work as before; it is recycled when they release it.
+      /// @param enable true to recycle; false to allocate new objects.
+      /// @param maxFree is the most idle objects of each kind to keep.
+      void setRecycling(bool enable, size_t maxFree = 1024);
+
+      /// @brief Access the message recycler.
+      /// @returns the recycler, or null if recycling is not enabled.
+      const MessageRecyclerPtr & messageRecycler()const
+      {
+        return messages_;
+      }
+
+      /// @brief Access the recycler for sequence entries and groups.
+      /// @returns the recycler, or null if recycling is not enabled.
+      const FieldSetRecyclerPtr & fieldSetRecycler()const
+      {
+        return fieldSets_;
+      }
+
       //////////////////////////
       // Implement MessageBuilder
       virtual const std::string & getApplicationType()const;
@@ -281,6 +341,9 @@ namespace QuickFAST{
       Messages::MessagePtr message_;
       GenericSequenceBuilder sequenceBuilder_;
       GenericGroupBuilder groupBuilder_;
+      MessageRecyclerPtr messages_;
+      FieldSetRecyclerPtr fieldSets_;
+      SequenceRecyclerPtr sequences_;
     };
   }
 }
@@ -0,0 +1,206 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "MessageWorkerPool.h"
+#include <Messages/Message.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+MessageWorkerPool::MessageWorkerPool(
+  MessageConsumer & worker,
+  size_t threadCount,
+  size_t maxQueued)
+: worker_(worker)
+, threadCount_(threadCount == 0 ? 1 : threadCount)
+, maxQueued_(maxQueued == 0 ? 1 : maxQueued)
+, messageCount_(0)
+, stopping_(false)
+, stopped_(false)
+, running_(false)
+{
+}
+
+MessageWorkerPool::~MessageWorkerPool()
+{
+  stopThreads();
+}
+
+void
+MessageWorkerPool::startThreads()
+{
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    stopping_ = false;
+    stopped_ = false;
+    if(running_)
+    {
+      return;
+    }
+    running_ = true;
+  }
+  createThreads();
+}
+
+void
+MessageWorkerPool::createThreads()
+{
+  for(size_t nThread = threads_.size(); nThread < threadCount_; ++nThread)
+  {
+    threads_.push_back(ThreadPtr(new boost::thread(boost::bind(&MessageWorkerPool::run, this))));
+  }
+}
+
+void
+MessageWorkerPool::stopThreads()
+{
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  notEmpty_.notify_all();
+  for(size_t nThread = 0; nThread < threads_.size(); ++nThread)
+  {
+    threads_[nThread]->join();
+  }
+  threads_.clear();
+  boost::mutex::scoped_lock lock(mutex_);
+  running_ = false;
+}
+
+void
+MessageWorkerPool::run()
+{
+  Messages::MessagePtr message;
+  for(;;)
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while(queue_.empty() && !stopping_)
+      {
+        notEmpty_.wait(lock);
+      }
+      if(queue_.empty())
+      {
+        return;
+      }
+      message.swap(queue_.front());
+      queue_.pop_front();
+    }
+    notFull_.notify_one();
+    bool more = true;
+    {
+      // Several workers consume concurrently by design, so only a single
+      // worker is kept apart from the logging and error reporting calls.
+      boost::mutex::scoped_lock workerLock(workerMutex_, boost::defer_lock);
+      if(threadCount_ == 1)
+      {
+        workerLock.lock();
+      }
+      more = worker_.consumeMessage(*message);
+    }
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      if(!more)
+      {
+        stopped_ = true;
+      }
+      // Keep the message and its fields for the decoding thread to reuse and release.
+      if(returned_.size() < maxQueued_ + threadCount_)
+      {
+        returned_.push_back(Messages::MessagePtr());
+        returned_.back().swap(message);
+      }
+    }
+    message.reset();
+  }
+}
+
+bool
+MessageWorkerPool::consumeMessage(Messages::Message & message)
+{
+  // Start the threads if decodingStarted() was not called.  Several decoding
+  // threads may get here at once, so only the one that sets running_ starts them.
+  bool start = false;
+  bool more = true;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if(!running_)
+    {
+      running_ = true;
+      stopping_ = false;
+      stopped_ = false;
+      start = true;
+    }
+    while(queue_.size() >= maxQueued_)
+    {
+      notFull_.wait(lock);
+    }
+    queue_.push_back(Messages::MessagePtr());
+    Messages::MessagePtr & handoff = queue_.back();
+    if(returned_.empty())
+    {
+      handoff.reset(new Messages::Message(1));
+    }
+    else
+    {
+      handoff.swap(returned_.back());
+      returned_.pop_back();
+    }
+    // Take the fields rather than copying them.  The builder releases
+    // the returned message's old fields, in this thread, after this call.
+    handoff->swap(message);
+    ++messageCount_;
+    more = !stopped_;
+  }
+  if(start)
+  {
+    createThreads();
+  }
+  notEmpty_.notify_one();
+  return more;
+}
+
+void
+MessageWorkerPool::decodingStarted()
+{
+  worker_.decodingStarted();
+  startThreads();
+}
+
+void
+MessageWorkerPool::decodingStopped()
+{
+  stopThreads();
+  returned_.clear();
+  worker_.decodingStopped();
+}
+
+bool
+MessageWorkerPool::wantLog(unsigned short level)
+{
+  boost::mutex::scoped_lock lock(workerMutex_);
+  return worker_.wantLog(level);
+}
+
+bool
+MessageWorkerPool::logMessage(unsigned short level, const std::string & logMessage)
+{
+  boost::mutex::scoped_lock lock(workerMutex_);
+  return worker_.logMessage(level, logMessage);
+}
+
+bool
+MessageWorkerPool::reportDecodingError(const std::string & errorMessage)
+{
+  boost::mutex::scoped_lock lock(workerMutex_);
+  return worker_.reportDecodingError(errorMessage);
+}
+
+bool
+MessageWorkerPool::reportCommunicationError(const std::string & errorMessage)
+{
+  boost::mutex::scoped_lock lock(workerMutex_);
+  return worker_.reportCommunicationError(errorMessage);
+}
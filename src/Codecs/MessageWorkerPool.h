@@ -0,0 +1,118 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEWORKERPOOL_H
+#define MESSAGEWORKERPOOL_H
+#include "MessageWorkerPool_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Codecs/MessageConsumer.h>
+#include <Messages/Message_fwd.h>
+#include <deque>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Hand decoded messages to a pool of worker threads.
+    ///
+    /// Use this as the MessageConsumer for a GenericMessageBuilder.  Each decoded
+    /// message is swapped into a Message owned by the pool (the fields are not copied)
+    /// and queued.  Worker threads remove messages from the queue and pass them to
+    /// the worker MessageConsumer.  Any fields the worker keeps are released by
+    /// the worker thread.
+    ///
+    /// When the worker is done with a message the pool keeps it for the next handoff.
+    /// Its old fields are then swapped into the builder's message, so they are released
+    /// by the decoding thread and return to that thread's FieldPool.
+    ///
+    /// With more than one thread the worker's consumeMessage() is called concurrently,
+    /// and messages may be completed out of order.  Use one thread to preserve order.
+    ///
+    /// Several decoding threads may share one pool.  The worker threads are started by
+    /// decodingStarted(), or by the first message if it was not called.  With one worker
+    /// thread the pool merges their messages: each decoder's messages reach the worker in order.
+    /// @see ParallelMulticastDecoder
+    ///
+    /// The decoding thread waits when maxQueued messages are waiting for a worker.
+    ///
+    /// QuickFAST and the application should be built with QUICKFAST_ATOMIC_REFCOUNT
+    /// defined if a field may be referenced from more than one thread at a time, for
+    /// example when the decoding thread keeps a copy of a field it has handed off.
+    ///
+    /// The worker's wantLog(), logMessage() and report...Error() methods are called
+    /// from the decoding threads, one at a time.  With one worker thread they are
+    /// never called while the worker is consuming a message.
+    class QuickFAST_Export MessageWorkerPool : public MessageConsumer
+    {
+    public:
+      /// @brief Construct
+      /// @param worker processes the messages.  It must outlive this pool.
+      /// @param threadCount is the number of worker threads.
+      /// @param maxQueued is the number of messages that may wait for a worker.
+      MessageWorkerPool(
+        MessageConsumer & worker,
+        size_t threadCount = 1,
+        size_t maxQueued = 1024);
+
+      /// @brief Stops the worker threads after the queue has been emptied.
+      virtual ~MessageWorkerPool();
+
+      /// @brief How many messages have been handed to the workers.
+      size_t messageCount()const
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        return messageCount_;
+      }
+
+      ////////////////////////////
+      // Implement MessageConsumer
+      virtual bool consumeMessage(Messages::Message & message);
+      virtual void decodingStarted();
+      virtual void decodingStopped();
+      virtual bool wantLog(unsigned short level);
+      virtual bool logMessage(unsigned short level, const std::string & logMessage);
+      virtual bool reportDecodingError(const std::string & errorMessage);
+      virtual bool reportCommunicationError(const std::string & errorMessage);
+
+    private:
+      void startThreads();
+      /// @brief Create the worker threads.  Called only by the caller that set running_.
+      void createThreads();
+      void stopThreads();
+      void run();
+
+    private:
+      MessageWorkerPool(const MessageWorkerPool &);
+      MessageWorkerPool & operator=(const MessageWorkerPool &);
+
+    private:
+      typedef boost::shared_ptr<boost::thread> ThreadPtr;
+      MessageConsumer & worker_;
+      size_t threadCount_;
+      size_t maxQueued_;
+      std::vector<ThreadPtr> threads_;
+
+      /// Serializes calls to the worker (see the class description)
+      boost::mutex workerMutex_;
+
+      /// Protects the members below
+      mutable boost::mutex mutex_;
+      /// Workers wait for messages
+      boost::condition_variable notEmpty_;
+      /// The decoding thread waits for space in the queue
+      boost::condition_variable notFull_;
+      std::deque<Messages::MessagePtr> queue_;
+      /// Messages the workers are done with, still holding their fields.
+      std::vector<Messages::MessagePtr> returned_;
+      size_t messageCount_;
+      /// No more messages will be queued.
+      bool stopping_;
+      /// The worker asked to stop decoding.
+      bool stopped_;
+      /// The worker threads have been (or are being) started.
+      bool running_;
+    };
+  }
+}
+#endif /* MESSAGEWORKERPOOL_H */
@@ -0,0 +1,20 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef MESSAGEWORKERPOOL_FWD_H
+#define MESSAGEWORKERPOOL_FWD_H
+#ifndef QUICKFAST_HEADERS
+#error Please include <Application/QuickFAST.h> preferably as a precompiled header file.
+#endif //QUICKFAST_HEADERS
+
+namespace QuickFAST{
+  namespace Codecs{
+    class MessageWorkerPool;
+    /// @brief A smart pointer to a MessageWorkerPool.
+    typedef boost::shared_ptr<MessageWorkerPool> MessageWorkerPoolPtr;
+  }
+}
+#endif /* MESSAGEWORKERPOOL_FWD_H */
@@ -39,6 +39,7 @@ PacketSequencingAssembler::PacketSequencingAssembler(
   , gapEnd_(0)
   , recoveryFeed_(recoveryFeed)
   , receiver_(0)
+  , arrivals_(new Arrival[lookAheadCount])
 {
   if(!packetHeaderAnalyzer.supportsSequenceNumber())
   {
@@ -118,13 +119,15 @@ PacketSequencingAssembler::serviceQueue(Communication::Receiver & receiver)
       // lookahead range, promote them to the lookahead array.
       more = promoteDeferred();
     }
-    if(!more && (nextSequenceNumber_ < gapEnd_ || !deferredQueue_.isEmpty()))
+    if(!more && (nextSequenceNumber_ < gapEnd_ || !deferredQueue_.isEmpty() || passedOnAllLines()))
     {
       /////////////////////////////////////////////////////////////////////////////////////////////
       // if the next sequence number is < end of the gap we are filling a previously discovered gap
       // if the deferred queue is not empty after any any available packets have been processed, we
       // have a new gap.
-      // In either case, handle it.
+      // if every line has moved past the next sequence number, no line will fill it so
+      // we have a new gap.
+      // In any case, handle it.
       // Note this may wait until messages arrive on the recovery feed.
       handleGap();
       // and continue trying to process the next buffer
@@ -146,32 +149,145 @@ PacketSequencingAssembler::capturePacket(Communication::LinkedBuffer * buffer)
     first_ = false;
     nextSequenceNumber_ = sequenceNumber;
   }
+  // The buffer may be reused once it is released, so note its line now.
+  bool primary = !buffer->checkAnyFlag(FROM_RECOVERY_QUEUE);
+  size_t line = buffer->source();
   if(sequenceNumber == nextSequenceNumber_)
   {
+    if(primary)
+    {
+      arbitrate(line, sequenceNumber, true);
+    }
     processPacket(buffer);
   }
   else if(sequenceNumber < nextSequenceNumber_)
   {
+    if(primary)
+    {
+      arbitrate(line, sequenceNumber, false);
+    }
     releasePacket(buffer);
   }
   else if(sequenceNumber <  nextSequenceNumber_ + lookAheadCount_)
   {
-    if(lookAhead_[sequenceNumber % lookAheadCount_] != 0)
+    bool first = lookAhead_[sequenceNumber % lookAheadCount_] == 0;
+    if(primary)
     {
-      releasePacket(buffer);
+      arbitrate(line, sequenceNumber, first);
     }
-    else
+    if(first)
     {
       lookAhead_[sequenceNumber % lookAheadCount_] = buffer;
     }
+    else
+    {
+      releasePacket(buffer);
+    }
   }
   else
   {
     /// buffer is beyond look-ahead
-    addToDeferred(buffer, sequenceNumber);
+    bool first = addToDeferred(buffer, sequenceNumber);
+    if(primary)
+    {
+      arbitrate(line, sequenceNumber, first);
+    }
+  }
+}
+
+void
+PacketSequencingAssembler::arbitrate(size_t line, sequence_t sequenceNumber, bool first)
+{
+  if(line >= lines_.size())
+  {
+    lines_.resize(line + 1);
+  }
+  LineStatistics & statistics = lines_[line];
+  if(statistics.packets_ == 0 || sequenceNumber > statistics.highest_)
+  {
+    statistics.highest_ = sequenceNumber;
+  }
+  ++statistics.packets_;
+
+  // Lag is only meaningful (and the clock is only read) once there are two lines.
+  bool timed = lines_.size() > 1;
+  Arrival & arrival = arrivals_[sequenceNumber % lookAheadCount_];
+  if(first)
+  {
+    ++statistics.won_;
+    // Only packets in the look-ahead range have a slot of their own.  A deferred
+    // packet would overwrite the arrival of a packet that is still waiting.
+    if(sequenceNumber < nextSequenceNumber_ + lookAheadCount_)
+    {
+      arrival.sequenceNumber_ = sequenceNumber;
+      arrival.line_ = line;
+      arrival.time_ = timed
+        ? boost::posix_time::microsec_clock::universal_time()
+        : boost::posix_time::ptime();
+    }
+  }
+  else
+  {
+    // a duplicate, or already decoded or skipped as a gap.
+    ++statistics.lost_;
+    if(timed
+      && arrival.sequenceNumber_ == sequenceNumber
+      && arrival.line_ != line
+      && !arrival.time_.is_not_a_date_time())
+    {
+      boost::posix_time::time_duration lag =
+        boost::posix_time::microsec_clock::universal_time() - arrival.time_;
+      ++statistics.lagged_;
+      statistics.totalLag_ += lag;
+      if(lag > statistics.maxLag_)
+      {
+        statistics.maxLag_ = lag;
+      }
+    }
   }
 }
 
+bool
+PacketSequencingAssembler::passedOnAllLines()const
+{
+  if(lines_.size() < 2)
+  {
+    return false;
+  }
+  for(size_t nLine = 0; nLine < lines_.size(); ++nLine)
+  {
+    if(lines_[nLine].packets_ == 0 || lines_[nLine].highest_ <= nextSequenceNumber_)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+PacketSequencingAssembler::receiverStopped(Communication::Receiver & receiver)
+{
+  if(builder_.wantLog(Common::Logger::QF_LOG_INFO))
+  {
+    for(size_t nLine = 0; nLine < lines_.size(); ++nLine)
+    {
+      const LineStatistics & statistics = lines_[nLine];
+      std::stringstream msg;
+      msg << "Line " << nLine
+        << ": packets " << statistics.packets_
+        << " won " << statistics.won_
+        << " lost " << statistics.lost_;
+      if(statistics.lagged_ != 0)
+      {
+        msg << " average lag " << statistics.totalLag_ / int(statistics.lagged_)
+          << " max lag " << statistics.maxLag_;
+      }
+      builder_.logMessage(Common::Logger::QF_LOG_INFO, msg.str());
+    }
+  }
+  BasePacketAssembler::receiverStopped(receiver);
+}
+
 void
 PacketSequencingAssembler::processPacket(Communication::LinkedBuffer * buffer)
 {
@@ -193,7 +309,7 @@ PacketSequencingAssembler::releasePacket(Communication::LinkedBuffer * buffer)
   }
 }
 
-void
+bool
 PacketSequencingAssembler::addToDeferred(Communication::LinkedBuffer * buffer, sequence_t sequenceNumber)
 {
   // check for empty deferred queue
@@ -201,7 +317,7 @@ PacketSequencingAssembler::addToDeferred(Communication::LinkedBuffer * buffer, s
   if(positionInDeferred == 0)
   {
     deferredQueue_.push_front(buffer);
-    return;
+    return true;
   }
 
   /// because it's likely that this goes at the end of the queue, check that before walking the queue.
@@ -209,12 +325,12 @@ PacketSequencingAssembler::addToDeferred(Communication::LinkedBuffer * buffer, s
   if(sequenceNumber == deferredSequenceNumber)
   {
     releasePacket(buffer);
-    return;
+    return false;
   }
   if(sequenceNumber > deferredSequenceNumber)
   {
     deferredQueue_.push(buffer);
-    return;
+    return true;
   }
 
   // the other "easy" case is the buffer comes before everything in the deferred queue
@@ -222,12 +338,12 @@ PacketSequencingAssembler::addToDeferred(Communication::LinkedBuffer * buffer, s
   if(sequenceNumber < deferredSequenceNumber)
   {
     deferredQueue_.push_front(buffer);
-    return;
+    return true;
   }
   if(sequenceNumber == deferredSequenceNumber)
   {
     releasePacket(buffer);
-    return;
+    return false;
   }
 
   // the new packet doesn't belong at either end.
@@ -241,19 +357,20 @@ PacketSequencingAssembler::addToDeferred(Communication::LinkedBuffer * buffer, s
     if(sequenceNumber == deferredSequenceNumber)
     {
       releasePacket(buffer);
-      return;
+      return false;
     }
     if(sequenceNumber < deferredSequenceNumber)
     {
       buffer->link(positionInDeferred->link());
       positionInDeferred->link(buffer);
-      return;
+      return true;
     }
     positionInDeferred = positionInDeferred->link();
   }
   // reached the end of the queue
   // THIS SHOULD NOT HAPPEN 'cause we checked this case above
   deferredQueue_.push(buffer);
+  return true;
 }
 
 bool
@@ -16,10 +16,50 @@ namespace QuickFAST
   {
     /// @brief Service a Receiver's Queue when expecting packet boundaries to match message boundaries (UDP or Multicast)
     /// with (or without) block headers.
+    ///
+    /// Packets are decoded in sequence number order.  When the same data is published on
+    /// several lines (for example the A and B feeds of a MulticastReceiver) the first copy of each
+    /// packet to arrive is decoded and the later copies are discarded.  The line is identified by
+    /// LinkedBuffer::source().
+    ///
+    /// A missing packet is not treated as a gap while another line might still deliver it:
+    /// the gap is declared when every line has delivered a later packet, or when
+    /// packets arrive beyond the look-ahead range.  With a single line only the latter applies.
     class QuickFAST_Export PacketSequencingAssembler
       : public BasePacketAssembler
     {
     public:
+      /// @brief Arbitration statistics for one line.
+      struct LineStatistics
+      {
+        LineStatistics()
+          : packets_(0)
+          , won_(0)
+          , lost_(0)
+          , lagged_(0)
+          , highest_(0)
+        {
+        }
+
+        /// Packets received on this line.
+        size_t packets_;
+        /// Packets for which this line delivered the copy that was decoded.
+        size_t won_;
+        /// Packets that arrived after another copy or too late to be decoded.
+        size_t lost_;
+        /// How many of the lost packets trailed a winning copy from another line.
+        size_t lagged_;
+        /// Total time by which those packets trailed the winning copy.
+        /// Times are taken when the assembler services each packet, not when
+        /// it was received, so they include any queueing delay in the assembler.
+        /// Times are only taken once a second line has delivered a packet.
+        boost::posix_time::time_duration totalLag_;
+        /// Longest time by which one of those packets trailed the winning copy.
+        boost::posix_time::time_duration maxLag_;
+        /// The highest sequence number received on this line.
+        sequence_t highest_;
+      };
+
       /// @brief Constuct the Assembler
       /// @param templateRegistry defines the decoding instructions for the decoder
       /// @param packetHeaderAnalyzer analyzes the header of each packet (if any)
@@ -40,6 +80,25 @@ namespace QuickFAST
       ///////////////////////////////////////
       // Implement Remaining Assembler method
       virtual bool serviceQueue(Communication::Receiver & receiver);
+      virtual void receiverStopped(Communication::Receiver & receiver);
+
+      /// @brief How many lines have delivered packets.
+      ///
+      /// This is one more than the highest LinkedBuffer::source() seen.
+      size_t lineCount()const
+      {
+        return lines_.size();
+      }
+
+      /// @brief Access the arbitration statistics for a line.
+      ///
+      /// The statistics are updated by the thread that services the receiver without
+      /// any locking.  Read them from that thread, or after the receiver has stopped.
+      /// @param line is the LinkedBuffer::source() of the line's packets.
+      const LineStatistics & lineStatistics(size_t line)const
+      {
+        return lines_[line];
+      }
 
     private:
       /// @brief Initial processing of incoming packet from any source.
@@ -49,7 +108,8 @@ namespace QuickFAST
       /// @brief Packet is no longer needed.  Return it to from whence it came.
       void releasePacket(Communication::LinkedBuffer * buffer);
       /// @brief Packet is beyond the look-ahead array.   Hang on to it for later.
-      void addToDeferred(Communication::LinkedBuffer * buffer, sequence_t sequenceNumber);
+      /// @return false if it duplicated a deferred packet and was released.
+      bool addToDeferred(Communication::LinkedBuffer * buffer, sequence_t sequenceNumber);
       /// @brief Promote deferred packets to the look-ahead array if possible.
       /// @return true any were promoted.
       bool promoteDeferred();
@@ -61,6 +121,15 @@ namespace QuickFAST
       /// Either wait for recovery information to arrive, or skip over the gap.
       void handleGap();
 
+      /// @brief Update the arbitration statistics for a packet from a primary line.
+      /// @param line is the LinkedBuffer::source() of the packet.
+      /// @param sequenceNumber identifies the packet.
+      /// @param first is true if this is the first copy of the packet to arrive.
+      void arbitrate(size_t line, sequence_t sequenceNumber, bool first);
+
+      /// @brief Have all of two or more lines delivered packets beyond the next one needed?
+      bool passedOnAllLines()const;
+
     private:
       PacketSequencingAssembler & operator = (const PacketSequencingAssembler &);
       PacketSequencingAssembler(const PacketSequencingAssembler &);
@@ -80,6 +149,17 @@ namespace QuickFAST
 
       Communication::Receiver * receiver_;
 
+      /// @brief The first copy of a packet to arrive.
+      struct Arrival
+      {
+        sequence_t sequenceNumber_;
+        size_t line_;
+        boost::posix_time::ptime time_;
+      };
+      /// First arrivals, indexed by sequence number modulo lookAheadCount_
+      boost::scoped_array<Arrival> arrivals_;
+      std::vector<LineStatistics> lines_;
+
     };
 
   }
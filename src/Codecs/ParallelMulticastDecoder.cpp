@@ -0,0 +1,210 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "ParallelMulticastDecoder.h"
+#include <Codecs/MessageWorkerPool.h>
+#include <Codecs/MessagePerPacketAssembler.h>
+#include <Codecs/GenericMessageBuilder.h>
+#include <Codecs/NoHeaderAnalyzer.h>
+#include <Communication/MulticastReceiver.h>
+#include <Common/ThreadAffinity.h>
+
+using namespace QuickFAST;
+using namespace Codecs;
+
+/// @brief Everything needed to decode one feed.
+struct ParallelMulticastDecoder::Feed
+{
+  Feed(
+    const std::string & multicastGroupIP,
+    const std::string & listenInterfaceIP,
+    const std::string & bindIP,
+    unsigned short portNumber,
+    int cpu)
+    : multicastGroupIP_(multicastGroupIP)
+    , listenInterfaceIP_(listenInterfaceIP)
+    , bindIP_(bindIP)
+    , portNumber_(portNumber)
+    , cpu_(cpu)
+    , receiver_(0)
+  {
+  }
+
+  Feed(Communication::Receiver & receiver, int cpu)
+    : portNumber_(0)
+    , cpu_(cpu)
+    , receiver_(&receiver)
+  {
+  }
+
+  std::string multicastGroupIP_;
+  std::string listenInterfaceIP_;
+  std::string bindIP_;
+  unsigned short portNumber_;
+  int cpu_;
+  /// Either multicastReceiver_ or a Receiver supplied by the application.
+  Communication::Receiver * receiver_;
+
+  // Declaration order matters: the io_service must outlive the receiver's
+  // sockets and the thread must be joined before anything else is destroyed.
+  boost::asio::io_service ioService_;
+  NoHeaderAnalyzer packetHeaderAnalyzer_;
+  NoHeaderAnalyzer messageHeaderAnalyzer_;
+  boost::scoped_ptr<Communication::MulticastReceiver> multicastReceiver_;
+  boost::scoped_ptr<GenericMessageBuilder> builder_;
+  boost::scoped_ptr<MessagePerPacketAssembler> assembler_;
+  boost::scoped_ptr<boost::thread> thread_;
+};
+
+ParallelMulticastDecoder::ParallelMulticastDecoder(TemplateRegistryPtr templateRegistry)
+: templateRegistry_(templateRegistry)
+, maxQueued_(1024)
+, strict_(true)
+, started_(false)
+{
+}
+
+ParallelMulticastDecoder::~ParallelMulticastDecoder()
+{
+  stop();
+  joinThreads();
+}
+
+size_t
+ParallelMulticastDecoder::addFeed(
+  const std::string & multicastGroupIP,
+  const std::string & listenInterfaceIP,
+  const std::string & bindIP,
+  unsigned short portNumber,
+  int cpu)
+{
+  if(started_)
+  {
+    throw UsageError("Coding Error", "ParallelMulticastDecoder: Cannot add a feed after start().");
+  }
+  feeds_.push_back(FeedPtr(new Feed(multicastGroupIP, listenInterfaceIP, bindIP, portNumber, cpu)));
+  return feeds_.size() - 1;
+}
+
+size_t
+ParallelMulticastDecoder::addFeed(
+  Communication::Receiver & receiver,
+  int cpu)
+{
+  if(started_)
+  {
+    throw UsageError("Coding Error", "ParallelMulticastDecoder: Cannot add a feed after start().");
+  }
+  feeds_.push_back(FeedPtr(new Feed(receiver, cpu)));
+  return feeds_.size() - 1;
+}
+
+void
+ParallelMulticastDecoder::start(
+  MessageConsumer & consumer,
+  size_t bufferSize /*=1500*/,
+  size_t bufferCount /*=2*/)
+{
+  merge_.reset(new MessageWorkerPool(consumer, 1, maxQueued_));
+  merge_->decodingStarted();
+  started_ = true;
+  for(size_t nFeed = 0; nFeed < feeds_.size(); ++nFeed)
+  {
+    Feed & feed = *feeds_[nFeed];
+    if(feed.receiver_ == 0 || feed.multicastReceiver_)
+    {
+      feed.multicastReceiver_.reset(new Communication::MulticastReceiver(
+        feed.ioService_,
+        feed.multicastGroupIP_,
+        feed.listenInterfaceIP_,
+        feed.bindIP_,
+        feed.portNumber_));
+      feed.receiver_ = feed.multicastReceiver_.get();
+    }
+    feed.builder_.reset(new GenericMessageBuilder(*merge_));
+    feed.assembler_.reset(new MessagePerPacketAssembler(
+      templateRegistry_,
+      feed.packetHeaderAnalyzer_,
+      feed.messageHeaderAnalyzer_,
+      *feed.builder_));
+    feed.assembler_->setStrict(strict_);
+    feed.receiver_->start(*feed.assembler_, bufferSize, bufferCount);
+  }
+}
+
+void
+ParallelMulticastDecoder::runThreads()
+{
+  for(size_t nFeed = 0; nFeed < feeds_.size(); ++nFeed)
+  {
+    Feed & feed = *feeds_[nFeed];
+    if(feed.assembler_ && !feed.thread_)
+    {
+      feed.thread_.reset(new boost::thread(
+        boost::bind(&ParallelMulticastDecoder::runFeed, this, boost::ref(feed))));
+    }
+  }
+}
+
+void
+ParallelMulticastDecoder::runFeed(Feed & feed)
+{
+  if(feed.cpu_ >= 0 && !pinThreadToCpu(feed.cpu_))
+  {
+    merge_->reportCommunicationError("ParallelMulticastDecoder: Cannot pin feed thread to CPU.");
+  }
+  feed.receiver_->run();
+}
+
+void
+ParallelMulticastDecoder::stop()
+{
+  for(size_t nFeed = 0; nFeed < feeds_.size(); ++nFeed)
+  {
+    if(feeds_[nFeed]->assembler_)
+    {
+      feeds_[nFeed]->receiver_->stop();
+    }
+  }
+}
+
+void
+ParallelMulticastDecoder::joinThreads()
+{
+  for(size_t nFeed = 0; nFeed < feeds_.size(); ++nFeed)
+  {
+    Feed & feed = *feeds_[nFeed];
+    if(feed.thread_)
+    {
+      feed.thread_->join();
+      feed.thread_.reset();
+    }
+  }
+  if(started_)
+  {
+    started_ = false;
+    // delivers the messages that are still queued.
+    merge_->decodingStopped();
+  }
+}
+
+size_t
+ParallelMulticastDecoder::messageCount()const
+{
+  if(merge_)
+  {
+    return merge_->messageCount();
+  }
+  return 0;
+}
+
+const Communication::MulticastReceiver &
+ParallelMulticastDecoder::receiver(size_t index)const
+{
+  if(index >= feeds_.size() || !feeds_[index]->multicastReceiver_)
+  {
+    throw UsageError("Coding Error", "ParallelMulticastDecoder: No multicast receiver for feed.");
+  }
+  return *feeds_[index]->multicastReceiver_;
+}
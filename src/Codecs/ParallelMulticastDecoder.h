@@ -0,0 +1,143 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef PARALLELMULTICASTDECODER_H
+#define PARALLELMULTICASTDECODER_H
+#include "ParallelMulticastDecoder_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/MessageConsumer_fwd.h>
+#include <Codecs/MessageWorkerPool_fwd.h>
+#include <Communication/MulticastReceiver_fwd.h>
+#include <Communication/Receiver_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs {
+    /// @brief Decode several multicast feeds in parallel.
+    ///
+    /// Each feed gets its own MulticastReceiver and io_service, its own
+    /// MessagePerPacketAssembler (hence its own Decoder and dictionaries), its own
+    /// GenericMessageBuilder, and its own thread, which may be pinned to a CPU.
+    /// Use this when the feeds' dictionaries are independent.  When they must share
+    /// dictionaries, use one MulticastReceiver with several feeds (see MulticastReceiver::addFeed()).
+    ///
+    /// The decoded messages are merged by a MessageWorkerPool with one thread,
+    /// so the consumer is called from one thread at a time and each feed's messages
+    /// arrive in the order in which they were decoded.  Messages from different feeds
+    /// are interleaved in the order the feeds finished decoding them.  The consumer's
+    /// logging and error reporting methods are called from the feed threads, but
+    /// never while another of its methods is running.
+    ///
+    /// A feed may also read from any other Receiver, for example a RawFileReceiver
+    /// replaying a capture of the multicast data.
+    ///
+    /// The feeds have no packet or message headers.
+    /// @see MulticastDecoder
+    class QuickFAST_Export ParallelMulticastDecoder
+    {
+    public:
+      /// @brief Construct.
+      /// @param templateRegistry the templates to use for decoding.  Shared by all feeds.
+      explicit ParallelMulticastDecoder(TemplateRegistryPtr templateRegistry);
+
+      /// @brief Stops and joins the feed threads if necessary.
+      ~ParallelMulticastDecoder();
+
+      /// @brief Add a feed.  Call before start().
+      /// @param multicastGroupIP multicast address as a text string
+      /// @param listenInterfaceIP listen address as a text string
+      /// @param bindIP bind address as a text string
+      /// @param portNumber port number
+      /// @param cpu is the CPU to which this feed's thread is pinned.  Negative means do not pin.
+      /// @returns the index of the feed.
+      size_t addFeed(
+        const std::string & multicastGroupIP,
+        const std::string & listenInterfaceIP,
+        const std::string & bindIP,
+        unsigned short portNumber,
+        int cpu = -1);
+
+      /// @brief Add a feed that reads from an existing Receiver.  Call before start().
+      /// @param receiver supplies the packets.  It must outlive this decoder.
+      /// @param cpu is the CPU to which this feed's thread is pinned.  Negative means do not pin.
+      /// @returns the index of the feed.
+      size_t addFeed(
+        Communication::Receiver & receiver,
+        int cpu = -1);
+
+      /// @brief How many feeds have been added.
+      size_t feedCount()const
+      {
+        return feeds_.size();
+      }
+
+      /// @brief Enable/disable strict checking of conformance to the FAST standard.
+      ///
+      /// Call before start().
+      /// @param strict true to enable; false to disable strict checking
+      void setStrict(bool strict)
+      {
+        strict_ = strict;
+      }
+
+      /// @brief How many decoded messages may wait for the consumer.
+      ///
+      /// A feed's thread waits when the merge queue is full.  Call before start().
+      /// @param maxQueued is the maximum number of waiting messages.
+      void setMergeQueueSize(size_t maxQueued)
+      {
+        maxQueued_ = maxQueued;
+      }
+
+      /// @brief Prepare to decode.  Returns immediately.
+      ///
+      /// Calls consumer.decodingStarted().
+      /// @param consumer receives the merged messages from all feeds.  It must outlive the decoding.
+      /// @param bufferSize should be >= the largest expected packet
+      /// @param bufferCount is how many buffers to allocate per feed (minimum 2 suggested)
+      void start(MessageConsumer & consumer, size_t bufferSize = 1500, size_t bufferCount = 2);
+
+      /// @brief Start one thread per feed.  Returns immediately.
+      void runThreads();
+
+      /// @brief Stop all feeds.
+      ///
+      /// Returns immediately.  Use joinThreads() to wait for the feeds to finish.
+      void stop();
+
+      /// @brief Wait for the feed threads to finish after stop().
+      ///
+      /// Messages already decoded are delivered, then consumer.decodingStopped() is called.
+      void joinThreads();
+
+      /// @brief How many messages have been decoded by all feeds.
+      size_t messageCount()const;
+
+      /// @brief Access the multicast receiver for a feed (valid after start()).
+      /// @param index identifies the feed as returned by addFeed()
+      /// @throws UsageError if the feed was added with its own Receiver.
+      const Communication::MulticastReceiver & receiver(size_t index)const;
+
+    private:
+      ParallelMulticastDecoder(const ParallelMulticastDecoder &);
+      ParallelMulticastDecoder & operator=(const ParallelMulticastDecoder &);
+
+    private:
+      struct Feed;
+      typedef boost::shared_ptr<Feed> FeedPtr;
+      void runFeed(Feed & feed);
+
+    private:
+      TemplateRegistryPtr templateRegistry_;
+      std::vector<FeedPtr> feeds_;
+      boost::scoped_ptr<MessageWorkerPool> merge_;
+      size_t maxQueued_;
+      bool strict_;
+      bool started_;
+    };
+  }
+}
+#endif // PARALLELMULTICASTDECODER_H
@@ -0,0 +1,209 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "PositionedAccessor.h"
+#include <Codecs/SegmentBody.h>
+#include <Messages/FieldSet.h>
+#include <Messages/Group.h>
+#include <Messages/Sequence.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+const size_t PositionedAccessor::NO_FIELD;
+
+PositionedAccessor::PositionedAccessor(
+  const Messages::FieldSet & fields,
+  const SegmentBody & segment,
+  std::vector<size_t> & index)
+  : fields_(fields)
+  , identities_(segment.getFieldIdentities())
+  , positionBase_(segment.getPositionBase())
+  , index_(index)
+{
+  index.assign(identities_.size(), NO_FIELD);
+  Messages::FieldSet::const_iterator field = fields.begin();
+  for(size_t nIdentity = 0; nIdentity < identities_.size() && field != fields.end(); ++nIdentity)
+  {
+    if(field->getIdentity() == *identities_[nIdentity])
+    {
+      index[nIdentity] = field - fields.begin();
+      ++field;
+    }
+  }
+}
+
+PositionedAccessor::~PositionedAccessor()
+{
+}
+
+const Messages::MessageField *
+PositionedAccessor::indexedField(const Messages::FieldIdentity & identity)const
+{
+  // Only the segment's own identities are indexed.  They have positions
+  // positionBase_ + n, and were matched against the fields by the constructor.
+  size_t nIdentity = identity.position() - positionBase_;
+  if(nIdentity < identities_.size() && identities_[nIdentity] == &identity)
+  {
+    size_t nField = index_[nIdentity];
+    if(nField != NO_FIELD)
+    {
+      return fields_.begin() + nField;
+    }
+  }
+  return 0;
+}
+
+bool
+PositionedAccessor::isPresent(const Messages::FieldIdentity & identity)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.isPresent(identity);
+  }
+  return field->getField()->isDefined();
+}
+
+bool
+PositionedAccessor::getUnsignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, uint64 & value)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getUnsignedInteger(identity, type, value);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    value = field->getField()->toUnsignedInteger();
+  }
+  return result;
+}
+
+bool
+PositionedAccessor::getSignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, int64 & value)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getSignedInteger(identity, type, value);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    value = field->getField()->toSignedInteger();
+  }
+  return result;
+}
+
+bool
+PositionedAccessor::getDecimal(const Messages::FieldIdentity & identity, ValueType::Type type, Decimal & value)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getDecimal(identity, type, value);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    value = field->getField()->toDecimal();
+  }
+  return result;
+}
+
+bool
+PositionedAccessor::getString(const Messages::FieldIdentity & identity, ValueType::Type type, const StringBuffer *& value)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getString(identity, type, value);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    value = & field->getField()->toString();
+  }
+  return result;
+}
+
+bool
+PositionedAccessor::getGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor *& group)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getGroup(identity, group);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    group = field->getField()->toGroup().get();
+  }
+  return result;
+}
+
+void
+PositionedAccessor::endGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor * group)const
+{
+  fields_.endGroup(identity, group);
+}
+
+bool
+PositionedAccessor::getSequenceLength(const Messages::FieldIdentity & identity, size_t & length)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getSequenceLength(identity, length);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    length = field->getField()->toSequence()->size();
+  }
+  return result;
+}
+
+bool
+PositionedAccessor::getSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor *& entry)const
+{
+  const Messages::MessageField * field = indexedField(identity);
+  if(field == 0)
+  {
+    return fields_.getSequenceEntry(identity, index, entry);
+  }
+  bool result = field->getField()->isDefined();
+  if(result)
+  {
+    entry = (*field->getField()->toSequence())[index].get();
+  }
+  return result;
+}
+
+void
+PositionedAccessor::endSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor * entry)const
+{
+  fields_.endSequenceEntry(identity, index, entry);
+}
+
+void
+PositionedAccessor::endSequence(const Messages::FieldIdentity & identity)const
+{
+  fields_.endSequence(identity);
+}
+
+const std::string &
+PositionedAccessor::getApplicationType()const
+{
+  return fields_.getApplicationType();
+}
+
+const std::string &
+PositionedAccessor::getApplicationTypeNs()const
+{
+  return fields_.getApplicationTypeNs();
+}
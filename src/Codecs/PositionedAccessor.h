@@ -0,0 +1,81 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef POSITIONEDACCESSOR_H
+#define POSITIONEDACCESSOR_H
+#include <Common/QuickFAST_Export.h>
+#include <Messages/MessageAccessor.h>
+#include <Messages/FieldSet_fwd.h>
+#include <Codecs/SegmentBody_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Find the fields of a FieldSet by template position while a segment is encoded.
+    ///
+    /// The Encoder wraps a FieldSet in a PositionedAccessor before it encodes a segment
+    /// from it.  The constructor walks the segment's field identities and the fields of
+    /// the set in step.  Each field that matches the next identity is recorded in an index
+    /// supplied by the Encoder, so a lookup by that identity takes constant time even if the
+    /// fields were added using identities that are not positioned (i.e. built by the application.)
+    /// Identities with no matching field are assumed to be absent optional fields.
+    /// Fields that are out of template order are found by the FieldSet's own search.
+    ///
+    /// The FieldSet itself is not modified, so a message may be encoded by more than
+    /// one thread at a time.
+    class QuickFAST_Export PositionedAccessor
+      : public Messages::MessageAccessor
+    {
+    public:
+      /// @brief An index entry for a position with no matching field.
+      static const size_t NO_FIELD = size_t(-1);
+
+      /// @brief Index the fields of a set for the instructions of a segment.
+      /// @param fields are the fields to be encoded.
+      /// @param segment is the finalized segment that will encode them.
+      /// @param index holds the FieldSet index for each instruction.
+      ///        It is owned by the caller and reused from message to message.
+      PositionedAccessor(
+        const Messages::FieldSet & fields,
+        const SegmentBody & segment,
+        std::vector<size_t> & index);
+
+      virtual ~PositionedAccessor();
+
+      ////////////////////////////
+      // Implement MessageAccessor
+      virtual bool isPresent(const Messages::FieldIdentity & identity)const;
+      virtual bool getUnsignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, uint64 & value)const;
+      virtual bool getSignedInteger(const Messages::FieldIdentity & identity, ValueType::Type type, int64 & value)const;
+      virtual bool getDecimal(const Messages::FieldIdentity & identity, ValueType::Type type, Decimal & value)const;
+      virtual bool getString(const Messages::FieldIdentity & identity, ValueType::Type type, const StringBuffer *& value)const;
+      virtual bool getGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor *& group)const;
+      virtual void endGroup(const Messages::FieldIdentity & identity, const Messages::MessageAccessor * group)const;
+      virtual bool getSequenceLength(const Messages::FieldIdentity & identity, size_t & length)const;
+      virtual bool getSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor *& entry)const;
+      virtual void endSequenceEntry(const Messages::FieldIdentity & identity, size_t index, const Messages::MessageAccessor * entry)const;
+      virtual void endSequence(const Messages::FieldIdentity & identity)const;
+      virtual const std::string & getApplicationType()const;
+      virtual const std::string & getApplicationTypeNs()const;
+
+    private:
+      /// @brief Find a field by its index entry.
+      /// @returns the field, or null if the index does not locate it.
+      const Messages::MessageField * indexedField(const Messages::FieldIdentity & identity)const;
+
+    private:
+      PositionedAccessor();
+      PositionedAccessor(const PositionedAccessor &);
+      PositionedAccessor & operator = (const PositionedAccessor &);
+
+    private:
+      const Messages::FieldSet & fields_;
+      const std::vector<const Messages::FieldIdentity *> & identities_;
+      size_t positionBase_;
+      const std::vector<size_t> & index_;
+    };
+  }
+}
+#endif // POSITIONEDACCESSOR_H
@@ -31,7 +31,7 @@ PresenceMap::PresenceMap(size_t bits)
   , bits_(&internalBuffer_[0])
   , vout_(0)
 {
-  size_t bytesNeeded = (bits + 6)/7;
+  size_t bytesNeeded = maxEncodedSize(bits);
   if(bytesNeeded > byteCapacity_)
   {
     byteCapacity_ = bytesNeeded;
@@ -139,11 +139,8 @@ PresenceMap::encode(DataDestination & destination)
     bpos--;
   }
   bits_[bpos] |= stopBit;
-  for(size_t pos = 0; pos <= bpos; ++pos)
-  {
-    destination.putByte(bits_[pos]);
-  }
-  if(vout_)
+  destination.putBytes(bits_, bpos + 1);
+  if(QUICKFAST_DIAGNOSTICS && vout_)
   {
     (*vout_) << "pmap["  <<  bpos << "]->" << std::hex;
     for(size_t pos = 0; pos <= bpos; ++pos)
@@ -169,23 +166,36 @@ PresenceMap::decode(Codecs::DataSource & source)
 {
   reset();
 
-  uchar byte = 0;
-  if(!source.getByte(byte))
+  size_t pos = 0;
+  const uchar * data = 0;
+  size_t length = 0;
+  if(source.findStopBit(data, length))
   {
-    throw EncodingError("[ERR U03] EOF while decoding presence map.");
+    for(size_t index = 0; index < length; ++index)
+    {
+      appendByte(pos, data[index]);
+    }
+    source.skipContiguous(length);
   }
-  size_t pos = 0;
-  while((byte & stopBit) == 0)
+  else
   {
-    appendByte(pos, byte);
+    uchar byte = 0;
     if(!source.getByte(byte))
     {
       throw EncodingError("[ERR U03] EOF while decoding presence map.");
     }
+    while((byte & stopBit) == 0)
+    {
+      appendByte(pos, byte);
+      if(!source.getByte(byte))
+      {
+        throw EncodingError("[ERR U03] EOF while decoding presence map.");
+      }
+    }
+    appendByte(pos, byte);
   }
-  appendByte(pos, byte);
 
-  if(vout_)
+  if(QUICKFAST_DIAGNOSTICS && vout_)
   {
     (*vout_) << "pmap["  <<  byteCapacity_ << "]<-" << std::hex;
     for(size_t iter = 0; iter < pos; ++iter)
@@ -237,14 +247,11 @@ PresenceMap::reset(size_t bitCount)
       externalBuffer_.reset(new uchar[bytes]);
       bits_ = externalBuffer_.get();
       byteCapacity_ = bytes;
-      bytePosition_ = bytes;
     }
   }
-  bits_[0] = 0;
-  if(bytePosition_ != 0)
-  {
-    memset(bits_ + 1, 0, byteCapacity_ - 1);
-  }
+  // Clear the whole map.  A reused map may hold bits beyond the current position
+  // from a longer map decoded earlier.
+  memset(bits_, 0, byteCapacity_);
   rewind();
 
 }
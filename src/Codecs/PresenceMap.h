@@ -9,6 +9,8 @@
 #include "PresenceMap_fwd.h"
 #include <Common/QuickFAST_Export.h>
 #include <Common/Types.h>
+#include <Common/Diagnostics.h>
+#include <Common/Exceptions.h>
 #include <Codecs/DataSource_fwd.h>
 #include <Codecs/DataDestination_fwd.h>
 namespace QuickFAST{
@@ -42,6 +44,13 @@ namespace QuickFAST{
       void decode(const unsigned char * buffer, size_t &pos);
 
 
+      /// @brief The most bytes needed to encode a presence map with bitCount bits.
+      /// @param bitCount how many fields can be represented in the presence map.
+      static size_t maxEncodedSize(size_t bitCount)
+      {
+        return (bitCount + 6) / 7;
+      }
+
       /// @brief Return the number of bytes needed to encode this PMAP
       ///
       /// Zero means no pmap bits were used.
@@ -97,8 +106,13 @@ namespace QuickFAST{
 
       /// @brief Provide an ostream to which verbose output can be written for debug/analysis
       /// @param vout is the address of the output stream (zero disables verbosity)
+      /// @throws UsageError if vout is not zero and QuickFAST was built with QUICKFAST_NO_DIAGNOSTICS
       void setVerbose(std::ostream * vout)
       {
+        if(!QUICKFAST_DIAGNOSTICS && vout != 0)
+        {
+          throw UsageError("Coding Error", "Verbose output is not available: QuickFAST was built with QUICKFAST_NO_DIAGNOSTICS.");
+        }
         vout_ = vout;
       }
 
@@ -144,7 +158,7 @@ namespace QuickFAST{
       {
         bits_[bytePosition_] &= ~bitMask_;
       }
-      if(vout_)
+      if(QUICKFAST_DIAGNOSTICS && vout_)
       {
         verboseSetNext(present);
       }
@@ -162,11 +176,11 @@ namespace QuickFAST{
     {
       if(bytePosition_ >= byteCapacity_)
       {
-        if(vout_)(*vout_) << "pmap:at end [" << bytePosition_ << "]" << std::endl;
+        if(QUICKFAST_DIAGNOSTICS && vout_)(*vout_) << "pmap:at end [" << bytePosition_ << "]" << std::endl;
         return false;
       }
       bool result = (bits_[bytePosition_] & bitMask_) != 0;
-      if(vout_)
+      if(QUICKFAST_DIAGNOSTICS && vout_)
       {
         verboseCheckNextField(result);
       }
@@ -191,7 +205,7 @@ namespace QuickFAST{
       size_t bitNum = bit % 7;
       unsigned char bitmask = startByteMask >> bitNum;
       bool result = ((bits_[byte] & bitmask) != 0);
-      if(vout_)
+      if(QUICKFAST_DIAGNOSTICS && vout_)
       {
         verboseCheckSpecificField(bit, byte, bitmask, result);
       }
@@ -12,6 +12,8 @@ SegmentBody::SegmentBody(size_t pmapBits)
 : isFinalizing_(false)
 , isFinalized_(false)
 , presenceMapBits_(pmapBits)
+, positionBase_(0)
+, positionLimit_(0)
 , initialPresenceMapBits_(pmapBits)
 , allowLengthField_(false)
 , mandatoryLength_(true)
@@ -86,6 +88,21 @@ SegmentBody::finalize(TemplateRegistry & templateRegistry)
       fieldCount_ += instructions_[pos]->fieldCount(*this);
     }
   }
+
+  // Fields merged from groups and static templateRefs share this segment's
+  // FieldSet, so number this segment's fields after theirs.
+  positionBase_ = 0;
+  for (size_t pos = 0; pos < instructions_.size(); ++pos)
+  {
+    positionBase_ = std::max(positionBase_, instructions_[pos]->mergedPositionLimit(*this));
+  }
+  positionLimit_ = positionBase_ + instructions_.size();
+  fieldIdentities_.clear();
+  for (size_t pos = 0; pos < instructions_.size(); ++pos)
+  {
+    mutableInstructions_[pos]->setPosition(positionBase_ + pos);
+    fieldIdentities_.push_back(&instructions_[pos]->getIdentity());
+  }
   isFinalizing_ = false;
   isFinalized_ = true;
 }
@@ -208,6 +225,8 @@ SegmentBody::indexDictionaries(
   {
     (*it)->indexDictionaries(indexer, name, type, typeNs);
   }
+  // Dictionary indexes are now known, so the decoding plan can be built.
+  decodePlan_.compile(*this);
 }
 
 void
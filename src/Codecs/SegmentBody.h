@@ -9,6 +9,8 @@
 #include "SegmentBody_fwd.h"
 #include <Codecs/FieldInstruction_fwd.h>
 #include <Codecs/DictionaryIndexer_fwd.h>
+#include <Codecs/DecodePlan.h>
+#include <Messages/FieldIdentity_fwd.h>
 #include <Codecs/SchemaElement.h>
 #include <Common/QuickFAST_Export.h>
 
@@ -141,6 +143,42 @@ namespace QuickFAST{
         const std::string & typeName,
         const std::string & typeNamespace);
 
+      /// @brief Access the precompiled decoding plan for this segment.
+      ///
+      /// The plan is compiled when dictionaries are indexed during TemplateRegistry::finalize().
+      /// @returns the plan.  Check DecodePlan::isCompiled() before using it.
+      const DecodePlan & getDecodePlan()const
+      {
+        return decodePlan_;
+      }
+
+      /// @brief Access the identities of the fields in this segment in instruction order.
+      ///
+      /// A PositionedAccessor matches these with the fields of a FieldSet that was built
+      /// in template order so the Encoder can find each field without searching.
+      /// Valid after finalize().
+      const std::vector<const Messages::FieldIdentity *> & getFieldIdentities()const
+      {
+        return fieldIdentities_;
+      }
+
+      /// @brief The position of the first instruction in this segment.
+      ///
+      /// Instruction n has position getPositionBase() + n.  The base is past the
+      /// positions of any group or static templateRef merged into this segment so
+      /// the fields in a FieldSet have different positions.
+      /// Valid after finalize().
+      size_t getPositionBase()const
+      {
+        return positionBase_;
+      }
+
+      /// @brief One past the highest position used by this segment or the segments merged into it.
+      size_t getPositionLimit()const
+      {
+        return positionLimit_;
+      }
+
       /// @brief Write the contents of the segment in human readable form.
       ///
       /// @param output is the stream to which the display will be written
@@ -166,6 +204,10 @@ namespace QuickFAST{
       size_t presenceMapBits_;
       /// @brief How many fields will be Xcoded by this segment
       size_t fieldCount_;
+      /// @brief the position of the first instruction
+      size_t positionBase_;
+      /// @brief one past the highest position used by this segment and merged segments
+      size_t positionLimit_;
       /// @brief the number of presence map bits before any fields are added.
       size_t initialPresenceMapBits_;
       /// @brief the container type for instructions
@@ -182,6 +224,10 @@ namespace QuickFAST{
       bool mandatoryLength_;
       /// @brief the field instruction for sequence length if this is the body of a sequence
       FieldInstructionPtr lengthInstruction_;
+      /// @brief the precompiled decoding plan for this segment
+      DecodePlan decodePlan_;
+      /// @brief the identities of the instructions indexed by position
+      std::vector<const Messages::FieldIdentity *> fieldIdentities_;
     };
   }
 }
@@ -0,0 +1,550 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "TemplateCodeGenerator.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldOp.h>
+#include <Codecs/Context.h>
+#include <Common/Exceptions.h>
+#include <set>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Codecs;
+
+namespace
+{
+  const char * const support = "QuickFAST::Codecs::GeneratedDecoderSupport";
+
+  bool isSignedType(ValueType::Type type)
+  {
+    return type == ValueType::INT32 || type == ValueType::INT64;
+  }
+
+  std::string uniqueName(const std::string & candidate, std::set<std::string> & used)
+  {
+    std::string result = candidate;
+    size_t suffix = 1;
+    while(used.find(result) != used.end())
+    {
+      result = candidate + "_" + boost::lexical_cast<std::string>(++suffix);
+    }
+    used.insert(result);
+    return result;
+  }
+}
+
+TemplateCodeGenerator::TemplateCodeGenerator(
+  TemplateRegistryCPtr registry,
+  const std::string & nameSpace)
+: registry_(registry)
+, nameSpace_(nameSpace)
+, headerName_("GeneratedDecoder.h")
+, analyzed_(false)
+{
+  if(nameSpace_.empty())
+  {
+    throw UsageError("Coding Error", "Generated code requires a namespace.");
+  }
+}
+
+std::string
+TemplateCodeGenerator::identifier(const std::string & name)
+{
+  std::string result;
+  for(size_t pos = 0; pos < name.size(); ++pos)
+  {
+    char c = name[pos];
+    if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+    {
+      result += c;
+    }
+    else
+    {
+      result += '_';
+    }
+  }
+  if(result.empty() || (result[0] >= '0' && result[0] <= '9'))
+  {
+    result = "f_" + result;
+  }
+  return result;
+}
+
+std::string
+TemplateCodeGenerator::integerLiteral(
+  const std::string & cppType,
+  bool isSigned,
+  const std::string & value)
+{
+  std::string literal = "0";
+  if(!value.empty())
+  {
+    // validate the value while converting it to canonical form.
+    if(isSigned)
+    {
+      literal = boost::lexical_cast<std::string>(boost::lexical_cast<int64>(value)) + "LL";
+    }
+    else
+    {
+      literal = boost::lexical_cast<std::string>(boost::lexical_cast<uint64>(value)) + "ULL";
+    }
+  }
+  return cppType + "(" + literal + ")";
+}
+
+std::string
+TemplateCodeGenerator::stringLiteral(const std::string & value)
+{
+  std::ostringstream literal;
+  literal << '"';
+  for(size_t pos = 0; pos < value.size(); ++pos)
+  {
+    unsigned char c = static_cast<unsigned char>(value[pos]);
+    if(c == '"' || c == '\\')
+    {
+      literal << '\\' << c;
+    }
+    else if(c < ' ' || c > '~')
+    {
+      // octal escapes can't be confused with a following digit if they are always three digits long
+      literal << '\\' << std::oct << std::setw(3) << std::setfill('0') << unsigned(c) << std::dec;
+    }
+    else
+    {
+      literal << c;
+    }
+  }
+  literal << '"';
+  return literal.str();
+}
+
+void
+TemplateCodeGenerator::analyze()
+{
+  if(analyzed_)
+  {
+    return;
+  }
+  analyzed_ = true;
+  std::set<std::string> usedStructNames;
+  usedStructNames.insert("MessageHandler");
+  usedStructNames.insert("Decoder");
+  usedStructNames.insert("decode");
+
+  for(TemplateRegistry::const_iterator it = registry_->begin();
+    it != registry_->end();
+    ++it)
+  {
+    const TemplateCPtr & templ = it->second;
+    GeneratedTemplate generated;
+    generated.templ = templ;
+    std::set<std::string> usedMembers;
+    usedMembers.insert("templateId");
+    std::string reason;
+    bool ok = true;
+    for(size_t pos = 0; ok && pos < templ->size(); ++pos)
+    {
+      GeneratedField field;
+      ok = analyzeField(templ->getInstruction(pos), field, reason);
+      if(ok)
+      {
+        field.member = uniqueName(identifier(field.instruction->getName()), usedMembers);
+        generated.fields.push_back(field);
+      }
+    }
+    if(ok)
+    {
+      generated.structName = uniqueName(identifier(templ->getTemplateName()), usedStructNames);
+      templates_.push_back(generated);
+    }
+    else
+    {
+      skipped_.push_back(
+        templ->getTemplateName() + " (id " + boost::lexical_cast<std::string>(templ->getId()) + "): " + reason);
+    }
+  }
+}
+
+bool
+TemplateCodeGenerator::analyzeField(
+  const FieldInstructionCPtr & instruction,
+  GeneratedField & field,
+  std::string & reason)const
+{
+  field.instruction = instruction;
+  FieldOpCPtr fieldOp = instruction->getFieldOp();
+  FieldOp::OpType opType = fieldOp->opType();
+  ValueType::Type type = instruction->fieldInstructionType();
+  if(fieldOp->hasPMapBit())
+  {
+    reason = "explicit pmap bit on field " + instruction->getName();
+    return false;
+  }
+  switch(type)
+  {
+  case ValueType::UINT32:
+  case ValueType::INT32:
+  case ValueType::UINT64:
+  case ValueType::INT64:
+    {
+      field.cppType = std::string("QuickFAST::") + (isSignedType(type) ? "" : "u") +
+        ((type == ValueType::UINT32 || type == ValueType::INT32) ? "int32" : "int64");
+      if(opType == FieldOp::TAIL || opType == FieldOp::UNKNOWN)
+      {
+        reason = "unsupported operator on integer field " + instruction->getName();
+        return false;
+      }
+      return true;
+    }
+  case ValueType::ASCII:
+    {
+      field.cppType = "std::string";
+      if(opType == FieldOp::NOP || opType == FieldOp::CONSTANT ||
+        opType == FieldOp::DEFAULT || opType == FieldOp::COPY)
+      {
+        return true;
+      }
+      reason = "unsupported operator on string field " + instruction->getName();
+      return false;
+    }
+  case ValueType::DECIMAL:
+    {
+      field.cppType = "QuickFAST::Decimal";
+      const FieldInstructionDecimal * decimal =
+        dynamic_cast<const FieldInstructionDecimal *>(instruction.get());
+      FieldInstructionCPtr exponent;
+      if(opType == FieldOp::NOP && decimal != 0 && !decimal->getExponentInstruction(exponent))
+      {
+        return true;
+      }
+      reason = "unsupported operator on decimal field " + instruction->getName();
+      return false;
+    }
+  default:
+    break;
+  }
+  reason = "unsupported field type " + ValueType::typeName(type) + " for field " + instruction->getName();
+  return false;
+}
+
+void
+TemplateCodeGenerator::openNamespace(std::ostream & out)const
+{
+  std::string remaining = nameSpace_;
+  size_t pos;
+  while((pos = remaining.find("::")) != std::string::npos)
+  {
+    out << "namespace " << remaining.substr(0, pos) << "{" << std::endl;
+    remaining = remaining.substr(pos + 2);
+  }
+  out << "namespace " << remaining << "{" << std::endl;
+}
+
+void
+TemplateCodeGenerator::closeNamespace(std::ostream & out)const
+{
+  std::string remaining = nameSpace_;
+  size_t pos;
+  while((pos = remaining.find("::")) != std::string::npos)
+  {
+    out << "}";
+    remaining = remaining.substr(pos + 2);
+  }
+  out << "}" << std::endl;
+}
+
+void
+TemplateCodeGenerator::generateHeader(std::ostream & out)
+{
+  analyze();
+  std::string guard = identifier(nameSpace_ + "_" + headerName_);
+  for(size_t pos = 0; pos < guard.size(); ++pos)
+  {
+    guard[pos] = static_cast<char>(toupper(guard[pos]));
+  }
+
+  out << "// Generated by the QuickFAST template code generator.  Do not edit." << std::endl;
+  for(size_t nSkip = 0; nSkip < skipped_.size(); ++nSkip)
+  {
+    out << "// Skipped template " << skipped_[nSkip] << std::endl;
+  }
+  out << "#ifndef " << guard << std::endl;
+  out << "#define " << guard << std::endl;
+  out << "#include <Codecs/Context.h>" << std::endl;
+  out << "#include <Codecs/DataSource_fwd.h>" << std::endl;
+  out << "#include <Codecs/PresenceMap_fwd.h>" << std::endl;
+  out << "#include <Common/Decimal.h>" << std::endl;
+  out << std::endl;
+  openNamespace(out);
+
+  for(size_t nTempl = 0; nTempl < templates_.size(); ++nTempl)
+  {
+    const GeneratedTemplate & generated = templates_[nTempl];
+    out << "  /// @brief Decoded contents of template " << generated.templ->getTemplateName() << std::endl;
+    out << "  struct " << generated.structName << std::endl;
+    out << "  {" << std::endl;
+    out << "    /// The FAST template ID" << std::endl;
+    out << "    static const QuickFAST::template_id_t templateId = " << generated.templ->getId() << ";" << std::endl;
+    for(size_t nField = 0; nField < generated.fields.size(); ++nField)
+    {
+      const GeneratedField & field = generated.fields[nField];
+      out << "    /// Field " << field.instruction->getName() << std::endl;
+      out << "    " << field.cppType << " " << field.member << ";" << std::endl;
+      if(!field.instruction->isMandatory())
+      {
+        out << "    /// true if " << field.member << " is present" << std::endl;
+        out << "    bool " << field.member << "Present;" << std::endl;
+      }
+    }
+    out << "  };" << std::endl;
+    out << std::endl;
+    out << "  /// @brief Decode the fields of template " << generated.templ->getTemplateName() << std::endl;
+    out << "  void decode(" << std::endl;
+    out << "    QuickFAST::Codecs::DataSource & source," << std::endl;
+    out << "    QuickFAST::Codecs::PresenceMap & pmap," << std::endl;
+    out << "    QuickFAST::Codecs::Context & context," << std::endl;
+    out << "    " << generated.structName << " & message);" << std::endl;
+    out << std::endl;
+  }
+
+  out << "  /// @brief Receive decoded messages.  Override the handle() methods of interest." << std::endl;
+  out << "  class MessageHandler" << std::endl;
+  out << "  {" << std::endl;
+  out << "  public:" << std::endl;
+  out << "    virtual ~MessageHandler(){}" << std::endl;
+  for(size_t nTempl = 0; nTempl < templates_.size(); ++nTempl)
+  {
+    out << "    /// @brief Handle a decoded " << templates_[nTempl].structName << std::endl;
+    out << "    virtual void handle(const " << templates_[nTempl].structName << " & /*message*/){}" << std::endl;
+  }
+  out << "  };" << std::endl;
+  out << std::endl;
+  out << "  /// @brief Decode messages using the generated decode functions." << std::endl;
+  out << "  class Decoder : public QuickFAST::Codecs::Context" << std::endl;
+  out << "  {" << std::endl;
+  out << "  public:" << std::endl;
+  out << "    Decoder();" << std::endl;
+  out << "    /// @brief Decode the next message and deliver it to the handler." << std::endl;
+  out << "    /// @returns true if a message was delivered." << std::endl;
+  out << "    bool decodeMessage(" << std::endl;
+  out << "      QuickFAST::Codecs::DataSource & source," << std::endl;
+  out << "      MessageHandler & handler);" << std::endl;
+  out << "  };" << std::endl;
+  closeNamespace(out);
+  out << "#endif // " << guard << std::endl;
+}
+
+void
+TemplateCodeGenerator::generateDecodeStatement(
+  std::ostream & out,
+  const GeneratedTemplate & generated,
+  const GeneratedField & field)const
+{
+  const FieldInstruction & instruction = *field.instruction;
+  FieldOpCPtr fieldOp = instruction.getFieldOp();
+  ValueType::Type type = instruction.fieldInstructionType();
+  bool mandatory = instruction.isMandatory();
+  std::string mandatoryArg = mandatory ? "true" : "false";
+  std::string overflowArg = instruction.getIgnoreOverflow() ? "true" : "false";
+  std::string nameArg = generated.structName + "_" + field.member + "_name";
+  std::string valueArg = "message." + field.member;
+  std::string dictionaryArg = boost::lexical_cast<std::string>(fieldOp->getDictionaryIndex());
+  bool hasValue = fieldOp->hasValue();
+
+  out << "    ";
+  if(!mandatory)
+  {
+    out << "message." << field.member << "Present = ";
+  }
+  if(type == ValueType::ASCII)
+  {
+    std::string valueLiteral = hasValue ? stringLiteral(fieldOp->getValue()) : "0";
+    switch(fieldOp->opType())
+    {
+    case FieldOp::CONSTANT:
+      out << support << "::asciiConstant(pmap, " << mandatoryArg << ", " << valueLiteral << ", " << valueArg << ");";
+      break;
+    case FieldOp::DEFAULT:
+      out << support << "::asciiDefault(source, pmap, context, " << mandatoryArg << ", " << valueLiteral
+        << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    case FieldOp::COPY:
+      out << support << "::asciiCopy(source, pmap, context, " << mandatoryArg << ", " << dictionaryArg
+        << ", " << valueLiteral << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    default:
+      out << support << "::asciiNop(source, context, " << mandatoryArg << ", " << valueArg << ");";
+      break;
+    }
+  }
+  else if(type == ValueType::DECIMAL)
+  {
+    out << support << "::decimalNop(source, context, " << mandatoryArg << ", " << valueArg << ", " << nameArg << ");";
+  }
+  else
+  {
+    bool isSigned = isSignedType(type);
+    std::string typeArgs = "<" + field.cppType + (isSigned ? ", true>" : ", false>");
+    std::string initial = integerLiteral(field.cppType, isSigned, hasValue ? fieldOp->getValue() : "");
+    std::string hasValueArg = hasValue ? "true" : "false";
+    switch(fieldOp->opType())
+    {
+    case FieldOp::CONSTANT:
+      out << support << "::integerConstant(pmap, " << mandatoryArg << ", " << initial << ", " << valueArg << ");";
+      break;
+    case FieldOp::DEFAULT:
+      out << support << "::integerDefault" << typeArgs << "(source, pmap, context, " << mandatoryArg
+        << ", " << overflowArg << ", " << hasValueArg << ", " << initial << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    case FieldOp::COPY:
+      out << support << "::integerCopy" << typeArgs << "(source, pmap, context, " << mandatoryArg
+        << ", " << overflowArg << ", " << dictionaryArg << ", " << hasValueArg << ", " << initial << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    case FieldOp::INCREMENT:
+      out << support << "::integerIncrement" << typeArgs << "(source, pmap, context, " << mandatoryArg
+        << ", " << overflowArg << ", " << dictionaryArg << ", " << hasValueArg << ", " << initial << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    case FieldOp::DELTA:
+      out << support << "::integerDelta(source, context, " << mandatoryArg
+        << ", " << dictionaryArg << ", " << hasValueArg << ", " << initial << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    default:
+      out << support << "::integerNop" << typeArgs << "(source, context, " << mandatoryArg
+        << ", " << overflowArg << ", " << valueArg << ", " << nameArg << ");";
+      break;
+    }
+  }
+  out << std::endl;
+}
+
+void
+TemplateCodeGenerator::generateSource(std::ostream & out)
+{
+  analyze();
+  out << "// Generated by the QuickFAST template code generator.  Do not edit." << std::endl;
+  out << "#include <Common/QuickFASTPch.h>" << std::endl;
+  out << "#include \"" << headerName_ << "\"" << std::endl;
+  out << "#include <Codecs/GeneratedDecoderSupport.h>" << std::endl;
+  out << "#include <Codecs/TemplateRegistry.h>" << std::endl;
+  out << std::endl;
+  out << "namespace" << std::endl;
+  out << "{" << std::endl;
+  out << "  const size_t presenceMapBits = " << registry_->presenceMapBits() << ";" << std::endl;
+  out << "  const size_t maxFieldCount = " << registry_->maxFieldCount() << ";" << std::endl;
+  out << "  const size_t dictionarySize = " << registry_->dictionarySize() << ";" << std::endl;
+  out << "  const std::string templateIdName(\"templateID\");" << std::endl;
+  for(size_t nTempl = 0; nTempl < templates_.size(); ++nTempl)
+  {
+    const GeneratedTemplate & generated = templates_[nTempl];
+    for(size_t nField = 0; nField < generated.fields.size(); ++nField)
+    {
+      const GeneratedField & field = generated.fields[nField];
+      out << "  const std::string " << generated.structName << "_" << field.member << "_name("
+        << stringLiteral(field.instruction->getName()) << ");" << std::endl;
+    }
+  }
+  out << "}" << std::endl;
+  out << std::endl;
+  openNamespace(out);
+
+  for(size_t nTempl = 0; nTempl < templates_.size(); ++nTempl)
+  {
+    const GeneratedTemplate & generated = templates_[nTempl];
+    out << "  void decode(" << std::endl;
+    out << "    QuickFAST::Codecs::DataSource & source," << std::endl;
+    out << "    QuickFAST::Codecs::PresenceMap & pmap," << std::endl;
+    out << "    QuickFAST::Codecs::Context & context," << std::endl;
+    out << "    " << generated.structName << " & message)" << std::endl;
+    out << "  {" << std::endl;
+    bool usesSource = false;
+    bool usesPmap = false;
+    bool usesContext = false;
+    for(size_t nField = 0; nField < generated.fields.size(); ++nField)
+    {
+      FieldOp::OpType opType = generated.fields[nField].instruction->getFieldOp()->opType();
+      usesSource = usesSource || opType != FieldOp::CONSTANT;
+      usesContext = usesContext || opType != FieldOp::CONSTANT;
+      usesPmap = usesPmap || generated.fields[nField].instruction->getPresenceMapBitsUsed() != 0;
+      generateDecodeStatement(out, generated, generated.fields[nField]);
+    }
+    if(!usesSource)
+    {
+      out << "    (void)source;" << std::endl;
+    }
+    if(!usesPmap)
+    {
+      out << "    (void)pmap;" << std::endl;
+    }
+    if(!usesContext)
+    {
+      out << "    (void)context;" << std::endl;
+    }
+    out << "  }" << std::endl;
+    out << std::endl;
+  }
+
+  out << "  Decoder::Decoder()" << std::endl;
+  out << "    : Context(QuickFAST::Codecs::TemplateRegistryPtr(" << std::endl;
+  out << "        new QuickFAST::Codecs::TemplateRegistry(presenceMapBits, maxFieldCount, dictionarySize)))" << std::endl;
+  out << "  {" << std::endl;
+  out << "  }" << std::endl;
+  out << std::endl;
+  out << "  bool" << std::endl;
+  out << "  Decoder::decodeMessage(" << std::endl;
+  out << "    QuickFAST::Codecs::DataSource & source," << std::endl;
+  out << "    MessageHandler & handler)" << std::endl;
+  out << "  {" << std::endl;
+  out << "    source.beginMessage();" << std::endl;
+  out << "    QuickFAST::Codecs::PresenceMap pmap(presenceMapBits);" << std::endl;
+  out << "    pmap.decode(source);" << std::endl;
+  out << "    if(pmap.checkNextField())" << std::endl;
+  out << "    {" << std::endl;
+  out << "      QuickFAST::template_id_t id;" << std::endl;
+  out << "      QuickFAST::Codecs::FieldInstruction::decodeUnsignedInteger(source, *this, id, templateIdName);" << std::endl;
+  out << "      setTemplateId(id);" << std::endl;
+  out << "    }" << std::endl;
+  out << "    switch(getTemplateId())" << std::endl;
+  out << "    {" << std::endl;
+  for(size_t nTempl = 0; nTempl < templates_.size(); ++nTempl)
+  {
+    const GeneratedTemplate & generated = templates_[nTempl];
+    out << "    case " << generated.structName << "::templateId:" << std::endl;
+    out << "      {" << std::endl;
+    if(generated.templ->getReset())
+    {
+      out << "        reset(false);" << std::endl;
+    }
+    out << "        " << generated.structName << " message;" << std::endl;
+    out << "        decode(source, pmap, *this, message);" << std::endl;
+    if(generated.templ->getIgnore())
+    {
+      out << "        return false;" << std::endl;
+    }
+    else
+    {
+      out << "        handler.handle(message);" << std::endl;
+      out << "        return true;" << std::endl;
+    }
+    out << "      }" << std::endl;
+  }
+  TemplateCPtr resetTemplate;
+  if(!registry_->getTemplate(Context::SCPResetTemplateId, resetTemplate))
+  {
+    out << "    case SCPResetTemplateId:" << std::endl;
+    out << "      reset(false);" << std::endl;
+    out << "      return false;" << std::endl;
+  }
+  out << "    default:" << std::endl;
+  out << "      break;" << std::endl;
+  out << "    }" << std::endl;
+  out << "    std::string error = \"Unknown or unsupported template ID:\";" << std::endl;
+  out << "    error += boost::lexical_cast<std::string>(getTemplateId());" << std::endl;
+  out << "    reportError(\"[ERR D9]\", error);" << std::endl;
+  out << "    return false;" << std::endl;
+  out << "  }" << std::endl;
+  closeNamespace(out);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef TEMPLATECODEGENERATOR_H
+#define TEMPLATECODEGENERATOR_H
+#include "TemplateCodeGenerator_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Codecs/TemplateRegistry_fwd.h>
+#include <Codecs/Template_fwd.h>
+#include <Codecs/FieldInstruction_fwd.h>
+
+namespace QuickFAST{
+  namespace Codecs{
+    /// @brief Generate C++ source code to decode the templates in a TemplateRegistry.
+    ///
+    /// For each template the generated code contains a struct with one typed member
+    /// per field and a decode function that decodes the template's fields straight
+    /// into that struct.  Presence, operators, initial values, and dictionary indexes
+    /// are resolved when the code is generated so the compiler sees them as constants.
+    /// The decoding primitives come from GeneratedDecoderSupport.
+    ///
+    /// The generated code also contains a MessageHandler class with one handle() method
+    /// per template, and a Decoder class (derived from Context) whose decodeMessage()
+    /// method decodes the next message and passes it to the handler.
+    ///
+    /// Only a subset of FAST is supported: int32, uInt32, int64, uInt64 with any
+    /// operator except tail, ASCII strings with no operator, constant, default or copy,
+    /// and single-operator decimals with no operator.  Templates containing anything
+    /// else are skipped.  They are listed in a comment in the generated header and
+    /// are available from getSkippedTemplates().
+    ///
+    /// The registry must have been finalized.
+    class QuickFAST_Export TemplateCodeGenerator
+    {
+    public:
+      /// @brief Construct
+      /// @param registry contains the templates
+      /// @param nameSpace is the C++ namespace for the generated code. May be nested (a::b).
+      TemplateCodeGenerator(TemplateRegistryCPtr registry, const std::string & nameSpace);
+
+      /// @brief Set the name used to #include the generated header from the generated source.
+      /// @param headerName is the file name of the generated header.
+      void setHeaderName(const std::string & headerName)
+      {
+        headerName_ = headerName;
+      }
+
+      /// @brief Write the generated header.
+      /// @param out receives the code
+      void generateHeader(std::ostream & out);
+
+      /// @brief Write the generated source.
+      /// @param out receives the code
+      void generateSource(std::ostream & out);
+
+      /// @brief Describe templates that could not be generated.
+      /// @returns one entry per skipped template: the name and the reason.
+      const std::vector<std::string> & getSkippedTemplates()const
+      {
+        return skipped_;
+      }
+
+      /// @brief Convert a FAST name into a valid C++ identifier.
+      /// @param name is the FAST name
+      /// @returns a C++ identifier
+      static std::string identifier(const std::string & name);
+
+    private:
+      struct GeneratedField
+      {
+        FieldInstructionCPtr instruction;
+        std::string member;
+        std::string cppType;
+      };
+
+      struct GeneratedTemplate
+      {
+        TemplateCPtr templ;
+        std::string structName;
+        std::vector<GeneratedField> fields;
+      };
+
+      void analyze();
+      bool analyzeField(
+        const FieldInstructionCPtr & instruction,
+        GeneratedField & field,
+        std::string & reason)const;
+      void generateDecodeStatement(
+        std::ostream & out,
+        const GeneratedTemplate & generated,
+        const GeneratedField & field)const;
+      void openNamespace(std::ostream & out)const;
+      void closeNamespace(std::ostream & out)const;
+      static std::string integerLiteral(
+        const std::string & cppType,
+        bool isSigned,
+        const std::string & value);
+      static std::string stringLiteral(const std::string & value);
+
+    private:
+      TemplateRegistryCPtr registry_;
+      std::string nameSpace_;
+      std::string headerName_;
+      bool analyzed_;
+      std::vector<GeneratedTemplate> templates_;
+      std::vector<std::string> skipped_;
+    };
+  }
+}
+#endif // TEMPLATECODEGENERATOR_H
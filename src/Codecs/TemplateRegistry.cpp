@@ -9,8 +9,27 @@
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Codecs;
 
+namespace
+{
+  /// Use an array if no more than this many entries would be wasted per template
+  const size_t denseSlotsPerTemplate = 8;
+  /// ...or if the largest ID is this small regardless of the number of templates
+  const size_t denseMinimumSize = 1024;
+
+  inline size_t hashTemplateId(template_id_t id)
+  {
+    // Mix the bits so IDs with a common stride do not collide in the low bits.
+    uint32 hash = id;
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bu;
+    hash ^= hash >> 16;
+    return hash;
+  }
+}
+
 TemplateRegistry::TemplateRegistry()
-: presenceMapBits_(1) // every template requires 1 bit for the template ID
+: indexed_(false)
+, presenceMapBits_(1) // every template requires 1 bit for the template ID
 , dictionarySize_(0)
 , maxFieldCount_(0)
 {
@@ -20,7 +39,8 @@ TemplateRegistry::TemplateRegistry(
   size_t pmapBits,
   size_t fieldCount,
   size_t dictionarySize)
-: presenceMapBits_(pmapBits)
+: indexed_(false)
+, presenceMapBits_(pmapBits)
 , dictionarySize_(dictionarySize)
 , maxFieldCount_(fieldCount)
 {
@@ -69,6 +89,96 @@ TemplateRegistry::finalize()
       maxFieldCount_ = fieldCount;
     }
   }
+  buildIdIndex();
+}
+
+void
+TemplateRegistry::clearIdIndex()
+{
+  idIndex_.clear();
+  idHash_.clear();
+  indexed_ = false;
+}
+
+void
+TemplateRegistry::buildIdIndex()
+{
+  clearIdIndex();
+  if(templates_.empty())
+  {
+    indexed_ = true;
+    return;
+  }
+  template_id_t maxId = templates_.rbegin()->first;
+  size_t denseLimit = templates_.size() * denseSlotsPerTemplate;
+  if(denseLimit < denseMinimumSize)
+  {
+    denseLimit = denseMinimumSize;
+  }
+  if(maxId < denseLimit)
+  {
+    idIndex_.resize(size_t(maxId) + 1, 0);
+    for(TemplateIdMap::const_iterator it = templates_.begin();
+      it != templates_.end();
+      ++it)
+    {
+      idIndex_[it->first] = it->second.get();
+    }
+  }
+  else
+  {
+    // keep the load factor at or below 1/2
+    size_t hashSize = 16;
+    while(hashSize < templates_.size() * 2)
+    {
+      hashSize *= 2;
+    }
+    HashEntry empty = {0, 0};
+    idHash_.resize(hashSize, empty);
+    size_t mask = hashSize - 1;
+    for(TemplateIdMap::const_iterator it = templates_.begin();
+      it != templates_.end();
+      ++it)
+    {
+      size_t pos = hashTemplateId(it->first) & mask;
+      while(idHash_[pos].template_ != 0)
+      {
+        pos = (pos + 1) & mask;
+      }
+      idHash_[pos].id_ = it->first;
+      idHash_[pos].template_ = it->second.get();
+    }
+  }
+  indexed_ = true;
+}
+
+const Template *
+TemplateRegistry::findSparseTemplate(template_id_t templateId)const
+{
+  if(!idHash_.empty())
+  {
+    size_t mask = idHash_.size() - 1;
+    size_t pos = hashTemplateId(templateId) & mask;
+    while(idHash_[pos].template_ != 0)
+    {
+      if(idHash_[pos].id_ == templateId)
+      {
+        return idHash_[pos].template_;
+      }
+      pos = (pos + 1) & mask;
+    }
+    return 0;
+  }
+  if(!indexed_)
+  {
+    // Not finalized yet.
+    TemplateIdMap::const_iterator it = templates_.find(templateId);
+    if(it != templates_.end())
+    {
+      return it->second.get();
+    }
+  }
+  return 0;
 }
 
 
@@ -80,6 +190,7 @@ TemplateRegistry::addTemplate(TemplatePtr value)
   if(id != 0)
   {
     templates_[id] = value;
+    clearIdIndex();
   }
   std::string name;
   value->qualifyName(name);
@@ -95,6 +95,22 @@ namespace QuickFAST{
       /// @returns true if the template was found.
       bool getTemplate(uint32 templateId, TemplateCPtr & valueFound)const;
 
+      /// @brief Use Template ID to find a template without copying a smart pointer.
+      ///
+      /// After finalize() this is a constant time lookup: an array indexed by
+      /// template ID, or an open addressed hash table if the IDs are too sparse
+      /// for an array.  The registry owns the template.
+      /// @param templateId the desired template
+      /// @returns a pointer to the template or 0 if it is not found.
+      const Template * findTemplate(template_id_t templateId)const
+      {
+        if(templateId < idIndex_.size())
+        {
+          return idIndex_[templateId];
+        }
+        return findSparseTemplate(templateId);
+      }
+
       /// @brief Find a template by name.
       /// @param[in] name the desired template
       /// @param[in] templateNamespace in which name is defined.
@@ -197,6 +213,11 @@ namespace QuickFAST{
       /// @param indent is the number of spaces to appear at the beginning of each line.
       void display(std::ostream & output, size_t indent = 0) const;
 
+    private:
+      void buildIdIndex();
+      void clearIdIndex();
+      const Template * findSparseTemplate(template_id_t templateId)const;
+
     private:
       // forbid copy constructor
       TemplateRegistry(const TemplateRegistry &);
@@ -210,6 +231,19 @@ namespace QuickFAST{
 
       typedef std::vector<TemplatePtr> MutableTemplates;
       MutableTemplates mutableTemplates_;
+
+      /// Templates indexed by ID.  Built by finalize() when the IDs are dense enough.
+      std::vector<const Template *> idIndex_;
+      /// An entry in the hash table used when the IDs are too sparse for idIndex_
+      struct HashEntry
+      {
+        template_id_t id_;
+        const Template * template_;
+      };
+      /// Open addressed hash table.  Size is a power of two.  Empty entries have template_ == 0.
+      std::vector<HashEntry> idHash_;
+      /// True if one of the above has been built since the last change to templates_
+      bool indexed_;
       size_t presenceMapBits_;
       size_t dictionarySize_;
       size_t maxFieldCount_;
@@ -174,5 +174,67 @@ namespace QuickFAST
 #endif
   }
 
+  /// @brief Read a value published by another thread via atomic_store_release.
+  ///
+  /// Loads and stores that follow this call will not be moved ahead of it.
+  /// @param source points to the value to be read
+  template<typename T>
+  inline
+  T atomic_load_acquire(T const volatile * source)
+  {
+#if defined(_WIN32)
+    T value = *source;
+# if defined(_M_IX86) || defined(_M_X64)
+    // x86 does not reorder loads with later loads or stores; stop the compiler from doing so.
+    _ReadWriteBarrier();
+# else
+    MemoryBarrier();
+# endif
+    return value;
+#elif defined(__GNUC__)
+# if defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(source, __ATOMIC_ACQUIRE);
+# else
+    T value = *source;
+    __sync_synchronize();
+    return value;
+# endif
+#else
+    T value = *source;
+    membar_consumer();
+    return value;
+#endif
+  }
+
+  /// @brief Publish a value to be read by another thread via atomic_load_acquire.
+  ///
+  /// Loads and stores that precede this call will not be moved after it.
+  /// @param target points to the value to be updated
+  /// @param value is the new value
+  template<typename T>
+  inline
+  void atomic_store_release(T volatile * target, T value)
+  {
+#if defined(_WIN32)
+# if defined(_M_IX86) || defined(_M_X64)
+    // x86 does not reorder stores with earlier loads or stores; stop the compiler from doing so.
+    _ReadWriteBarrier();
+# else
+    MemoryBarrier();
+# endif
+    *target = value;
+#elif defined(__GNUC__)
+# if defined(__ATOMIC_RELEASE)
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+# else
+    __sync_synchronize();
+    *target = value;
+# endif
+#else
+    membar_producer();
+    *target = value;
+#endif
+  }
+
 }
 #endif // ATOMICOPS_H
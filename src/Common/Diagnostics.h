@@ -0,0 +1,29 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+/// @brief Enable or disable the decoder's diagnostic hooks at compile time.
+///
+/// By default QuickFAST is built with support for echoing the input
+/// (DataSource::setEcho) and verbose decoder output (Context::setVerboseOutput,
+/// PresenceMap::setVerbose).  Checking whether these are enabled costs a branch
+/// for every byte, field, and presence map bit decoded.
+///
+/// Define QUICKFAST_NO_DIAGNOSTICS when building QuickFAST and the applications
+/// that use it to remove these checks from the generated code.  In such a build,
+/// attempting to enable echo or verbose output throws a UsageError.
+/// Class layouts are the same either way.
+#ifndef QUICKFAST_DIAGNOSTICS
+# ifdef QUICKFAST_NO_DIAGNOSTICS
+#   define QUICKFAST_DIAGNOSTICS 0
+# else // QUICKFAST_NO_DIAGNOSTICS
+#   define QUICKFAST_DIAGNOSTICS 1
+# endif // QUICKFAST_NO_DIAGNOSTICS
+#endif // QUICKFAST_DIAGNOSTICS
+
+#endif // DIAGNOSTICS_H
@@ -0,0 +1,244 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "StopBitScanner.h"
+#include <Common/Constants.h>
+#include <Common/Exceptions.h>
+
+// SSE2 is part of the x86-64 baseline, so it can be compiled unconditionally there.
+// AVX2 is compiled for the specific functions that need it and selected at run time.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define QUICKFAST_STOPBIT_SSE2
+# include <emmintrin.h>
+# if defined(_MSC_VER) && _MSC_VER >= 1700
+#   define QUICKFAST_STOPBIT_AVX2
+#   include <immintrin.h>
+#   include <intrin.h>
+#   define QUICKFAST_TARGET_AVX2
+# elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (__GNUC__ >= 5 || defined(__clang__))
+#   define QUICKFAST_STOPBIT_AVX2
+#   include <immintrin.h>
+#   define QUICKFAST_TARGET_AVX2 __attribute__((target("avx2")))
+# endif
+#endif
+
+using namespace ::QuickFAST;
+
+// finder_ and implementation_ are constant initialized, so find() works even
+// when it is called during static initialization.  installed_ replaces them
+// with the best implementation when the library is loaded, before any decoder
+// thread can start, so find() never writes finder_.
+StopBitScanner::Finder StopBitScanner::finder_ = &StopBitScanner::selectAndFind;
+StopBitScanner::Implementation StopBitScanner::implementation_ = StopBitScanner::SCALAR;
+bool StopBitScanner::installed_ = StopBitScanner::installBest();
+
+namespace
+{
+#if defined(QUICKFAST_STOPBIT_SSE2)
+  inline size_t lowestBitSet(unsigned int mask)
+  {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+#endif // QUICKFAST_STOPBIT_SSE2
+
+#if defined(QUICKFAST_STOPBIT_AVX2)
+  bool processorHasAVX2()
+  {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7)
+    {
+      return false;
+    }
+    __cpuid(info, 1);
+    const int osxsave = 1 << 27;
+    const int avx = 1 << 28;
+    if((info[2] & (osxsave | avx)) != (osxsave | avx))
+    {
+      return false;
+    }
+    // The operating system must save the YMM registers.
+    if((_xgetbv(0) & 6) != 6)
+    {
+      return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+  }
+#endif // QUICKFAST_STOPBIT_AVX2
+}
+
+size_t
+StopBitScanner::findScalar(const uchar * data, size_t size)
+{
+  size_t pos = 0;
+  while(pos < size && (data[pos] & stopBit) == 0)
+  {
+    ++pos;
+  }
+  return pos;
+}
+
+size_t
+StopBitScanner::findSSE2(const uchar * data, size_t size)
+{
+#if defined(QUICKFAST_STOPBIT_SSE2)
+  size_t pos = 0;
+  while(pos + 16 <= size)
+  {
+    // movemask collects the high (stop) bit of each byte.
+    unsigned int mask = static_cast<unsigned int>(
+      _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos))));
+    if(mask != 0)
+    {
+      return pos + lowestBitSet(mask);
+    }
+    pos += 16;
+  }
+  return pos + findScalar(data + pos, size - pos);
+#else
+  return findScalar(data, size);
+#endif
+}
+
+#if defined(QUICKFAST_STOPBIT_AVX2)
+QUICKFAST_TARGET_AVX2
+#endif
+size_t
+StopBitScanner::findAVX2(const uchar * data, size_t size)
+{
+#if defined(QUICKFAST_STOPBIT_AVX2)
+  size_t pos = 0;
+  while(pos + 32 <= size)
+  {
+    unsigned int mask = static_cast<unsigned int>(
+      _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos))));
+    if(mask != 0)
+    {
+      return pos + lowestBitSet(mask);
+    }
+    pos += 32;
+  }
+  return pos + findSSE2(data + pos, size - pos);
+#else
+  return findSSE2(data, size);
+#endif
+}
+
+bool
+StopBitScanner::isSupported(Implementation implementation)
+{
+  switch(implementation)
+  {
+  case SCALAR:
+    return true;
+  case SSE2:
+#if defined(QUICKFAST_STOPBIT_SSE2)
+    return true;
+#else
+    return false;
+#endif
+  case AVX2:
+#if defined(QUICKFAST_STOPBIT_AVX2)
+    return processorHasAVX2();
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+StopBitScanner::Implementation
+StopBitScanner::best()
+{
+  if(isSupported(AVX2))
+  {
+    return AVX2;
+  }
+  if(isSupported(SSE2))
+  {
+    return SSE2;
+  }
+  return SCALAR;
+}
+
+void
+StopBitScanner::setImplementation(Implementation implementation)
+{
+  if(!isSupported(implementation))
+  {
+    std::string error = "StopBitScanner: ";
+    error += implementationName(implementation);
+    error += " is not supported on this processor.";
+    throw UsageError("Coding Error", error.c_str());
+  }
+  finder_ = finderFor(implementation);
+  implementation_ = implementation;
+}
+
+StopBitScanner::Implementation
+StopBitScanner::getImplementation()
+{
+  if(finder_ == &StopBitScanner::selectAndFind)
+  {
+    return best();
+  }
+  return implementation_;
+}
+
+StopBitScanner::Finder
+StopBitScanner::finderFor(Implementation implementation)
+{
+  switch(implementation)
+  {
+  case AVX2:
+    return &StopBitScanner::findAVX2;
+  case SSE2:
+    return &StopBitScanner::findSSE2;
+  default:
+    return &StopBitScanner::findScalar;
+  }
+}
+
+const char *
+StopBitScanner::implementationName(Implementation implementation)
+{
+  switch(implementation)
+  {
+  case SCALAR:
+    return "scalar";
+  case SSE2:
+    return "SSE2";
+  case AVX2:
+    return "AVX2";
+  default:
+    return "unknown";
+  }
+}
+
+size_t
+StopBitScanner::selectAndFind(const uchar * data, size_t size)
+{
+  // Only reached before installBest() has run.  Choose without touching finder_.
+  static const Finder bestFinder = finderFor(best());
+  return bestFinder(data, size);
+}
+
+bool
+StopBitScanner::installBest()
+{
+  setImplementation(best());
+  return true;
+}
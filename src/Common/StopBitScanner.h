@@ -0,0 +1,181 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef STOPBITSCANNER_H
+#define STOPBITSCANNER_H
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+#include <string.h>
+
+// decodeWord() loads eight bytes at once.  It needs to know the byte order.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__) || \
+  (defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+# define QUICKFAST_STOPBIT_WORDS
+# if defined(_MSC_VER)
+#   include <intrin.h>
+# endif
+# if defined(__BMI2__)
+#   include <immintrin.h>
+# endif
+#endif
+
+namespace QuickFAST{
+  /// @brief Find the byte with the stop bit that ends a FAST entity.
+  ///
+  /// Presence maps, integers, and ASCII strings all end at the first byte
+  /// with the high bit set.  StopBitScanner finds that byte in a block of memory.
+  ///
+  /// The SSE2 and AVX2 implementations examine 16 or 32 bytes at a time using movemask.
+  /// The scalar implementation is available on all platforms.
+  /// The best implementation supported by this processor is selected during static
+  /// initialization, when the library is loaded.  Use setImplementation() to override
+  /// the selection (for testing or benchmarking.)
+  class QuickFAST_Export StopBitScanner
+  {
+  public:
+    /// @brief Identify the available implementations.
+    enum Implementation
+    {
+      SCALAR,
+      SSE2,
+      AVX2
+    };
+
+    /// @brief Find the first byte with the stop bit set.
+    /// @param data points to the bytes to be searched
+    /// @param size is the number of bytes to search
+    /// @returns the offset of the byte with the stop bit or size if none is found.
+    static size_t find(const uchar * data, size_t size)
+    {
+      return finder_(data, size);
+    }
+
+    /// @brief Decode a stop bit encoded entity of up to eight bytes without looping.
+    ///
+    /// Does one unaligned eight byte load, finds the stop bit by counting trailing zeros,
+    /// and packs the 7-bit groups together using PEXT if the compiler targets BMI2, or
+    /// a portable shift and mask sequence otherwise.
+    /// @param data points to at least eight readable bytes
+    /// @param[out] length is the size of the entity including the byte with the stop bit.
+    /// @param[out] groups receives the 7-bit groups, first group most significant.
+    /// @returns false if there is no stop bit in the first eight bytes (or
+    ///          this platform's byte order is not known at compile time.)
+    static bool decodeWord(const uchar * data, size_t & length, uint64 & groups)
+    {
+#if defined(QUICKFAST_STOPBIT_WORDS)
+      uint64 word;
+      memcpy(&word, data, sizeof(word));
+      uint64 stops = word & 0x8080808080808080ULL;
+      if(stops == 0)
+      {
+        return false;
+      }
+      length = (lowestBitSet(stops) + 1) / 8;
+      // Discard the bytes after the stop byte, then reverse the order so the
+      // first byte is the most significant.
+      word = byteSwap(word << (64 - 8 * length)) & 0x7F7F7F7F7F7F7F7FULL;
+#if defined(__BMI2__)
+      groups = _pext_u64(word, 0x7F7F7F7F7F7F7F7FULL);
+#else // __BMI2__
+      word = ((word & 0x7F007F007F007F00ULL) >> 1) | (word & 0x007F007F007F007FULL);
+      word = ((word & 0x3FFF00003FFF0000ULL) >> 2) | (word & 0x00003FFF00003FFFULL);
+      groups = ((word & 0x0FFFFFFF00000000ULL) >> 4) | (word & 0x000000000FFFFFFFULL);
+#endif // __BMI2__
+      return true;
+#else // QUICKFAST_STOPBIT_WORDS
+      (void)data;
+      (void)length;
+      (void)groups;
+      return false;
+#endif // QUICKFAST_STOPBIT_WORDS
+    }
+
+    /// @brief Find the stop bit one byte at a time.
+    /// @param data points to the bytes to be searched
+    /// @param size is the number of bytes to search
+    /// @returns the offset of the byte with the stop bit or size if none is found.
+    static size_t findScalar(const uchar * data, size_t size);
+
+    /// @brief Find the stop bit using SSE2 instructions.
+    ///
+    /// Only valid if isSupported(SSE2)
+    /// @param data points to the bytes to be searched
+    /// @param size is the number of bytes to search
+    /// @returns the offset of the byte with the stop bit or size if none is found.
+    static size_t findSSE2(const uchar * data, size_t size);
+
+    /// @brief Find the stop bit using AVX2 instructions.
+    ///
+    /// Only valid if isSupported(AVX2)
+    /// @param data points to the bytes to be searched
+    /// @param size is the number of bytes to search
+    /// @returns the offset of the byte with the stop bit or size if none is found.
+    static size_t findAVX2(const uchar * data, size_t size);
+
+    /// @brief Can this implementation be used on this build and processor?
+    /// @param implementation identifies the implementation
+    /// @returns true if the implementation can be used
+    static bool isSupported(Implementation implementation);
+
+    /// @brief Find the fastest implementation supported on this processor
+    static Implementation best();
+
+    /// @brief Select the implementation to be used by find()
+    ///
+    /// The best implementation is installed when the library is loaded.
+    /// Call this only before any thread starts decoding.
+    /// @param implementation identifies the implementation
+    /// @throws UsageError if the implementation is not supported.
+    static void setImplementation(Implementation implementation);
+
+    /// @brief Which implementation is find() using?
+    static Implementation getImplementation();
+
+    /// @brief Get a printable name for an implementation
+    /// @param implementation identifies the implementation
+    static const char * implementationName(Implementation implementation);
+
+  private:
+#if defined(QUICKFAST_STOPBIT_WORDS)
+    static size_t lowestBitSet(uint64 value)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanForward64(&index, value);
+      return index;
+#elif defined(_MSC_VER)
+      unsigned long index;
+      if(_BitScanForward(&index, static_cast<unsigned long>(value)))
+      {
+        return index;
+      }
+      _BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+      return index + 32;
+#else
+      return __builtin_ctzll(value);
+#endif
+    }
+
+    static uint64 byteSwap(uint64 value)
+    {
+#if defined(_MSC_VER)
+      return _byteswap_uint64(value);
+#else
+      return __builtin_bswap64(value);
+#endif
+    }
+#endif // QUICKFAST_STOPBIT_WORDS
+
+    typedef size_t (*Finder)(const uchar * data, size_t size);
+    static Finder finderFor(Implementation implementation);
+    static size_t selectAndFind(const uchar * data, size_t size);
+    static bool installBest();
+    static Finder finder_;
+    static Implementation implementation_;
+    static bool installed_;
+  };
+}
+#endif // STOPBITSCANNER_H
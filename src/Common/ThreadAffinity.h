@@ -0,0 +1,44 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef THREADAFFINITY_H
+#define THREADAFFINITY_H
+
+#if defined(_WIN32)
+# include "windows.h"
+#elif defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace QuickFAST
+{
+  /// @brief Pin the calling thread to one CPU.
+  ///
+  /// Supported on Linux and Windows.  Elsewhere this does nothing and returns false.
+  /// @param cpu is the zero-based CPU number.
+  /// @returns true if the thread was pinned.
+  inline
+  bool pinThreadToCpu(int cpu)
+  {
+    if(cpu < 0)
+    {
+      return false;
+    }
+#if defined(_WIN32)
+    return ::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+  }
+}
+#endif // THREADAFFINITY_H
@@ -170,6 +170,29 @@ WorkingBuffer::append(const WorkingBuffer & rhs)
   }
 }
 
+void
+WorkingBuffer::append(const uchar * data, size_t bytesToAppend)
+{
+  if(reverse_)
+  {
+    if(startPos_ < bytesToAppend)
+    {
+      grow(size() + bytesToAppend);
+    }
+    std::memcpy(buffer_.get() + startPos_ - bytesToAppend, data, bytesToAppend);
+    startPos_ -= bytesToAppend;
+  }
+  else
+  {
+    if(endPos_ + bytesToAppend > capacity_)
+    {
+      grow(size() + bytesToAppend);
+    }
+    std::memcpy(buffer_.get() + endPos_, data, bytesToAppend);
+    endPos_ += bytesToAppend;
+  }
+}
+
 void
 WorkingBuffer::toString(std::string & result) const
 {
@@ -105,6 +105,15 @@ namespace QuickFAST{
     /// @param rhs the buffer to be appended
     void append(const WorkingBuffer & rhs);
 
+    ///@brief Append a block of bytes to the buffer
+    ///
+    /// Honors "reverse" the same way append(const WorkingBuffer &) does.
+    /// The bytes are copied as a block, preserving their order.
+    ///
+    /// @param data points to the bytes to be appended
+    /// @param size is the number of bytes to append
+    void append(const uchar * data, size_t size);
+
     /// @brief A convenience method: copy contents to a std::string
     void toString(std::string & result) const;
 
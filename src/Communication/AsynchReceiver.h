@@ -158,55 +158,62 @@ namespace QuickFAST
         { // Scope for lock
           boost::mutex::scoped_lock lock(bufferMutex_);
           --readsInProgress_;
-          ++packetsReceived_;
-          if (!error)
+          if(acceptReceived(error, buffer, bytesReceived, lock))
           {
-            // it's possible to receive empty packets.
-            if(bytesReceived <= 0)
-            {
-              // empty buffer? just use it again
-              ++emptyPackets_;
-              idleBufferPool_.push(buffer);
-            }
-            else if(paused_)
-            {
-              // We're paused.  Ignore incoming packets
-              ++pausedPackets_;
-              idleBufferPool_.push(buffer);
-            }
-            else
-            {
-              ++packetsQueued_;
-              bytesReceived_ += bytesReceived;
-              largestPacket_ = std::max(largestPacket_, bytesReceived);
-              buffer->setUsed(bytesReceived);
-              if(queue_.push(buffer, lock))
-              {
-                // A true return from push means that no one is servicing the queue
-                // Volunteer to service it. If it returns true, then the offer was
-                // accepted.  We'll service the queue after releasing the lock.
-                service = queue_.startService(lock);
-              }
-            }
+            // No one is servicing the queue. Volunteer to service it. If the offer is
+            // accepted, we'll service the queue after releasing the lock.
+            service = queue_.startService(lock);
           }
-          else
+          // if possible fill another buffer while we process this one
+          startReceive(lock);
+          // end of scope for lock
+        }
+
+        while(service)
+        {
+          service = serviceQueue();
+        }
+      }
+
+      /// @brief handle completion of a read that filled several buffers at once.
+      ///
+      /// All of the buffers are queued while holding the lock once.
+      /// The read counts as a single read in progress.
+      ///
+      /// @param errors indicates the status of the receive into each of the filled buffers
+      /// @param buffers into which the receive happened
+      /// @param bytesReceived How much data is in each of the filled buffers
+      /// @param filled how many buffers were filled.
+      /// @param count how many buffers were provided.  Those after the filled buffers are returned to the pool.
+      void handleReceiveBatch(
+        const boost::system::error_code * errors,
+        LinkedBuffer ** buffers,
+        const size_t * bytesReceived,
+        size_t filled,
+        size_t count)
+      {
+        bool service = false;
+        { // Scope for lock
+          boost::mutex::scoped_lock lock(bufferMutex_);
+          --readsInProgress_;
+          bool idle = false;
+          for(size_t nBuffer = 0; nBuffer < filled; ++nBuffer)
           {
-            // after an error, recover the buffer
-            idleBufferPool_.push(buffer);
-            // ignore errors during state transitions
-            if(!paused_ && !stopping_)
+            if(acceptReceived(errors[nBuffer], buffers[nBuffer], bytesReceived[nBuffer], lock))
             {
-              ++errorPackets_;
-              // and let the consumer decide what to do
-              if(!assembler_->reportCommunicationError(error.message()))
-              {
-                stop();
-              }
+              idle = true;
             }
           }
-          // if possible fill another buffer while we process this one
+          if(idle)
+          {
+            // Service the whole batch.
+            service = queue_.startService(lock);
+          }
+          for(size_t nBuffer = filled; nBuffer < count; ++nBuffer)
+          {
+            idleBufferPool_.push(buffers[nBuffer]);
+          }
           startReceive(lock);
-          // end of scope for lock
         }
 
         while(service)
@@ -215,6 +222,60 @@ namespace QuickFAST
         }
       }
 
+    private:
+      /// @brief Queue a filled buffer.  Call with bufferMutex_ locked.
+      /// @returns true if the buffer was queued and no one is servicing the queue.
+      bool acceptReceived(
+        const boost::system::error_code& error,
+        LinkedBuffer * buffer,
+        size_t bytesReceived,
+        boost::mutex::scoped_lock & lock)
+      {
+        bool idle = false;
+        ++packetsReceived_;
+        if (!error)
+        {
+          // it's possible to receive empty packets.
+          if(bytesReceived <= 0)
+          {
+            // empty buffer? just use it again
+            ++emptyPackets_;
+            idleBufferPool_.push(buffer);
+          }
+          else if(paused_)
+          {
+            // We're paused.  Ignore incoming packets
+            ++pausedPackets_;
+            idleBufferPool_.push(buffer);
+          }
+          else
+          {
+            ++packetsQueued_;
+            bytesReceived_ += bytesReceived;
+            largestPacket_ = std::max(largestPacket_, bytesReceived);
+            buffer->setUsed(bytesReceived);
+            // A true return from push means that no one is servicing the queue
+            idle = queue_.push(buffer, lock);
+          }
+        }
+        else
+        {
+          // after an error, recover the buffer
+          idleBufferPool_.push(buffer);
+          // ignore errors during state transitions
+          if(!paused_ && !stopping_)
+          {
+            ++errorPackets_;
+            // and let the consumer decide what to do
+            if(!assembler_->reportCommunicationError(error.message()))
+            {
+              stop();
+            }
+          }
+        }
+        return idle;
+      }
+
     protected:
       /// @brief a manager for the boost::io_service object
       AsioService ioService_;
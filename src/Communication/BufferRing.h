@@ -0,0 +1,144 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BUFFERRING_H
+#define BUFFERRING_H
+// All inline, do not export.
+//#include <Common/QuickFAST_Export.h>
+#include "BufferRing_fwd.h"
+#include <Communication/LinkedBuffer.h>
+#include <Common/AtomicOps.h>
+
+namespace QuickFAST
+{
+  namespace Communication
+  {
+    /// @brief A bounded lock-free FIFO of buffers for exactly one producer thread and one consumer thread.
+    ///
+    /// Only one thread may call push() and only one (other) thread may call pop().
+    /// Neither call blocks or takes a lock.
+    ///
+    /// The producer owns tail_ and the consumer owns head_.  Each lives in its own
+    /// cache line together with that thread's cached copy of the other index, so
+    /// the threads touch each other's line only when the cached copy says the
+    /// ring looks full (or empty.)
+    ///
+    /// Unlike BufferQueue the buffers' links are not used, so a buffer may be
+    /// linked into a list while it is in the ring.
+    /// This object does not manage buffer lifetimes.  It assumes
+    /// that buffers outlive the collection.
+    class BufferRing
+    {
+    public:
+      /// @brief Construct an empty ring.
+      /// @param capacity is the minimum number of buffers the ring can hold.
+      ///        It is rounded up to a power of two.
+      explicit BufferRing(size_t capacity)
+        : slots_(0)
+        , mask_(0)
+        , head_(0)
+        , tailCache_(0)
+        , tail_(0)
+        , headCache_(0)
+      {
+        size_t size = 1;
+        while(size < capacity)
+        {
+          size <<= 1;
+        }
+        slots_ = new LinkedBuffer *[size];
+        mask_ = size - 1;
+      }
+
+      ~BufferRing()
+      {
+        delete[] slots_;
+      }
+
+      /// @brief How many buffers the ring can hold.
+      size_t capacity()const
+      {
+        return mask_ + 1;
+      }
+
+      /// @brief Add a buffer to the ring.  Producer thread only.
+      /// @param buffer is the buffer to be added.
+      /// @returns false if the ring is full.
+      bool push(LinkedBuffer * buffer)
+      {
+        assert(buffer != 0);
+        size_t tail = tail_;
+        if(tail - headCache_ > mask_)
+        {
+          headCache_ = atomic_load_acquire(&head_);
+          if(tail - headCache_ > mask_)
+          {
+            return false;
+          }
+        }
+        slots_[tail & mask_] = buffer;
+        atomic_store_release(&tail_, tail + 1);
+        return true;
+      }
+
+      /// @brief Remove the oldest buffer from the ring.  Consumer thread only.
+      /// @returns the buffer or zero if the ring is empty.
+      LinkedBuffer * pop()
+      {
+        size_t head = head_;
+        if(head == tailCache_)
+        {
+          tailCache_ = atomic_load_acquire(&tail_);
+          if(head == tailCache_)
+          {
+            return 0;
+          }
+        }
+        LinkedBuffer * buffer = slots_[head & mask_];
+        atomic_store_release(&head_, head + 1);
+        return buffer;
+      }
+
+      /// @brief Is the ring empty?
+      ///
+      /// Exact only when called by the consumer thread.  Any other thread
+      /// sees a value that was true at some point.
+      bool isEmpty()const
+      {
+        return atomic_load_acquire(&head_) == atomic_load_acquire(&tail_);
+      }
+
+    private:
+      BufferRing(const BufferRing &); // no copy
+      BufferRing & operator=(const BufferRing &); // no assignment
+
+    private:
+      /// @brief Assumed size of a cache line.
+      static const size_t CACHE_LINE = 64;
+
+      // Read-only after construction.
+      LinkedBuffer ** slots_;
+      size_t mask_;
+      char pad0_[CACHE_LINE - sizeof(LinkedBuffer **) - sizeof(size_t)];
+
+      // Consumer's line.
+      /// @brief Count of buffers popped.
+      volatile size_t head_;
+      /// @brief Consumer's copy of tail_ as of the last time it looked.
+      size_t tailCache_;
+      char pad1_[CACHE_LINE - 2 * sizeof(size_t)];
+
+      // Producer's line.
+      /// @brief Count of buffers pushed.
+      volatile size_t tail_;
+      /// @brief Producer's copy of head_ as of the last time it looked.
+      size_t headCache_;
+      char pad2_[CACHE_LINE - 2 * sizeof(size_t)];
+    };
+  }
+}
+#endif // BUFFERRING_H
@@ -0,0 +1,659 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef BUSYPOLLRECEIVER_H
+#define BUSYPOLLRECEIVER_H
+// All inline, do not export.
+//#include <Common/QuickFAST_Export.h>
+#include "BusyPollReceiver_fwd.h"
+#include <Communication/SynchReceiver.h>
+#include <Communication/BufferRing.h>
+#include <Common/ThreadAffinity.h>
+#include <Common/AtomicOps.h>
+#include <boost/asio.hpp>
+#if !defined(_WIN32)
+# include <sys/select.h>
+#endif // _WIN32
+
+namespace QuickFAST
+{
+  namespace Communication
+  {
+    /// @brief Receive multicast packets on a dedicated thread that spins on a non-blocking socket.
+    ///
+    /// No io_service is run.  The thread that calls run() (or the thread started
+    /// by runThreads()) polls the socket and passes each packet to the Assembler
+    /// on the same thread, so there is no reactor wakeup or thread handoff per packet.
+    /// Buffers released by the Assembler are reused directly, so no lock is taken
+    /// per packet.  The buffer mutex is used only when the Assembler is holding
+    /// every buffer the polling thread has.
+    ///
+    /// Packets are delivered one at a time through getBuffer(), so use an Assembler
+    /// that handles whole packets (MessagePerPacketAssembler or PacketSequencingAssembler).
+    ///
+    /// The thread may be pinned to a CPU via setCpu().  By default it spins forever;
+    /// setSpinLimit() lets it block in select() after a number of empty polls.
+    ///
+    /// Optionally (see setDecodeThread()) runThreads() uses two threads: one receives
+    /// and one decodes.  Buffers pass between them through a pair of BufferRings so
+    /// the threads share no lock.  Only the decoding thread calls the Assembler:
+    /// receive errors are passed to it through the ring.
+    ///
+    /// stop(), pause() and resume() may be called from any thread.
+    class BusyPollReceiver
+      : public SynchReceiver
+    {
+    public:
+      /// @brief Construct given multicast information.
+      /// @param multicastGroupIP multicast address as a text string
+      /// @param listenInterfaceIP listen address as a text string
+      /// @param bindIP is the IP address to which the socket will be bound
+      /// @param portNumber port number
+      BusyPollReceiver(
+        const std::string & multicastGroupIP,
+        const std::string & listenInterfaceIP,
+        const std::string & bindIP,
+        unsigned short portNumber
+        )
+        : listenInterface_(boost::asio::ip::address::from_string(listenInterfaceIP))
+        , portNumber_(portNumber)
+        , multicastGroup_(boost::asio::ip::address::from_string(multicastGroupIP))
+        , bindAddress_(boost::asio::ip::address::from_string(bindIP))
+        , endpoint_(listenInterface_, portNumber)
+        , socket_(ioService_)
+        , pending_(0)
+        , ready_(0)
+        , starved_(false)
+        , cpu_(-1)
+        , spinLimit_(0)
+        , busyPoll_(0)
+        , separateDecode_(false)
+        , decodeCpu_(-1)
+      {
+      }
+
+      ~BusyPollReceiver()
+      {
+        // the polling thread uses socket_, so stop it before socket_ is destroyed.
+        stop();
+        joinThreads();
+        boost::system::error_code error;
+        socket_.close(error);
+      }
+
+      /// @brief Pin the polling thread to a CPU.
+      ///
+      /// Takes effect when run() is called.  Supported on Linux and Windows.
+      /// @param cpu is the zero-based CPU number.  Negative means do not pin.
+      void setCpu(int cpu)
+      {
+        cpu_ = cpu;
+      }
+
+      /// @brief Block after spinning without receiving a packet.
+      ///
+      /// After spinLimit consecutive empty polls the thread waits in select()
+      /// until the socket is readable (or a tenth of a second passes so stop()
+      /// is noticed) then resumes spinning.
+      /// @param spinLimit is the number of empty polls before blocking.  Zero means spin forever.
+      void setSpinLimit(size_t spinLimit)
+      {
+        spinLimit_ = spinLimit;
+      }
+
+      /// @brief Ask the kernel to busy poll the device queue (SO_BUSY_POLL).
+      ///
+      /// Linux only.  Ignored elsewhere.  Set before calling start().
+      /// @param microseconds is how long the kernel may busy poll per receive.  Zero disables it.
+      void setBusyPoll(int microseconds)
+      {
+        busyPoll_ = microseconds;
+      }
+
+      /// @brief Receive and decode on separate threads.
+      ///
+      /// Takes effect in runThreads().  The receiving thread is pinned to the CPU
+      /// given to setCpu(); the decoding thread to decodeCpu.  Filled buffers go
+      /// to the decoding thread and empty ones come back through lock-free
+      /// single-producer/single-consumer BufferRings.  When the decoding thread
+      /// runs out of work it spins, yielding after spinLimit empty polls.
+      ///
+      /// Buffers added by addBuffers() after runThreads() is called are not used.
+      /// run(), run_one(), and poll() always receive and decode on the calling thread.
+      /// @param separate is true to use a separate decoding thread.
+      /// @param decodeCpu is the CPU for the decoding thread.  Negative means do not pin.
+      void setDecodeThread(bool separate, int decodeCpu = -1)
+      {
+        separateDecode_ = separate;
+        decodeCpu_ = decodeCpu;
+      }
+
+      ////////////////////////////////////
+      // Implement Receiver public methods
+      virtual void stop()
+      {
+        atomic_store_release(&stopping_, true);
+      }
+
+      virtual void pause()
+      {
+        atomic_store_release(&paused_, true);
+      }
+
+      virtual void resume()
+      {
+        atomic_store_release(&paused_, false);
+      }
+
+      virtual void run()
+      {
+        if(!pinThread(cpu_))
+        {
+          reportError(pinError());
+        }
+        while(!isStopping())
+        {
+          run_one();
+        }
+      }
+
+      virtual void run_one()
+      {
+        size_t idle = 0;
+        while(!isStopping() && !receivePending())
+        {
+          if(spinLimit_ != 0 && ++idle >= spinLimit_)
+          {
+            waitReadable();
+            idle = 0;
+          }
+        }
+        serviceReady();
+      }
+
+      virtual size_t poll()
+      {
+        size_t count = 0;
+        while(poll_one() != 0)
+        {
+          ++count;
+        }
+        return count;
+      }
+
+      virtual size_t poll_one()
+      {
+        size_t count = 0;
+        if(!isStopping() && receivePending())
+        {
+          serviceReady();
+          ++count;
+        }
+        return count;
+      }
+
+      virtual void resetService()
+      {
+        atomic_store_release(&stopping_, false);
+        atomic_store_release(&paused_, false);
+      }
+
+      virtual void runThreads(size_t threadCount = 0, bool useThisThread = true)
+      {
+        if(!separateDecode_)
+        {
+          SynchReceiver::runThreads(threadCount, useThisThread);
+          return;
+        }
+        // Every buffer fits in either ring, so push() never fails.
+        filled_.reset(new BufferRing(bufferLifetimes_.size()));
+        recycled_.reset(new BufferRing(bufferLifetimes_.size()));
+        {
+          boost::mutex::scoped_lock lock(bufferMutex_);
+          if(pending_ != 0)
+          {
+            idleBufferPool_.push(pending_);
+            pending_ = 0;
+          }
+          idleBufferPool_.push(idleBuffers_);
+          for(LinkedBuffer * buffer = idleBufferPool_.pop(); buffer != 0; buffer = idleBufferPool_.pop())
+          {
+            recycled_->push(buffer);
+          }
+        }
+        decodeThread_.reset(new boost::thread(boost::bind(&BusyPollReceiver::decodeLoop, this)));
+        if(useThisThread)
+        {
+          receiveLoop();
+        }
+        else
+        {
+          receiveThread_.reset(new boost::thread(boost::bind(&BusyPollReceiver::receiveLoop, this)));
+        }
+      }
+
+      virtual void joinThreads()
+      {
+        if(bool(receiveThread_))
+        {
+          receiveThread_->join();
+          receiveThread_.reset();
+        }
+        if(bool(decodeThread_))
+        {
+          decodeThread_->join();
+          decodeThread_.reset();
+        }
+        if(bool(filled_))
+        {
+          // Both threads are finished.  Return the buffers to the pool.
+          boost::mutex::scoped_lock lock(bufferMutex_);
+          idleBufferPool_.push(idleBuffers_);
+          for(LinkedBuffer * buffer = filled_->pop(); buffer != 0; buffer = filled_->pop())
+          {
+            idleBufferPool_.push(buffer);
+          }
+          for(LinkedBuffer * buffer = recycled_->pop(); buffer != 0; buffer = recycled_->pop())
+          {
+            idleBufferPool_.push(buffer);
+          }
+          if(pending_ != 0)
+          {
+            idleBufferPool_.push(pending_);
+            pending_ = 0;
+          }
+          filled_.reset();
+          recycled_.reset();
+        }
+        SynchReceiver::joinThreads();
+      }
+
+      /////////////////////////////
+      // Assembler support routines
+      virtual LinkedBuffer * getBuffer(bool wait)
+      {
+        LinkedBuffer * next = 0;
+        if(!filled_)
+        {
+          // Called on the polling thread.
+          next = ready_;
+          ready_ = 0;
+          while(next == 0 && wait && !isStopping())
+          {
+            if(receivePending())
+            {
+              next = ready_;
+              ready_ = 0;
+            }
+          }
+        }
+        else
+        {
+          // Called on the decoding thread.
+          recycle();
+          next = filled_->pop();
+          while((next == 0 && wait && !isStopping()) || (next != 0 && next->checkAnyFlag(RECEIVE_ERROR)))
+          {
+            if(next != 0)
+            {
+              reportReceiveError(next);
+            }
+            next = filled_->pop();
+          }
+        }
+        if(next != 0)
+        {
+          ++packetsProcessed_;
+          bytesProcessed_ += next->used();
+        }
+        return next;
+      }
+
+    private:
+      // Implement Receiver method
+      virtual bool initializeReceiver()
+      {
+        socket_.open(endpoint_.protocol());
+        socket_.set_option(boost::asio::ip::udp::socket::reuse_address(true));
+        boost::asio::ip::udp::endpoint bindpoint(bindAddress_, portNumber_);
+        socket_.bind(bindpoint);
+
+        // Join the multicast group
+        boost::asio::ip::multicast::join_group joinRequest(
+          multicastGroup_.to_v4(),
+          listenInterface_.to_v4());
+        socket_.set_option(joinRequest);
+        socket_.non_blocking(true);
+#if defined(SO_BUSY_POLL)
+        if(busyPoll_ > 0)
+        {
+          ::setsockopt(socket_.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &busyPoll_, sizeof(busyPoll_));
+        }
+#endif // SO_BUSY_POLL
+        return true;
+      }
+
+      // Implement Receiver method
+      // Only one buffer waits for a packet.
+      virtual bool canStartRead()
+      {
+        return pending_ == 0;
+      }
+
+      // Implement Receiver method
+      // The buffer is read by receivePending() on the polling thread.
+      bool fillBuffer(LinkedBuffer * buffer, boost::mutex::scoped_lock& /*lock*/)
+      {
+        pending_ = buffer;
+        return true;
+      }
+
+      /// @brief Has stop() been called?
+      bool isStopping()const
+      {
+        return atomic_load_acquire(&stopping_);
+      }
+
+      /// @brief Has pause() been called without a resume()?
+      bool isPaused()const
+      {
+        return atomic_load_acquire(&paused_);
+      }
+
+      /// @brief Try once to receive a packet into the pending buffer.
+      ///
+      /// A packet with data becomes ready_ for the Assembler.
+      /// @returns true if a packet (or an error) was received.
+      bool receivePending()
+      {
+        if(pending_ == 0)
+        {
+          pending_ = idleBuffers_.pop();
+          if(pending_ == 0)
+          {
+            // The Assembler has the buffers this thread was using.  Look for more.
+            boost::mutex::scoped_lock lock(bufferMutex_);
+            pending_ = idleBufferPool_.pop();
+          }
+          if(pending_ == 0)
+          {
+            if(!starved_)
+            {
+              ++noBufferAvailable_;
+              starved_ = true;
+            }
+            return false;
+          }
+          starved_ = false;
+        }
+        boost::system::error_code error;
+        size_t bytesReceived = socket_.receive(
+          boost::asio::buffer(pending_->get(), pending_->capacity()),
+          0,
+          error);
+        if(error == boost::asio::error::would_block)
+        {
+          return false;
+        }
+
+        LinkedBuffer * buffer = pending_;
+        pending_ = 0;
+        ++packetsReceived_;
+        if(error)
+        {
+          idleBuffers_.push(buffer);
+          if(!isPaused() && !isStopping())
+          {
+            ++errorPackets_;
+            reportError(error.message());
+          }
+        }
+        else if(isPaused())
+        {
+          ++pausedPackets_;
+          idleBuffers_.push(buffer);
+        }
+        else if(bytesReceived == 0)
+        {
+          ++emptyPackets_;
+          idleBuffers_.push(buffer);
+        }
+        else
+        {
+          ++packetsQueued_;
+          bytesReceived_ += bytesReceived;
+          largestPacket_ = std::max(largestPacket_, bytesReceived);
+          buffer->setUsed(bytesReceived);
+          ready_ = buffer;
+        }
+        return true;
+      }
+
+      /// @brief Pass the ready packet (if any) to the Assembler.
+      void serviceReady()
+      {
+        if(ready_ != 0)
+        {
+          ++batchesProcessed_;
+          if(!assembler_->serviceQueue(*this))
+          {
+            stop();
+          }
+          if(ready_ != 0)
+          {
+            // not wanted.
+            idleBuffers_.push(ready_);
+            ready_ = 0;
+          }
+        }
+      }
+
+      /// @brief Report an error to the Assembler.  Call from the thread that uses the Assembler.
+      void reportError(const std::string & message)
+      {
+        if(!assembler_->reportCommunicationError(message))
+        {
+          stop();
+        }
+      }
+
+      /// @brief The receiving thread when decoding on a separate thread.
+      void receiveLoop()
+      {
+        LinkedBuffer * buffer = 0;
+        bool pinned = pinThread(cpu_);
+        bool starved = false;
+        size_t idle = 0;
+        while(!isStopping())
+        {
+          if(buffer == 0)
+          {
+            buffer = recycled_->pop();
+            if(buffer == 0)
+            {
+              // The decoder has all the buffers.
+              if(!starved)
+              {
+                ++noBufferAvailable_;
+                starved = true;
+              }
+              continue;
+            }
+            starved = false;
+          }
+          if(!pinned)
+          {
+            sendError(buffer, pinError());
+            buffer = 0;
+            pinned = true;
+            continue;
+          }
+          boost::system::error_code error;
+          size_t bytesReceived = socket_.receive(
+            boost::asio::buffer(buffer->get(), buffer->capacity()),
+            0,
+            error);
+          if(error == boost::asio::error::would_block)
+          {
+            if(spinLimit_ != 0 && ++idle >= spinLimit_)
+            {
+              waitReadable();
+              idle = 0;
+            }
+            continue;
+          }
+          idle = 0;
+          ++packetsReceived_;
+          if(error)
+          {
+            if(!isPaused() && !isStopping())
+            {
+              ++errorPackets_;
+              sendError(buffer, error.message());
+              buffer = 0;
+            }
+          }
+          else if(isPaused())
+          {
+            ++pausedPackets_;
+          }
+          else if(bytesReceived == 0)
+          {
+            ++emptyPackets_;
+          }
+          else
+          {
+            ++packetsQueued_;
+            bytesReceived_ += bytesReceived;
+            largestPacket_ = std::max(largestPacket_, bytesReceived);
+            buffer->setUsed(bytesReceived);
+            filled_->push(buffer);
+            buffer = 0;
+          }
+        }
+        // joinThreads() returns it to the pool.
+        pending_ = buffer;
+      }
+
+      /// @brief The decoding thread when decoding on a separate thread.
+      void decodeLoop()
+      {
+        if(!pinThread(decodeCpu_))
+        {
+          reportError(pinError());
+        }
+        size_t idle = 0;
+        while(!isStopping())
+        {
+          if(filled_->isEmpty())
+          {
+            if(spinLimit_ != 0 && ++idle >= spinLimit_)
+            {
+              boost::this_thread::yield();
+              idle = 0;
+            }
+            continue;
+          }
+          idle = 0;
+          ++batchesProcessed_;
+          if(!assembler_->serviceQueue(*this))
+          {
+            stop();
+          }
+          recycle();
+        }
+      }
+
+      /// @brief Pass an error from the receiving thread to the decoding thread.
+      /// @param buffer carries the message.  It is returned by the decoding thread.
+      /// @param message describes the error
+      void sendError(LinkedBuffer * buffer, const std::string & message)
+      {
+        size_t length = std::min(message.size(), buffer->capacity());
+        std::memcpy(buffer->get(), message.data(), length);
+        buffer->setUsed(length);
+        buffer->setFlag(RECEIVE_ERROR);
+        filled_->push(buffer);
+      }
+
+      /// @brief Report an error sent by sendError() on the decoding thread.
+      /// @param buffer carries the message
+      void reportReceiveError(LinkedBuffer * buffer)
+      {
+        std::string message(reinterpret_cast<const char *>(buffer->get()), buffer->used());
+        buffer->clearFlag(RECEIVE_ERROR);
+        idleBuffers_.push(buffer);
+        reportError(message);
+      }
+
+      /// @brief Return buffers released by the Assembler to the receiving thread.
+      void recycle()
+      {
+        for(LinkedBuffer * buffer = idleBuffers_.pop(); buffer != 0; buffer = idleBuffers_.pop())
+        {
+          recycled_->push(buffer);
+        }
+      }
+
+      /// @brief Block until the socket is readable or a tenth of a second passes.
+      void waitReadable()
+      {
+        boost::asio::ip::udp::socket::native_handle_type handle = socket_.native_handle();
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(handle, &readable);
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 100000;
+        ::select(int(handle) + 1, &readable, 0, 0, &timeout);
+      }
+
+      /// @brief Pin the calling thread to a CPU if requested.
+      /// @param cpu is the CPU number.  Negative means do not pin.
+      /// @returns false if the thread could not be pinned.
+      bool pinThread(int cpu)
+      {
+        return cpu < 0 || pinThreadToCpu(cpu);
+      }
+
+      static std::string pinError()
+      {
+        return "BusyPollReceiver: Cannot pin thread to CPU.";
+      }
+
+    private:
+      /// Marks a buffer that carries an error message rather than a packet.
+      static const uint32 RECEIVE_ERROR = 0x80000000;
+      boost::asio::ip::address listenInterface_;
+      unsigned short portNumber_;
+      boost::asio::ip::address multicastGroup_;
+      boost::asio::ip::address bindAddress_;
+      boost::asio::ip::udp::endpoint endpoint_;
+      /// Owns the socket.  Never run.
+      boost::asio::io_service ioService_;
+      boost::asio::ip::udp::socket socket_;
+      /// The buffer that will receive the next packet.
+      LinkedBuffer * pending_;
+      /// A received packet waiting for the Assembler (when decoding on the polling thread).
+      LinkedBuffer * ready_;
+      /// True when the polling thread has no buffer.
+      bool starved_;
+      int cpu_;
+      size_t spinLimit_;
+      int busyPoll_;
+      bool separateDecode_;
+      int decodeCpu_;
+      /// Filled buffers on their way to the decoding thread.
+      boost::scoped_ptr<BufferRing> filled_;
+      /// Empty buffers on their way back to the receiving thread.
+      boost::scoped_ptr<BufferRing> recycled_;
+      boost::scoped_ptr<boost::thread> receiveThread_;
+      boost::scoped_ptr<boost::thread> decodeThread_;
+    };
+  }
+}
+#endif // BUSYPOLLRECEIVER_H
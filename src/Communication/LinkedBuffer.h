@@ -39,6 +39,7 @@ namespace QuickFAST
         , used_(0)
         , extra_(0)
         , flags_(0)
+        , source_(0)
       {
       }
 
@@ -52,6 +53,8 @@ namespace QuickFAST
         , capacity_(0)
         , used_(0)
         , extra_(0)
+        , flags_(0)
+        , source_(0)
       {
       }
 
@@ -65,6 +68,8 @@ namespace QuickFAST
         , capacity_(0)
         , used_(used)
         , extra_(extra)
+        , flags_(0)
+        , source_(0)
       {
       }
 
@@ -209,6 +214,23 @@ namespace QuickFAST
         return flags_;
       }
 
+      /// @brief Identify where this buffer was filled.
+      ///
+      /// For example a MulticastReceiver records the index of the feed
+      /// (the A or B line) that received the packet.
+      /// @param source identifies the source.  Zero by default.
+      void setSource(size_t source)
+      {
+        source_ = source;
+      }
+
+      /// @brief Where was this buffer filled?
+      /// @returns the value set by setSource()
+      size_t source()const
+      {
+        return source_;
+      }
+
     private:
       LinkedBuffer * link_;
       unsigned char * buffer_;
@@ -216,6 +238,7 @@ namespace QuickFAST
       size_t used_;
       void * extra_;
       uint32 flags_;
+      size_t source_;
     };
 
   }
@@ -12,6 +12,22 @@
 #include "MulticastReceiver_fwd.h"
 #include <Communication/AsynchReceiver.h>
 
+/// @brief Is recvmmsg() available to receive several datagrams per system call?
+///
+/// Defined as 1 on Linux.  Define QUICKFAST_NO_RECVMMSG to disable it.
+#ifndef QUICKFAST_RECVMMSG
+# if defined(__linux__) && !defined(QUICKFAST_NO_RECVMMSG)
+#   define QUICKFAST_RECVMMSG 1
+# else
+#   define QUICKFAST_RECVMMSG 0
+# endif
+#endif // QUICKFAST_RECVMMSG
+
+#if QUICKFAST_RECVMMSG
+# include <sys/socket.h>
+# include <errno.h>
+#endif // QUICKFAST_RECVMMSG
+
 namespace QuickFAST
 {
   namespace Communication
@@ -28,6 +44,7 @@ namespace QuickFAST
         MulticastFeed(
           MulticastReceiver & parent,
           AsioService & ioService,
+          size_t index,
           const std::string & name,
           const std::string & multicastGroupIP,
           const std::string & listenInterfaceIP,
@@ -35,6 +52,7 @@ namespace QuickFAST
           unsigned short portNumber
           )
         : parent_(parent)
+        , index_(index)
         , name_(name)
         , listenInterface_(boost::asio::ip::address::from_string(listenInterfaceIP))
         , portNumber_(portNumber)
@@ -80,6 +98,33 @@ namespace QuickFAST
             return false;
           }
           readInProgress_ = true;
+          buffer->setSource(index_);
+#if QUICKFAST_RECVMMSG
+          if(parent_.receiveBatch_ > 1)
+          {
+            // Collect idle buffers for the batch.  The caller holds the lock.
+            batch_.clear();
+            batch_.push_back(buffer);
+            while(batch_.size() < parent_.receiveBatch_)
+            {
+              LinkedBuffer * more = parent_.idleBufferPool_.pop();
+              if(more == 0)
+              {
+                break;
+              }
+              more->setSource(index_);
+              batch_.push_back(more);
+            }
+            // Wait for the socket to become readable, then read the batch.
+            socket_.async_receive(
+              boost::asio::null_buffers(),
+              boost::bind(&MulticastFeed::handleReadable,
+                this,
+                boost::asio::placeholders::error)
+              );
+            return true;
+          }
+#endif // QUICKFAST_RECVMMSG
 //          std::cout << "Start read on feed: " << name_ << std::endl;
           socket_.async_receive_from(
             boost::asio::buffer(buffer->get(), buffer->capacity()),
@@ -102,6 +147,63 @@ namespace QuickFAST
           assert(readInProgress_);
           readInProgress_ = false;
           parent_.handleReceive(error, buffer, bytesReceived);
+          checkStopping();
+        }
+
+#if QUICKFAST_RECVMMSG
+        void handleReadable(const boost::system::error_code& error)
+        {
+          assert(readInProgress_);
+          readInProgress_ = false;
+          size_t count = batch_.size();
+          lengths_.assign(count, 0);
+          errors_.assign(count, boost::system::error_code());
+          size_t filled = 0;
+          boost::system::error_code result = error;
+          if(!error)
+          {
+            messages_.resize(count);
+            iovecs_.resize(count);
+            for(size_t nBuffer = 0; nBuffer < count; ++nBuffer)
+            {
+              iovecs_[nBuffer].iov_base = batch_[nBuffer]->get();
+              iovecs_[nBuffer].iov_len = batch_[nBuffer]->capacity();
+              std::memset(&messages_[nBuffer], 0, sizeof(messages_[nBuffer]));
+              messages_[nBuffer].msg_hdr.msg_iov = &iovecs_[nBuffer];
+              messages_[nBuffer].msg_hdr.msg_iovlen = 1;
+            }
+            int received = ::recvmmsg(socket_.native_handle(), &messages_[0], unsigned(count), MSG_DONTWAIT, 0);
+            if(received >= 0)
+            {
+              filled = size_t(received);
+              for(size_t nBuffer = 0; nBuffer < filled; ++nBuffer)
+              {
+                lengths_[nBuffer] = messages_[nBuffer].msg_len;
+                if((messages_[nBuffer].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+                {
+                  // The datagram was bigger than the buffer.
+                  errors_[nBuffer] = boost::asio::error::message_size;
+                }
+              }
+            }
+            else if(errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+              result = boost::system::error_code(errno, boost::system::system_category());
+            }
+          }
+          if(result)
+          {
+            // report the error via the first buffer.
+            errors_[0] = result;
+            filled = 1;
+          }
+          parent_.handleReceiveBatch(&errors_[0], &batch_[0], &lengths_[0], filled, count);
+          checkStopping();
+        }
+#endif // QUICKFAST_RECVMMSG
+
+        void checkStopping()
+        {
           if(parent_.stopping_)
           {
             if(joined_)
@@ -204,6 +306,8 @@ namespace QuickFAST
         MulticastFeed & operator =(const MulticastFeed &);
       private:
         MulticastReceiver & parent_;
+        /// Position in the parent's feeds; recorded in each buffer as its source.
+        size_t index_;
         std::string name_;
         boost::asio::ip::address listenInterface_;
         unsigned short portNumber_;
@@ -214,6 +318,16 @@ namespace QuickFAST
         boost::asio::ip::udp::socket socket_;
         bool joined_;
         bool readInProgress_;
+        /// Buffers to be filled by one batch read
+        std::vector<LinkedBuffer *> batch_;
+        /// How many bytes were received in each buffer in batch_
+        std::vector<size_t> lengths_;
+        /// The status of the receive into each buffer in batch_
+        std::vector<boost::system::error_code> errors_;
+#if QUICKFAST_RECVMMSG
+        std::vector<mmsghdr> messages_;
+        std::vector<iovec> iovecs_;
+#endif // QUICKFAST_RECVMMSG
       };
       typedef boost::shared_ptr<MulticastFeed> MulticastFeedPtr;
       typedef std::vector<MulticastFeedPtr> MulticastFeedVector;
@@ -223,12 +337,14 @@ namespace QuickFAST
       /// @brief Construct
       MulticastReceiver()
         : AsynchReceiver()
+        , receiveBatch_(1)
       {
       }
 
       /// @brief construct given shared io_service
       MulticastReceiver(boost::asio::io_service & ioService)
         : AsynchReceiver(ioService)
+        , receiveBatch_(1)
       {
       }
 
@@ -246,6 +362,7 @@ namespace QuickFAST
         unsigned short portNumber
         )
         : AsynchReceiver()
+        , receiveBatch_(1)
       {
         addFeed(
          "default",
@@ -270,6 +387,7 @@ namespace QuickFAST
         unsigned short portNumber
         )
         : AsynchReceiver(ioService)
+        , receiveBatch_(1)
       {
         addFeed(
          "default",
@@ -288,6 +406,10 @@ namespace QuickFAST
       ///
       /// Warning: All feeds must be added before initializeReceiver is called.
       ///
+      /// Each buffer filled by this feed has its source set to the feed's index
+      /// (0 for the first feed added, 1 for the next, ...) so an A/B arbitrating
+      /// Assembler can tell the lines apart.  See LinkedBuffer::source().
+      ///
       /// @param name to identitify this feed in display/log messages.
       /// @param multicastGroupIP multicast address as a text string
       /// @param listenInterfaceIP listen address as a text string.
@@ -303,10 +425,33 @@ namespace QuickFAST
         unsigned short portNumber
         )
       {
-        MulticastFeedPtr feed(new MulticastFeed(*this, ioService_, name, multicastGroupIP, listenInterfaceIP, bindIP, portNumber));
+        MulticastFeedPtr feed(new MulticastFeed(*this, ioService_, feeds_.size(), name, multicastGroupIP, listenInterfaceIP, bindIP, portNumber));
         feeds_.push_back(feed);
       }
 
+      /// @brief Receive up to batchSize datagrams per system call.
+      ///
+      /// When the socket becomes readable the feed reads as many datagrams as
+      /// are waiting (up to batchSize) into idle buffers with one recvmmsg() call
+      /// and queues them all at once.  Allocate at least batchSize buffers per
+      /// feed when starting the receiver.  A datagram too big for its buffer is
+      /// discarded and reported via Assembler::reportCommunicationError().
+      ///
+      /// Only available where QUICKFAST_RECVMMSG is true (Linux).  Elsewhere
+      /// the batch size is ignored and each datagram is received separately.
+      /// Set before calling start().
+      /// @param batchSize is the maximum number of datagrams per read.  1 disables batching.
+      void setReceiveBatch(size_t batchSize)
+      {
+        receiveBatch_ = std::max(batchSize, size_t(1));
+      }
+
+      /// @brief The maximum number of datagrams per read.
+      size_t receiveBatch()const
+      {
+        return receiveBatch_;
+      }
+
       // Implement Receiver method
       virtual bool initializeReceiver()
       {
@@ -412,6 +557,7 @@ namespace QuickFAST
 
     private:
       MulticastFeedVector feeds_;
+      size_t receiveBatch_;
     };
   }
 }
@@ -16,6 +16,7 @@
 
 #include <Examples/StopWatch.h>
 #include <Common/Profiler.h>
+#include <Common/StopBitScanner.h>
 
 using namespace QuickFAST;
 using namespace Examples;
@@ -112,6 +113,25 @@ PerformanceTest::parseSingleArg(int argc, char * argv[])
       echo_ = true;
       consumed = 1;
     }
+    else if(opt == "-scan" && argc > 1)
+    {
+      std::string scanner(argv[1]);
+      if(scanner == "scalar")
+      {
+        StopBitScanner::setImplementation(StopBitScanner::SCALAR);
+        consumed = 2;
+      }
+      else if(scanner == "sse2")
+      {
+        StopBitScanner::setImplementation(StopBitScanner::SSE2);
+        consumed = 2;
+      }
+      else if(scanner == "avx2")
+      {
+        StopBitScanner::setImplementation(StopBitScanner::AVX2);
+        consumed = 2;
+      }
+    }
   }
   catch (std::exception & ex)
   {
@@ -135,6 +155,7 @@ PerformanceTest::usage(std::ostream & out) const
   out << "  -null       : Use null message to receive fields." << std::endl;
   out << "  -s          : Toggle 'strict decoding rules' (default true)." << std::endl;
   out << "  -hfix n     : Skip n byte header before each message" << std::endl;
+  out << "  -scan type  : Stop bit scanner: scalar, sse2, or avx2 (default: best available)" << std::endl;
   out << std::endl;
   out << " THE FOLLOWING INVALIDATES THE PERFORMANCE TEST NUMBERS, OF COURSE." << std::endl;
   out << "  -e          : Echo input to standard out in hex; include message and field boundaries (for debugging)" << std::endl;
@@ -0,0 +1,161 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+
+#include <Examples/ExamplesPch.h>
+#include "TemplateCompiler.h"
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/TemplateCodeGenerator.h>
+
+using namespace QuickFAST;
+using namespace Examples;
+
+TemplateCompiler::TemplateCompiler()
+  : nameSpace_("FASTDecoder")
+{
+}
+
+TemplateCompiler::~TemplateCompiler()
+{
+}
+
+bool
+TemplateCompiler::init(int argc, char* argv[])
+{
+  commandArgParser_.addHandler(this);
+  return commandArgParser_.parse(argc, argv);
+}
+
+int
+TemplateCompiler::parseSingleArg(int argc, char * argv[])
+{
+  int consumed = 0;
+  std::string opt(argv[0]);
+  try
+  {
+    if(opt == "-t" && argc > 1)
+    {
+      templateFileName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-o" && argc > 1)
+    {
+      outputName_ = argv[1];
+      consumed = 2;
+    }
+    else if(opt == "-n" && argc > 1)
+    {
+      nameSpace_ = argv[1];
+      consumed = 2;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << " while interpreting " << opt << std::endl;
+    consumed = 0;
+  }
+  return consumed;
+}
+
+void
+TemplateCompiler::usage(std::ostream & out) const
+{
+  out << "  -t file     : Template file (required)" << std::endl;
+  out << "  -o name     : Output base name.  Writes name.h and name.cpp (required)" << std::endl;
+  out << "  -n ns       : C++ namespace for the generated code (default FASTDecoder)" << std::endl;
+}
+
+bool
+TemplateCompiler::applyArgs()
+{
+  bool ok = true;
+  try
+  {
+    if(templateFileName_.empty())
+    {
+      ok = false;
+      std::cerr << "ERROR: -t [templatefile] option is required." << std::endl;
+    }
+    if(ok)
+    {
+      templateFile_.open(templateFileName_.c_str(), std::ios::in
+#ifdef _WIN32
+        | std::ios::binary
+#endif
+        );
+
+      if(!templateFile_.good())
+      {
+        ok = false;
+        std::cerr << "ERROR: Can't open template file: "
+          << templateFileName_
+          << std::endl;
+      }
+    }
+    if(outputName_.empty())
+    {
+      ok = false;
+      std::cerr << "ERROR: -o [name] option is required." << std::endl;
+    }
+  }
+  catch (std::exception & ex)
+  {
+    std::cerr << ex.what() << std::endl;
+    ok = false;
+  }
+
+  if(!ok)
+  {
+    commandArgParser_.usage(std::cerr);
+  }
+  return ok;
+}
+
+int
+TemplateCompiler::run()
+{
+  int result = 0;
+  try
+  {
+    Codecs::XMLTemplateParser parser;
+    Codecs::TemplateRegistryPtr templateRegistry = parser.parse(templateFile_);
+
+    std::string headerName = outputName_ + ".h";
+    std::string sourceName = outputName_ + ".cpp";
+    // the generated source includes the header from the same directory
+    std::string::size_type slash = headerName.find_last_of("/\\");
+    Codecs::TemplateCodeGenerator generator(templateRegistry, nameSpace_);
+    generator.setHeaderName(slash == std::string::npos ? headerName : headerName.substr(slash + 1));
+
+    std::ofstream header(headerName.c_str());
+    std::ofstream source(sourceName.c_str());
+    if(!header.good() || !source.good())
+    {
+      std::cerr << "ERROR: Can't open output files: " << headerName << ", " << sourceName << std::endl;
+      return -1;
+    }
+    generator.generateHeader(header);
+    generator.generateSource(source);
+
+    const std::vector<std::string> & skipped = generator.getSkippedTemplates();
+    for(size_t nSkip = 0; nSkip < skipped.size(); ++nSkip)
+    {
+      std::cerr << "WARNING: Skipped template " << skipped[nSkip] << std::endl;
+    }
+    std::cout << "Generated " << templateRegistry->size() - skipped.size()
+      << " of " << templateRegistry->size() << " templates into "
+      << headerName << " and " << sourceName << std::endl;
+  }
+  catch (std::exception & e)
+  {
+    std::cerr << e.what() << std::endl;
+    result = -1;
+  }
+  return result;
+}
+
+void
+TemplateCompiler::fini()
+{
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+//
+#ifndef TEMPLATECOMPILER_H
+#define TEMPLATECOMPILER_H
+
+#include <Codecs/XMLTemplateParser.h>
+#include <Application/CommandArgParser.h>
+
+namespace QuickFAST{
+  namespace Examples{
+    /// @brief Generate C++ decoding code for a set of templates.
+    ///
+    /// Parses a template file and uses Codecs::TemplateCodeGenerator to write a header
+    /// and a source file containing one struct and one decode function per template.
+    ///
+    /// Run the program with a -? command line option for detailed usage information.
+    class TemplateCompiler : public Application::CommandArgHandler
+    {
+    public:
+      TemplateCompiler();
+      ~TemplateCompiler();
+
+      /// @brief parse command line arguments, and initialize.
+      /// @param argc from main
+      /// @param argv from main
+      /// @returns true if everything is ok.
+      bool init(int argc, char * argv[]);
+      /// @brief run the program
+      /// @returns a value to be used as an exit code of the program (0 means all is well)
+      int run();
+      /// @brief do final cleanup after a run.
+      void fini();
+
+    private:
+      virtual int parseSingleArg(int argc, char * argv[]);
+      virtual void usage(std::ostream & out) const;
+      virtual bool applyArgs();
+    private:
+      std::string templateFileName_;
+      std::ifstream templateFile_;
+      std::string outputName_;
+      std::string nameSpace_;
+      Application::CommandArgParser commandArgParser_;
+    };
+  }
+}
+#endif // TEMPLATECOMPILER_H
@@ -13,11 +13,25 @@
 #include <Common/StringBuffer.h>
 #include <Messages/Group_fwd.h>
 #include <Messages/Sequence_fwd.h>
+#include <Messages/FieldPool.h>
+#if defined(QUICKFAST_ATOMIC_REFCOUNT)
+# include <Common/AtomicCounter.h>
+#endif
 namespace QuickFAST{
   namespace Messages{
     /// @brief The value of a field -- for use in Message and Dictionary.
     ///
     /// An abstract class intended to be specialized into the particular field type.
+    ///
+    /// Fields are reference counted by boost::intrusive_ptr.  By default the count
+    /// is a plain integer, so a field must only be referenced from one thread at a time.
+    /// Define QUICKFAST_ATOMIC_REFCOUNT when building QuickFAST and the application
+    /// to use an atomic count instead.  Then decoded messages may be handed off to another
+    /// thread (see Codecs::MessageWorkerPool) even if the decoding thread still holds some
+    /// of their fields.  Only one thread at a time may read a field, because displayString()
+    /// caches its result in the field.
+    /// Sequences and groups are held by boost::shared_ptr, whose counts are already
+    /// thread-safe.
     class QuickFAST_Export Field
     {
     protected:
@@ -27,6 +41,32 @@ namespace QuickFAST{
       /// @brief a typical virtual destructor.
       virtual ~Field() = 0;
 
+      /// @brief Allocate fields from the FieldPool.
+      /// @param size is the size of the field object
+      static void * operator new(size_t size)
+      {
+        return FieldPool::allocate(size);
+      }
+
+      /// @brief Return fields to the FieldPool.
+      /// @param block is the memory occupied by the field
+      /// @param size is the size of the field object
+      static void operator delete(void * block, size_t size)
+      {
+        FieldPool::release(block, size);
+      }
+
+      /// @brief Was QuickFAST built with QUICKFAST_ATOMIC_REFCOUNT?
+      /// @returns true if a field may be referenced from more than one thread.
+      static bool atomicReferenceCount()
+      {
+#if defined(QUICKFAST_ATOMIC_REFCOUNT)
+        return true;
+#else
+        return false;
+#endif
+      }
+
       /// @brief compare to field for type and value
       ///
       /// The default implementation handles all string, integer, and decimal types.
@@ -339,7 +379,11 @@ namespace QuickFAST{
       friend void QuickFAST_Export intrusive_ptr_add_ref(const Field * ptr);
       friend void QuickFAST_Export intrusive_ptr_release(const Field * ptr);
       virtual void freeField()const;
+#if defined(QUICKFAST_ATOMIC_REFCOUNT)
+      mutable AtomicCounter refcount_;
+#else
       mutable unsigned long refcount_;
+#endif
     };
 
     inline
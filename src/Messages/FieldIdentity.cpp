@@ -10,14 +10,28 @@
 using namespace QuickFAST;
 using namespace Messages;
 
+const FieldIdentity::Handle FieldIdentity::UNINTERNED;
+const size_t FieldIdentity::NO_POSITION;
+
 static
 std::string anonName(void * address)
 {
   return boost::lexical_cast<std::string>(address);
 }
 
+namespace
+{
+  // The intern table maps namespace and qualified name to a handle.
+  typedef std::pair<std::string, std::string> InternKey;
+  typedef std::map<InternKey, FieldIdentity::Handle> InternTable;
+  InternTable internTable;
+  boost::mutex internMutex;
+}
+
 FieldIdentity::FieldIdentity()
   : localName_(anonName(this))
+  , handle_(UNINTERNED)
+  , position_(NO_POSITION)
 {
   qualifyName();
 }
@@ -29,10 +43,29 @@ FieldIdentity::FieldIdentity(
   : localName_(name)
   , fieldNamespace_(fieldNamespace)
   , id_(id)
+  , handle_(UNINTERNED)
+  , position_(NO_POSITION)
 {
   qualifyName();
 }
 
+void
+FieldIdentity::intern()
+{
+  boost::mutex::scoped_lock lock(internMutex);
+  InternKey key(fieldNamespace_, fullName_);
+  InternTable::const_iterator it = internTable.find(key);
+  if(it != internTable.end())
+  {
+    handle_ = it->second;
+  }
+  else
+  {
+    handle_ = static_cast<Handle>(internTable.size() + 1);
+    internTable[key] = handle_;
+  }
+}
+
 
 FieldIdentity::~FieldIdentity()
 {
@@ -15,9 +15,24 @@ namespace QuickFAST{
     ///
     /// Keeping the field's identity separate from it's type and value allows
     /// immutable fields to be shared among different field containers (dictionaries & field sets, &tc.)
+    ///
+    /// An identity may be interned.  Interning assigns a small integer handle that is
+    /// shared by all interned identities with the same name and namespace, so comparing
+    /// two interned identities does not require string comparisons.  The field instructions
+    /// in a template intern their identities when the template is finalized.  Applications
+    /// can intern the identities they use to look up fields in a MessageAccessor.
     class QuickFAST_Export FieldIdentity
     {
     public:
+      /// @brief The integer handle assigned by intern()
+      typedef uint32 Handle;
+
+      /// @brief The handle of an identity that has not been interned.
+      static const Handle UNINTERNED = 0;
+
+      /// @brief The position of an identity that is not part of a template segment.
+      static const size_t NO_POSITION = size_t(-1);
+
       /// @brief Construct the FieldIdentity
       /// @param name the localname for the field
       /// @param fieldNamespace the namespace in which the localname is defined
@@ -37,6 +52,7 @@ namespace QuickFAST{
       {
         localName_ = name;
         qualifyName();
+        handle_ = UNINTERNED;
       }
 
       /// @brief Set Namespace after construction
@@ -45,6 +61,7 @@ namespace QuickFAST{
       {
         fieldNamespace_ = fieldNamespace;
         qualifyName();
+        handle_ = UNINTERNED;
       }
 
       /// @brief Copy construct the FieldIdentity
@@ -54,6 +71,8 @@ namespace QuickFAST{
         , fieldNamespace_(rhs.fieldNamespace_)
         , fullName_(rhs.fullName_)
         , id_(rhs.id_)
+        , handle_(rhs.handle_)
+        , position_(rhs.position_)
       {
       }
 
@@ -92,6 +111,42 @@ namespace QuickFAST{
         return id_;
       }
 
+      /// @brief Assign an integer handle to this identity.
+      ///
+      /// All identities with the same name and namespace receive the same handle.
+      /// Handles are never released, so intern only long-lived identities
+      /// (i.e. not one for every lookup.)  Safe to call from multiple threads.
+      void intern();
+
+      /// @brief Has this identity been interned?
+      bool isInterned()const
+      {
+        return handle_ != UNINTERNED;
+      }
+
+      /// @brief get the handle assigned by intern()
+      /// @returns the handle or UNINTERNED
+      Handle handle()const
+      {
+        return handle_;
+      }
+
+      /// @brief Record the position of the field within the template segment that defines it.
+      ///
+      /// A FieldSet uses the position to find the field without searching.
+      /// @param position is the index of the field instruction in its segment plus the segment's position base.
+      void setPosition(size_t position)
+      {
+        position_ = position;
+      }
+
+      /// @brief get the position of the field within its template segment.
+      /// @returns the position or NO_POSITION
+      size_t position()const
+      {
+        return position_;
+      }
+
       ///@brief Debug: Display the identity on the given output stream.
       /// @param output is where to write the human-readable representation of the identity.
       void display(std::ostream & output)const;
@@ -100,9 +155,15 @@ namespace QuickFAST{
       ///
       /// Equality means names, namespaces, and possibly ids are equal.
       /// ids are considered only if both are specified.
+      /// If both identities are interned the names are compared via their handles.
       /// @param rhs is the identity to be compared to this.
       bool operator == (const FieldIdentity & rhs) const
       {
+        if(handle_ != UNINTERNED && rhs.handle_ != UNINTERNED)
+        {
+          return (handle_ == rhs.handle_) &&
+            (id_.empty() || rhs.id_.empty() || id_ == rhs.id_);
+        }
         return(
           (fieldNamespace_ == rhs.fieldNamespace_) &&
           (fullName_ == rhs.fullName_) &&
@@ -133,6 +194,8 @@ namespace QuickFAST{
       std::string fieldNamespace_;
       std::string fullName_; // cached for performance
       field_id_t id_;
+      Handle handle_;
+      size_t position_;
     };
   }
 }
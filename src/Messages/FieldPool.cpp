@@ -0,0 +1,136 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "FieldPool.h"
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Messages;
+
+const size_t FieldPool::maxPooledSize;
+const size_t FieldPool::maxFree;
+
+namespace
+{
+  const size_t granularity = 16;
+  const size_t sizeClasses = FieldPool::maxPooledSize / granularity + 1;
+
+  /// A released block is linked into the free list through its first word.
+  struct FreeBlock
+  {
+    FreeBlock * next_;
+  };
+
+  /// The free lists and counters for one thread.
+  struct FreeLists
+  {
+    FreeLists()
+    {
+      memset(this, 0, sizeof(*this));
+    }
+
+    ~FreeLists()
+    {
+      for(size_t nClass = 0; nClass < sizeClasses; ++nClass)
+      {
+        while(heads_[nClass] != 0)
+        {
+          FreeBlock * block = heads_[nClass];
+          heads_[nClass] = block->next_;
+          ::operator delete(block);
+        }
+      }
+    }
+
+    FreeBlock * heads_[sizeClasses];
+    size_t counts_[sizeClasses];
+    FieldPool::Statistics statistics_;
+  };
+
+  boost::thread_specific_ptr<FreeLists> & threadLists()
+  {
+    // Allocated on first use and never destroyed: fields with static
+    // storage duration are created during static initialization and
+    // released during static destruction.
+    static boost::thread_specific_ptr<FreeLists> * lists =
+      new boost::thread_specific_ptr<FreeLists>;
+    return *lists;
+  }
+
+  FreeLists & freeLists()
+  {
+    boost::thread_specific_ptr<FreeLists> & lists = threadLists();
+    FreeLists * result = lists.get();
+    if(result == 0)
+    {
+      result = new FreeLists;
+      lists.reset(result);
+    }
+    return *result;
+  }
+
+  inline size_t sizeClass(size_t size)
+  {
+    return (size + granularity - 1) / granularity;
+  }
+}
+
+void *
+FieldPool::allocate(size_t size)
+{
+  if(size > maxPooledSize)
+  {
+    return ::operator new(size);
+  }
+  FreeLists & lists = freeLists();
+  ++lists.statistics_.allocations_;
+  size_t nClass = sizeClass(size);
+  FreeBlock * block = lists.heads_[nClass];
+  if(block != 0)
+  {
+    ++lists.statistics_.hits_;
+    lists.heads_[nClass] = block->next_;
+    --lists.counts_[nClass];
+    return block;
+  }
+  return ::operator new(nClass * granularity);
+}
+
+void
+FieldPool::release(void * block, size_t size)
+{
+  if(block == 0)
+  {
+    return;
+  }
+  if(size > maxPooledSize)
+  {
+    ::operator delete(block);
+    return;
+  }
+  FreeLists & lists = freeLists();
+  ++lists.statistics_.releases_;
+  size_t nClass = sizeClass(size);
+  if(lists.counts_[nClass] >= maxFree)
+  {
+    ::operator delete(block);
+    return;
+  }
+  ++lists.statistics_.recycled_;
+  FreeBlock * freeBlock = static_cast<FreeBlock *>(block);
+  freeBlock->next_ = lists.heads_[nClass];
+  lists.heads_[nClass] = freeBlock;
+  ++lists.counts_[nClass];
+}
+
+void
+FieldPool::getStatistics(Statistics & statistics)
+{
+  statistics = freeLists().statistics_;
+}
+
+void
+FieldPool::resetStatistics()
+{
+  memset(&freeLists().statistics_, 0, sizeof(Statistics));
+}
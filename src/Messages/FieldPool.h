@@ -0,0 +1,168 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef FIELDPOOL_H
+#define FIELDPOOL_H
+#include <Common/QuickFAST_Export.h>
+#include <Common/Types.h>
+
+namespace QuickFAST{
+  namespace Messages{
+    /// @brief Recycle the memory used by Field objects.
+    ///
+    /// Field::operator new and operator delete use this pool, so every
+    /// FieldXxx::create() and Field::freeField() goes through it.
+    ///
+    /// Released blocks are kept on free lists, one for each size class, and reused by
+    /// the next allocation of the same size.  In steady state decoding does not
+    /// call malloc or free for fields.
+    ///
+    /// The free lists belong to the thread that releases the memory, so
+    /// decoders running in separate threads do not contend with each other.
+    /// Each list holds at most maxFree blocks. Any more are returned to the heap,
+    /// so a thread that only releases fields does not accumulate memory.
+    class QuickFAST_Export FieldPool
+    {
+    public:
+      /// @brief Counters for the calling thread's pool.
+      struct Statistics
+      {
+        /// Allocations requested.
+        size_t allocations_;
+        /// Allocations satisfied from a free list.
+        size_t hits_;
+        /// Blocks released.
+        size_t releases_;
+        /// Released blocks kept on a free list.
+        size_t recycled_;
+      };
+
+      /// @brief The largest block that will be pooled.  Larger ones go to the heap.
+      static const size_t maxPooledSize = 256;
+
+      /// @brief The most blocks of each size that one thread keeps.
+      static const size_t maxFree = 4096;
+
+      /// @brief Allocate memory for a field.
+      /// @param size is the number of bytes needed.
+      /// @returns the memory.
+      /// @throws std::bad_alloc if the heap is exhausted.
+      static void * allocate(size_t size);
+
+      /// @brief Release memory allocated by allocate()
+      /// @param block is the memory to be released.
+      /// @param size must be the size passed to allocate()
+      static void release(void * block, size_t size);
+
+      /// @brief Get the counters for the calling thread.
+      /// @param[out] statistics receives the counters.
+      static void getStatistics(Statistics & statistics);
+
+      /// @brief Zero the counters for the calling thread.
+      static void resetStatistics();
+    };
+
+    /// @brief A standard allocator that takes its memory from the FieldPool.
+    ///
+    /// Useful for small, frequently allocated objects such as the control
+    /// blocks of boost::shared_ptrs created with a custom deleter.
+    template<typename T>
+    class FieldPoolAllocator
+    {
+    public:
+      /// @brief Standard allocator types
+      typedef T value_type;
+      /// @brief Standard allocator types
+      typedef T * pointer;
+      /// @brief Standard allocator types
+      typedef const T * const_pointer;
+      /// @brief Standard allocator types
+      typedef T & reference;
+      /// @brief Standard allocator types
+      typedef const T & const_reference;
+      /// @brief Standard allocator types
+      typedef size_t size_type;
+      /// @brief Standard allocator types
+      typedef ptrdiff_t difference_type;
+
+      /// @brief Get an allocator for another type
+      template<typename U>
+      struct rebind
+      {
+        /// @brief the allocator for U
+        typedef FieldPoolAllocator<U> other;
+      };
+
+      /// @brief Default construct.
+      FieldPoolAllocator()
+      {
+      }
+
+      /// @brief Construct from an allocator for another type.
+      template<typename U>
+      FieldPoolAllocator(const FieldPoolAllocator<U> &)
+      {
+      }
+
+      /// @brief Allocate space for count objects.
+      pointer allocate(size_type count, const void * = 0)
+      {
+        return static_cast<pointer>(FieldPool::allocate(count * sizeof(T)));
+      }
+
+      /// @brief Release space allocated by allocate()
+      void deallocate(pointer p, size_type count)
+      {
+        FieldPool::release(p, count * sizeof(T));
+      }
+
+      /// @brief Construct an object in allocated space.
+      void construct(pointer p, const T & value)
+      {
+        new(p) T(value);
+      }
+
+      /// @brief Destroy an object without releasing the space.
+      void destroy(pointer p)
+      {
+        p->~T();
+      }
+
+      /// @brief The most objects that can be allocated at once.
+      size_type max_size() const
+      {
+        return size_t(-1) / sizeof(T);
+      }
+
+      /// @brief Get the address of an object
+      pointer address(reference value) const
+      {
+        return &value;
+      }
+
+      /// @brief Get the address of an object
+      const_pointer address(const_reference value) const
+      {
+        return &value;
+      }
+    };
+
+    /// @brief All FieldPoolAllocators are interchangeable.
+    template<typename T, typename U>
+    bool operator == (const FieldPoolAllocator<T> &, const FieldPoolAllocator<U> &)
+    {
+      return true;
+    }
+
+    /// @brief All FieldPoolAllocators are interchangeable.
+    template<typename T, typename U>
+    bool operator != (const FieldPoolAllocator<T> &, const FieldPoolAllocator<U> &)
+    {
+      return false;
+    }
+  }
+}
+#endif // FIELDPOOL_H
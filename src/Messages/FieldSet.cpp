@@ -11,12 +11,19 @@
 using namespace ::QuickFAST;
 using namespace ::QuickFAST::Messages;
 
+namespace
+{
+  const size_t NO_SLOT = size_t(-1);
+  const size_t AMBIGUOUS_SLOT = size_t(-2);
+}
+
 FieldSet::FieldSet(size_t res)
-: fields_(reinterpret_cast<MessageField *>(new unsigned char[sizeof(MessageField) * res]))
+: fields_(0)
+, slots_(0)
 , capacity_(res)
 , used_(0)
 {
-  memset(fields_, 0, sizeof(MessageField) * capacity_);
+  allocate(capacity_, fields_, slots_);
 }
 
 FieldSet::~FieldSet()
@@ -25,21 +32,41 @@ FieldSet::~FieldSet()
   delete [] reinterpret_cast<unsigned char *>(fields_);
 }
 
+void
+FieldSet::allocate(size_t capacity, MessageField *& fields, size_t *& slots)
+{
+  // The slots follow the fields in a single allocation
+  fields = reinterpret_cast<MessageField *>(
+    new unsigned char[(sizeof(MessageField) + sizeof(size_t)) * capacity]);
+  memset(fields, 0, sizeof(MessageField) * capacity);
+  slots = reinterpret_cast<size_t *>(fields + capacity);
+  for(size_t nSlot = 0; nSlot < capacity; ++nSlot)
+  {
+    slots[nSlot] = NO_SLOT;
+  }
+}
+
 void
 FieldSet::reserve(size_t capacity)
 {
   if(capacity > capacity_)
   {
-    MessageField * buffer = reinterpret_cast<MessageField *>(new unsigned char[sizeof(MessageField) * capacity]);
-    memset(buffer, 0, sizeof(MessageField) * capacity);
+    MessageField * buffer;
+    size_t * slots;
+    allocate(capacity, buffer, slots);
     for(size_t nField = 0; nField < used_; ++nField)
     {
       new(&buffer[nField]) MessageField(fields_[nField]);
     }
+    for(size_t nSlot = 0; nSlot < capacity_; ++nSlot)
+    {
+      slots[nSlot] = slots_[nSlot];
+    }
 
     MessageField * oldBuffer = fields_;
     size_t oldUsed = used_;
     fields_ = buffer;
+    slots_ = slots;
     capacity_ = capacity;
 
     while (oldUsed > 0)
@@ -64,6 +91,10 @@ FieldSet::clear(size_t capacity)
     reserve(capacity);
   }
   memset(fields_, 0, sizeof(MessageField) * capacity_);
+  for(size_t nSlot = 0; nSlot < capacity_; ++nSlot)
+  {
+    slots_[nSlot] = NO_SLOT;
+  }
 }
 
 const MessageField &
@@ -76,16 +107,51 @@ FieldSet::operator[](size_t index)const
   return fields_[index];
 }
 
-bool
-FieldSet::isPresent(const FieldIdentity & identity) const
+size_t
+FieldSet::findField(const FieldIdentity & identity) const
 {
+  // Try the slot for the field's template position first.
+  size_t position = identity.position();
+  if(position < capacity_)
+  {
+    size_t index = slots_[position];
+    if(index < used_ && identity == fields_[index].getIdentity())
+    {
+      return index;
+    }
+  }
   for(size_t index = 0; index < used_; ++index)
   {
     if(identity == fields_[index].getIdentity())
     {
-      return fields_[index].getField()->isDefined();
+      return index;
+    }
+  }
+  return used_;
+}
+
+const MessageField *
+FieldSet::fieldAtPosition(size_t position) const
+{
+  if(position < capacity_)
+  {
+    size_t index = slots_[position];
+    if(index < used_ && fields_[index].getIdentity().position() == position)
+    {
+      return &fields_[index];
     }
   }
+  return 0;
+}
+
+bool
+FieldSet::isPresent(const FieldIdentity & identity) const
+{
+  size_t index = findField(identity);
+  if(index < used_)
+  {
+    return fields_[index].getField()->isDefined();
+  }
   return false;
 }
 
@@ -99,6 +165,22 @@ FieldSet::addField(const FieldIdentity & identity, const FieldCPtr & value)
     reserve(((used_ + 1) * 3) / 2);
   }
   new (fields_ + used_) MessageField(identity, value);
+  size_t position = identity.position();
+  if(position < capacity_)
+  {
+    size_t index = slots_[position];
+    if(index == AMBIGUOUS_SLOT ||
+      (index < used_ && fields_[index].getIdentity().position() == position))
+    {
+      // More than one field claims this position (i.e. from segments merged side by side.)
+      // None of them can be found by position.
+      slots_[position] = AMBIGUOUS_SLOT;
+    }
+    else
+    {
+      slots_[position] = used_;
+    }
+  }
   ++used_;
 }
 
@@ -106,16 +188,12 @@ bool
 FieldSet::replaceField(const FieldIdentity & identity,
                        const FieldCPtr & value)
 {
-  for(size_t index = 0; index < used_; ++index)
+  size_t index = findField(identity);
+  if(index < used_ && fields_[index].getField()->isDefined())
   {
-    if(identity == fields_[index].getIdentity())
-    {
-      if(fields_[index].getField()->isDefined()) {
-        (fields_ + index)->~MessageField();  // Explicit destroy
-        new (fields_ + index) MessageField(identity, value);
-        return true;
-      }
-    }
+    (fields_ + index)->~MessageField();  // Explicit destroy
+    new (fields_ + index) MessageField(identity, value);
+    return true;
   }
   return false;
 }
@@ -124,13 +202,11 @@ bool
 FieldSet::getField(const Messages::FieldIdentity & identity, FieldCPtr & value) const
 {
   PROFILE_POINT("FieldSet::getField");
-  for(size_t index = 0; index < used_; ++index)
+  size_t index = findField(identity);
+  if(index < used_)
   {
-    if(identity == fields_[index].getIdentity())
-    {
-      value = fields_[index].getField();
-      return value->isDefined();
-    }
+    value = fields_[index].getField();
+    return value->isDefined();
   }
   return false;
 }
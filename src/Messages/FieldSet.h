@@ -100,6 +100,17 @@ namespace QuickFAST{
       /// @returns true if the field was found and has a value;
       bool getField(const Messages::FieldIdentity & identity, FieldCPtr & value) const;
 
+      /// @brief Find a field by the position of its instruction in the template.
+      ///
+      /// Constant time.  The position is the one recorded in the field's identity
+      /// when the template was finalized.  A segment's positions start after those of
+      /// the groups and static template references merged into it, so fields from
+      /// different segments in one set normally have different positions.  If two
+      /// fields in the set do share a position, neither is returned.
+      /// @param position is the position recorded in the field's identity
+      /// @returns the field or 0 if no single field at that position is in the set.
+      const MessageField * fieldAtPosition(size_t position) const;
+
       /// @brief support iterating through Fields in this FieldSet.
       const_iterator begin() const
       {
@@ -141,6 +152,7 @@ namespace QuickFAST{
         applicationType_.swap(rhs.applicationType_);
         applicationTypeNs_.swap(rhs.applicationTypeNs_);
         swap_i(fields_, rhs.fields_);
+        swap_i(slots_, rhs.slots_);
         swap_i(capacity_, rhs.capacity_);
         swap_i(used_, rhs.used_);
       }
@@ -168,6 +180,9 @@ namespace QuickFAST{
       bool equals(const FieldSet & rhs, std::ostream & reason) const;
 
     private:
+      size_t findField(const FieldIdentity & identity) const;
+      void allocate(size_t capacity, MessageField *& fields, size_t *& slots);
+
       template<typename T>
       void swap_i(T & l, T & r)
       {
@@ -183,6 +198,9 @@ namespace QuickFAST{
     private:
       /// The collection of fields
       MessageField * fields_;
+      /// Index into fields_ indexed by template position.  Shares the fields_ allocation.
+      /// Entries may be stale; they are validated on use.
+      size_t * slots_;
       size_t capacity_;
       size_t used_;
     };
@@ -14,6 +14,7 @@
 #include <Messages/FieldDecimal.h>
 #include <Messages/FieldString.h>
 #include <Messages/FieldAscii.h>
+#include <Messages/SymbolTable.h>
 #include <Messages/FieldUtf8.h>
 #include <Messages/FieldByteVector.h>
 
@@ -137,3 +138,20 @@ void MessageBuilder::addValue(const FieldIdentity & identity, ValueType::Type ty
     addField(identity, FieldString::create(value, length));
   }
 }
+
+void MessageBuilder::addSymbol(const FieldIdentity & identity, ValueType::Type type, const Symbol & symbol)
+{
+  if(type != ValueType::ASCII)
+  {
+    addValue(identity, type, symbol.data(), symbol.length());
+    return;
+  }
+  if(vout_)
+  {
+    (*vout_)
+      << "Assign: " << identity.name() << " = " << std::string(reinterpret_cast<const char *>(symbol.data()), symbol.length())
+      << " (symbol " << symbol.id() << ')' << std::endl;
+  }
+  // The field is shared, not copied.
+  addField(identity, symbol.field());
+}
@@ -48,6 +48,7 @@ namespace QuickFAST{
       virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const uchar value);
       virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const Decimal& value);
       virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length);
+      virtual void addSymbol(const FieldIdentity & identity, ValueType::Type type, const Symbol & symbol);
 
     private:
       std::ostream * vout_;
@@ -0,0 +1,147 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef RECYCLER_H
+#define RECYCLER_H
+#include <Common/Types.h>
+#include <Messages/FieldPool.h>
+
+namespace QuickFAST{
+  namespace Messages{
+    /// @brief Keep released objects so they can be reused with their capacity intact.
+    ///
+    /// Objects are handed out as boost::shared_ptrs.  When the last reference
+    /// is released the object is cleared and returned to the recycler rather
+    /// than deleted.  The next acquire() gets it back.
+    ///
+    /// OBJECT must provide a clear() method that releases everything it refers to.
+    ///
+    /// The recycler must be owned by a boost::shared_ptr.  Each object it shares holds
+    /// a reference to the recycler, so objects may outlive the code that created them.
+    /// Objects may be released from any thread.
+    template<typename OBJECT>
+    class Recycler : public boost::enable_shared_from_this<Recycler<OBJECT> >
+    {
+    public:
+      /// @brief The type of object being recycled.
+      typedef OBJECT Object;
+      /// @brief A smart pointer to a recycled object.
+      typedef boost::shared_ptr<OBJECT> ObjectPtr;
+
+      /// @brief Counters for this recycler.
+      struct Statistics
+      {
+        /// Objects requested.
+        size_t allocations_;
+        /// Requests satisfied from the free list.
+        size_t hits_;
+        /// Objects released.
+        size_t releases_;
+        /// Released objects kept for reuse.
+        size_t recycled_;
+      };
+
+      /// @brief Construct
+      /// @param maxFree is the most idle objects to keep.  Any more are deleted.
+      explicit Recycler(size_t maxFree = 1024)
+        : maxFree_(maxFree)
+      {
+        memset(&statistics_, 0, sizeof(statistics_));
+      }
+
+      /// @brief Delete the idle objects.
+      ~Recycler()
+      {
+        for(size_t nObject = 0; nObject < free_.size(); ++nObject)
+        {
+          delete free_[nObject];
+        }
+      }
+
+      /// @brief Get an idle object.
+      /// @returns a cleared object or 0 if none is available.
+      ///          The caller should create an object if necessary, then share() it.
+      OBJECT * acquire()
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        ++statistics_.allocations_;
+        if(free_.empty())
+        {
+          return 0;
+        }
+        ++statistics_.hits_;
+        OBJECT * result = free_.back();
+        free_.pop_back();
+        return result;
+      }
+
+      /// @brief Wrap an object so it returns here when the last reference is released.
+      /// @param object was acquired from this recycler or newly created.
+      /// @returns a smart pointer that now owns the object.
+      ObjectPtr share(OBJECT * object)
+      {
+        return ObjectPtr(
+          object,
+          Returner(this->shared_from_this()),
+          FieldPoolAllocator<OBJECT>());
+      }
+
+      /// @brief Clear an object and keep it for reuse.
+      /// @param object is no longer referenced.
+      void release(OBJECT * object)
+      {
+        object->clear();
+        boost::mutex::scoped_lock lock(mutex_);
+        ++statistics_.releases_;
+        if(free_.size() < maxFree_)
+        {
+          ++statistics_.recycled_;
+          free_.push_back(object);
+          return;
+        }
+        lock.unlock();
+        delete object;
+      }
+
+      /// @brief Get the counters for this recycler.
+      /// @param[out] statistics receives the counters.
+      void getStatistics(Statistics & statistics)const
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        statistics = statistics_;
+      }
+
+    private:
+      /// @brief Deleter for shared objects.
+      class Returner
+      {
+      public:
+        explicit Returner(const boost::shared_ptr<Recycler> & recycler)
+          : recycler_(recycler)
+        {
+        }
+
+        void operator()(OBJECT * object)
+        {
+          recycler_->release(object);
+        }
+      private:
+        boost::shared_ptr<Recycler> recycler_;
+      };
+
+    private:
+      Recycler(const Recycler &);
+      Recycler & operator=(const Recycler &);
+
+    private:
+      mutable boost::mutex mutex_;
+      size_t maxFree_;
+      std::vector<OBJECT *> free_;
+      Statistics statistics_;
+    };
+  }
+}
+#endif // RECYCLER_H
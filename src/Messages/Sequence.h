@@ -28,7 +28,7 @@ namespace QuickFAST{
       Sequence(
         const Messages::FieldIdentity & lengthFieldIdentity,
         size_t sequenceLength)
-        : lengthIdentity_(lengthFieldIdentity)
+        : lengthIdentity_(&lengthFieldIdentity)
       {
         this->entries_.reserve(sequenceLength);
       }
@@ -40,7 +40,27 @@ namespace QuickFAST{
       /// @brief get the identity of the sequence's length field
       const Messages::FieldIdentity & getLengthIdentity() const
       {
-        return lengthIdentity_;
+        return *lengthIdentity_;
+      }
+
+      /// @brief Prepare a cleared sequence to be used again.
+      ///
+      /// The capacity of the entry vector is retained.
+      /// @param lengthFieldIdentity identifies the sequence's length field
+      /// @param sequenceLength is the expected number of entries
+      void reinitialize(
+        const Messages::FieldIdentity & lengthFieldIdentity,
+        size_t sequenceLength)
+      {
+        lengthIdentity_ = &lengthFieldIdentity;
+        this->entries_.reserve(sequenceLength);
+      }
+
+      /// @brief Release all entries.
+      void clear()
+      {
+        entries_.clear();
+        applicationType_.clear();
       }
 
       /// @brief Set the application data type associated with this sequence.
@@ -97,7 +117,7 @@ namespace QuickFAST{
       Sequence& operator=(const Sequence&);
     private:
       std::string applicationType_;
-      const Messages::FieldIdentity & lengthIdentity_;
+      const Messages::FieldIdentity * lengthIdentity_;
       Entries entries_;
     };
   }
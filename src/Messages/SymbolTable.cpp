@@ -0,0 +1,129 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "SymbolTable.h"
+#include <Messages/FieldAscii.h>
+
+using namespace ::QuickFAST;
+using namespace ::QuickFAST::Messages;
+
+const size_t SymbolTable::defaultMaxSymbols;
+const size_t SymbolTable::defaultMaxLength;
+
+namespace
+{
+  const size_t initialBuckets = 256;
+}
+
+SymbolTable::SymbolTable(size_t maxSymbols, size_t maxLength)
+: maxSymbols_(maxSymbols)
+, maxLength_(maxLength)
+, buckets_(initialBuckets, 0)
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+}
+
+size_t
+SymbolTable::hashBytes(const uchar * value, size_t length)
+{
+  // FNV-1a
+  uint32 hash = 2166136261U;
+  for(size_t pos = 0; pos < length; ++pos)
+  {
+    hash ^= value[pos];
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+size_t
+SymbolTable::findBucket(const uchar * value, size_t length, size_t hash)const
+{
+  // The number of buckets is a power of two
+  size_t mask = buckets_.size() - 1;
+  size_t bucket = hash & mask;
+  for(;;)
+  {
+    uint32 entry = buckets_[bucket];
+    if(entry == 0)
+    {
+      return bucket;
+    }
+    const Symbol & symbol = symbols_[entry - 1];
+    if(symbol.hash_ == hash
+      && symbol.length() == length
+      && memcmp(symbol.data(), value, length) == 0)
+    {
+      return bucket;
+    }
+    bucket = (bucket + 1) & mask;
+  }
+}
+
+const Symbol *
+SymbolTable::find(const uchar * value, size_t length)const
+{
+  if(length > maxLength_)
+  {
+    return 0;
+  }
+  uint32 entry = buckets_[findBucket(value, length, hashBytes(value, length))];
+  if(entry == 0)
+  {
+    return 0;
+  }
+  return &symbols_[entry - 1];
+}
+
+const Symbol *
+SymbolTable::intern(const uchar * value, size_t length)
+{
+  if(length > maxLength_)
+  {
+    return 0;
+  }
+  size_t hash = hashBytes(value, length);
+  size_t bucket = findBucket(value, length, hash);
+  uint32 entry = buckets_[bucket];
+  if(entry != 0)
+  {
+    return &symbols_[entry - 1];
+  }
+  if(symbols_.size() >= maxSymbols_)
+  {
+    return 0;
+  }
+  symbols_.push_back(Symbol());
+  Symbol & symbol = symbols_.back();
+  symbol.id_ = uint32(symbols_.size() - 1);
+  symbol.hash_ = hash;
+  symbol.field_ = FieldAscii::create(value, length);
+  buckets_[bucket] = symbol.id_ + 1;
+  // keep the load factor below one half.
+  if(symbols_.size() * 2 > buckets_.size())
+  {
+    rehash();
+  }
+  return &symbol;
+}
+
+void
+SymbolTable::rehash()
+{
+  std::vector<uint32> buckets(buckets_.size() * 2, 0);
+  size_t mask = buckets.size() - 1;
+  for(size_t nSymbol = 0; nSymbol < symbols_.size(); ++nSymbol)
+  {
+    size_t bucket = symbols_[nSymbol].hash_ & mask;
+    while(buckets[bucket] != 0)
+    {
+      bucket = (bucket + 1) & mask;
+    }
+    buckets[bucket] = uint32(nSymbol + 1);
+  }
+  buckets_.swap(buckets);
+}
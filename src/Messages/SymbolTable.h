@@ -0,0 +1,127 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+#include "SymbolTable_fwd.h"
+#include <Common/QuickFAST_Export.h>
+#include <Messages/Field.h>
+#include <deque>
+
+namespace QuickFAST{
+  namespace Messages{
+    /// @brief An interned ASCII value.
+    class Symbol
+    {
+    public:
+      /// @brief A small integer that identifies this symbol in its SymbolTable.
+      ///
+      /// Ids are assigned in order starting at zero and never change.
+      uint32 id()const
+      {
+        return id_;
+      }
+
+      /// @brief The shared, immutable FieldAscii holding the value.
+      const FieldCPtr & field()const
+      {
+        return field_;
+      }
+
+      /// @brief The bytes of the value.
+      const uchar * data()const
+      {
+        return field_->toAscii().c_str();
+      }
+
+      /// @brief The length of the value.
+      size_t length()const
+      {
+        return field_->toAscii().size();
+      }
+
+    private:
+      friend class SymbolTable;
+      uint32 id_;
+      size_t hash_;
+      FieldCPtr field_;
+    };
+
+    /// @brief Intern short ASCII values so that each distinct value is stored once.
+    ///
+    /// Install a SymbolTable in a Decoder with Decoder::setSymbolTable().  Each
+    /// decoded ASCII value that is no longer than maxLength is looked up by its raw
+    /// bytes.  The builder receives the Symbol through ValueMessageBuilder::addSymbol(),
+    /// so a MessageBuilder adds the shared FieldAscii to the message rather than allocating
+    /// a new one, and a consumer can key on Symbol::id() instead of hashing the string.
+    ///
+    /// Once the table holds maxSymbols values, new values are no longer interned.
+    /// Symbols are never removed, so a Symbol reference is valid for the life of the table.
+    ///
+    /// A SymbolTable is not thread-safe.  Use one per decoding thread. If messages
+    /// are handed to other threads build with QUICKFAST_ATOMIC_REFCOUNT since the
+    /// interned fields are shared between messages.
+    class QuickFAST_Export SymbolTable
+    {
+    public:
+      /// @brief The default limit on the number of symbols.
+      static const size_t defaultMaxSymbols = 65536;
+      /// @brief The default limit on the length of a symbol.
+      static const size_t defaultMaxLength = 16;
+
+      /// @brief Construct
+      /// @param maxSymbols limits the number of distinct values interned.
+      /// @param maxLength limits the length of values interned.
+      explicit SymbolTable(
+        size_t maxSymbols = defaultMaxSymbols,
+        size_t maxLength = defaultMaxLength);
+
+      ~SymbolTable();
+
+      /// @brief Find or add a value.
+      /// @param value points to the bytes of the value
+      /// @param length is the number of bytes
+      /// @returns the symbol, or zero if the value is too long or the table is full.
+      const Symbol * intern(const uchar * value, size_t length);
+
+      /// @brief Find a value without adding it.
+      /// @param value points to the bytes of the value
+      /// @param length is the number of bytes
+      /// @returns the symbol, or zero if the value has not been interned.
+      const Symbol * find(const uchar * value, size_t length)const;
+
+      /// @brief Find a symbol by id.
+      /// @param id must be less than size()
+      const Symbol & operator[](uint32 id)const
+      {
+        return symbols_[id];
+      }
+
+      /// @brief How many values have been interned.
+      size_t size()const
+      {
+        return symbols_.size();
+      }
+
+    private:
+      static size_t hashBytes(const uchar * value, size_t length);
+      size_t findBucket(const uchar * value, size_t length, size_t hash)const;
+      void rehash();
+
+    private:
+      SymbolTable(const SymbolTable &);
+      SymbolTable & operator=(const SymbolTable &);
+
+    private:
+      size_t maxSymbols_;
+      size_t maxLength_;
+      /// Open addressing.  Each bucket holds a symbol id + 1; zero is empty.
+      std::vector<uint32> buckets_;
+      std::deque<Symbol> symbols_;
+    };
+  }
+}
+#endif // SYMBOLTABLE_H
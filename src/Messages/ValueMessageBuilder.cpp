@@ -0,0 +1,15 @@
+// Copyright (c) 2009, Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+#include "ValueMessageBuilder.h"
+#include <Messages/SymbolTable.h>
+
+using namespace QuickFAST;
+using namespace Messages;
+
+void
+ValueMessageBuilder::addSymbol(const FieldIdentity & identity, ValueType::Type type, const Symbol & symbol)
+{
+  addValue(identity, type, symbol.data(), symbol.length());
+}
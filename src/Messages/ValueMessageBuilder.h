@@ -11,11 +11,12 @@
 #include <Common/QuickFAST_Export.h>
 #include <Common/Types.h>
 #include <Messages/FieldIdentity_fwd.h>
+#include <Messages/SymbolTable_fwd.h>
 #include <Common/Logger.h>
 namespace QuickFAST{
   namespace Messages{
     /// @brief Interface to support building a message during decoding.
-    class ValueMessageBuilder : public Common::Logger
+    class QuickFAST_Export ValueMessageBuilder : public Common::Logger
     {
     public:
 
@@ -91,6 +92,30 @@ namespace QuickFAST{
       /// @param length is the length of the string pointed to by value
       virtual void addValue(const FieldIdentity & identity, ValueType::Type type, const unsigned char * value, size_t length) = 0;
 
+      /// @brief Add a value that the decoder found in its SymbolTable.
+      ///
+      /// New method added to the interface.  The default implementation adds
+      /// the symbol's bytes with addValue().  Override it to use the shared field
+      /// or the symbol id.
+      ///
+      /// @param identity identifies this field
+      /// @param type is the type of data to be added
+      /// @param symbol is the interned value.
+      virtual void addSymbol(const FieldIdentity & identity, ValueType::Type type, const Symbol & symbol);
+
+      /// @brief Identify the template that will be used to decode the next message.
+      ///
+      /// The decoder calls this immediately before startMessage().
+      /// Builders that precompute a layout for each template use it to select one.
+      ///
+      /// New method added to the interface.  It's not pure virtual to avoid
+      /// breaking existing implementations.
+      ///
+      /// @param templateId identifies the template.
+      virtual void selectTemplate(template_id_t /*templateId*/)
+      {
+      }
+
       /// @brief prepare to accept an entire message
       ///
       /// @param applicationType is the data type for the message
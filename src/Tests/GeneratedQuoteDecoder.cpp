@@ -0,0 +1,126 @@
+// Generated by the QuickFAST template code generator.  Do not edit.
+#include <Common/QuickFASTPch.h>
+#include "GeneratedQuoteDecoder.h"
+#include <Codecs/GeneratedDecoderSupport.h>
+#include <Codecs/TemplateRegistry.h>
+
+namespace
+{
+  const size_t presenceMapBits = 7;
+  const size_t maxFieldCount = 12;
+  const size_t dictionarySize = 5;
+  const std::string templateIdName("templateID");
+  const std::string Quote_SeqNum_name("SeqNum");
+  const std::string Quote_Px_name("Px");
+  const std::string Quote_Size_name("Size");
+  const std::string Quote_Qty_name("Qty");
+  const std::string Quote_Change_name("Change");
+  const std::string Quote_Market_name("Market");
+  const std::string Quote_Symbol_name("Symbol");
+  const std::string Quote_Side_name("Side");
+  const std::string Quote_Venue_name("Venue");
+  const std::string Quote_Level_name("Level");
+  const std::string Quote_Price_name("Price");
+  const std::string Quote_Flags_name("Flags");
+  const std::string Wide_Value_name("Value");
+  const std::string Narrow_Value_name("Value");
+}
+
+namespace QuickFAST{
+namespace Tests{
+namespace Generated{
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Quote & message)
+  {
+    QuickFAST::Codecs::GeneratedDecoderSupport::integerIncrement<QuickFAST::uint32, false>(source, pmap, context, true, false, 0, true, QuickFAST::uint32(1ULL), message.SeqNum, Quote_SeqNum_name);
+    message.PxPresent = QuickFAST::Codecs::GeneratedDecoderSupport::integerCopy<QuickFAST::int64, true>(source, pmap, context, false, false, 1, false, QuickFAST::int64(0), message.Px, Quote_Px_name);
+    message.SizePresent = QuickFAST::Codecs::GeneratedDecoderSupport::integerNop<QuickFAST::uint32, false>(source, context, false, false, message.Size, Quote_Size_name);
+    QuickFAST::Codecs::GeneratedDecoderSupport::integerDelta(source, context, true, 2, false, QuickFAST::int32(0), message.Qty, Quote_Qty_name);
+    message.ChangePresent = QuickFAST::Codecs::GeneratedDecoderSupport::integerDelta(source, context, false, 3, false, QuickFAST::int64(0), message.Change, Quote_Change_name);
+    QuickFAST::Codecs::GeneratedDecoderSupport::asciiDefault(source, pmap, context, true, "XNAS", message.Market, Quote_Market_name);
+    QuickFAST::Codecs::GeneratedDecoderSupport::asciiCopy(source, pmap, context, true, 4, 0, message.Symbol, Quote_Symbol_name);
+    message.SidePresent = QuickFAST::Codecs::GeneratedDecoderSupport::asciiNop(source, context, false, message.Side);
+    message.VenuePresent = QuickFAST::Codecs::GeneratedDecoderSupport::asciiConstant(pmap, false, "Q", message.Venue);
+    QuickFAST::Codecs::GeneratedDecoderSupport::integerConstant(pmap, true, QuickFAST::uint64(3ULL), message.Level);
+    message.PricePresent = QuickFAST::Codecs::GeneratedDecoderSupport::decimalNop(source, context, false, message.Price, Quote_Price_name);
+    message.FlagsPresent = QuickFAST::Codecs::GeneratedDecoderSupport::integerDefault<QuickFAST::uint32, false>(source, pmap, context, false, false, true, QuickFAST::uint32(5ULL), message.Flags, Quote_Flags_name);
+  }
+
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Wide & message)
+  {
+    QuickFAST::Codecs::GeneratedDecoderSupport::integerNop<QuickFAST::uint32, false>(source, context, true, true, message.Value, Wide_Value_name);
+    (void)pmap;
+  }
+
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Narrow & message)
+  {
+    QuickFAST::Codecs::GeneratedDecoderSupport::integerNop<QuickFAST::uint32, false>(source, context, true, false, message.Value, Narrow_Value_name);
+    (void)pmap;
+  }
+
+  Decoder::Decoder()
+    : Context(QuickFAST::Codecs::TemplateRegistryPtr(
+        new QuickFAST::Codecs::TemplateRegistry(presenceMapBits, maxFieldCount, dictionarySize)))
+  {
+  }
+
+  bool
+  Decoder::decodeMessage(
+    QuickFAST::Codecs::DataSource & source,
+    MessageHandler & handler)
+  {
+    source.beginMessage();
+    QuickFAST::Codecs::PresenceMap pmap(presenceMapBits);
+    pmap.decode(source);
+    if(pmap.checkNextField())
+    {
+      QuickFAST::template_id_t id;
+      QuickFAST::Codecs::FieldInstruction::decodeUnsignedInteger(source, *this, id, templateIdName);
+      setTemplateId(id);
+    }
+    switch(getTemplateId())
+    {
+    case Quote::templateId:
+      {
+        Quote message;
+        decode(source, pmap, *this, message);
+        handler.handle(message);
+        return true;
+      }
+    case Wide::templateId:
+      {
+        Wide message;
+        decode(source, pmap, *this, message);
+        handler.handle(message);
+        return true;
+      }
+    case Narrow::templateId:
+      {
+        Narrow message;
+        decode(source, pmap, *this, message);
+        handler.handle(message);
+        return true;
+      }
+    case SCPResetTemplateId:
+      reset(false);
+      return false;
+    default:
+      break;
+    }
+    std::string error = "Unknown or unsupported template ID:";
+    error += boost::lexical_cast<std::string>(getTemplateId());
+    reportError("[ERR D9]", error);
+    return false;
+  }
+}}}
@@ -0,0 +1,121 @@
+// Generated by the QuickFAST template code generator.  Do not edit.
+#ifndef QUICKFAST__TESTS__GENERATED_GENERATEDQUOTEDECODER_H
+#define QUICKFAST__TESTS__GENERATED_GENERATEDQUOTEDECODER_H
+#include <Codecs/Context.h>
+#include <Codecs/DataSource_fwd.h>
+#include <Codecs/PresenceMap_fwd.h>
+#include <Common/Decimal.h>
+
+namespace QuickFAST{
+namespace Tests{
+namespace Generated{
+  /// @brief Decoded contents of template Quote
+  struct Quote
+  {
+    /// The FAST template ID
+    static const QuickFAST::template_id_t templateId = 7;
+    /// Field SeqNum
+    QuickFAST::uint32 SeqNum;
+    /// Field Px
+    QuickFAST::int64 Px;
+    /// true if Px is present
+    bool PxPresent;
+    /// Field Size
+    QuickFAST::uint32 Size;
+    /// true if Size is present
+    bool SizePresent;
+    /// Field Qty
+    QuickFAST::int32 Qty;
+    /// Field Change
+    QuickFAST::int64 Change;
+    /// true if Change is present
+    bool ChangePresent;
+    /// Field Market
+    std::string Market;
+    /// Field Symbol
+    std::string Symbol;
+    /// Field Side
+    std::string Side;
+    /// true if Side is present
+    bool SidePresent;
+    /// Field Venue
+    std::string Venue;
+    /// true if Venue is present
+    bool VenuePresent;
+    /// Field Level
+    QuickFAST::uint64 Level;
+    /// Field Price
+    QuickFAST::Decimal Price;
+    /// true if Price is present
+    bool PricePresent;
+    /// Field Flags
+    QuickFAST::uint32 Flags;
+    /// true if Flags is present
+    bool FlagsPresent;
+  };
+
+  /// @brief Decode the fields of template Quote
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Quote & message);
+
+  /// @brief Decoded contents of template Wide
+  struct Wide
+  {
+    /// The FAST template ID
+    static const QuickFAST::template_id_t templateId = 8;
+    /// Field Value
+    QuickFAST::uint32 Value;
+  };
+
+  /// @brief Decode the fields of template Wide
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Wide & message);
+
+  /// @brief Decoded contents of template Narrow
+  struct Narrow
+  {
+    /// The FAST template ID
+    static const QuickFAST::template_id_t templateId = 9;
+    /// Field Value
+    QuickFAST::uint32 Value;
+  };
+
+  /// @brief Decode the fields of template Narrow
+  void decode(
+    QuickFAST::Codecs::DataSource & source,
+    QuickFAST::Codecs::PresenceMap & pmap,
+    QuickFAST::Codecs::Context & context,
+    Narrow & message);
+
+  /// @brief Receive decoded messages.  Override the handle() methods of interest.
+  class MessageHandler
+  {
+  public:
+    virtual ~MessageHandler(){}
+    /// @brief Handle a decoded Quote
+    virtual void handle(const Quote & /*message*/){}
+    /// @brief Handle a decoded Wide
+    virtual void handle(const Wide & /*message*/){}
+    /// @brief Handle a decoded Narrow
+    virtual void handle(const Narrow & /*message*/){}
+  };
+
+  /// @brief Decode messages using the generated decode functions.
+  class Decoder : public QuickFAST::Codecs::Context
+  {
+  public:
+    Decoder();
+    /// @brief Decode the next message and deliver it to the handler.
+    /// @returns true if a message was delivered.
+    bool decodeMessage(
+      QuickFAST::Codecs::DataSource & source,
+      MessageHandler & handler);
+  };
+}}}
+#endif // QUICKFAST__TESTS__GENERATED_GENERATEDQUOTEDECODER_H
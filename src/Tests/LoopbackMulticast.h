@@ -0,0 +1,127 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef LOOPBACKMULTICAST_H
+#define LOOPBACKMULTICAST_H
+#include <Communication/Assembler.h>
+#include <Communication/Receiver.h>
+#include <Codecs/TemplateRegistry.h>
+#include <boost/asio.hpp>
+
+namespace QuickFAST{
+  namespace Tests{
+    /// @brief Send multicast packets over the loopback interface and collect them from a Receiver.
+    class LoopbackMulticast
+    {
+    public:
+      /// @brief The multicast group used by the tests.
+      static const char * group()
+      {
+        return "239.255.0.1";
+      }
+
+      /// @brief The interface used to send and receive.
+      static const char * loopback()
+      {
+        return "127.0.0.1";
+      }
+
+      /// @brief Send packets to the group.
+      /// @param port is the destination port
+      /// @param packets are sent in order, one datagram each
+      static void send(unsigned short port, const std::vector<std::string> & packets)
+      {
+        boost::asio::io_service ioService;
+        boost::asio::ip::udp::socket socket(ioService, boost::asio::ip::udp::v4());
+        socket.set_option(boost::asio::ip::multicast::outbound_interface(
+          boost::asio::ip::address::from_string(loopback()).to_v4()));
+        socket.set_option(boost::asio::ip::multicast::enable_loopback(true));
+        boost::asio::ip::udp::endpoint destination(boost::asio::ip::address::from_string(group()), port);
+        for(size_t n = 0; n < packets.size(); ++n)
+        {
+          socket.send_to(boost::asio::buffer(packets[n]), destination);
+        }
+      }
+    };
+
+    /// @brief A Logger that ignores everything.
+    class NullLogger : public Common::Logger
+    {
+    public:
+      virtual bool wantLog(unsigned short /*level*/){return false;}
+      virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+      virtual bool reportDecodingError(const std::string & /*errorMessage*/){return true;}
+      virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return true;}
+    };
+
+    /// @brief Collect the packets and errors and note which threads call the Assembler.
+    class CollectingAssembler : public Communication::Assembler
+    {
+    public:
+      /// @brief Construct
+      /// @param logger receives log messages
+      explicit CollectingAssembler(Common::Logger & logger)
+        : Communication::Assembler(Codecs::TemplateRegistryPtr(new Codecs::TemplateRegistry), logger)
+      {
+      }
+
+      virtual void receiverStarted(Communication::Receiver & /*receiver*/){}
+      virtual void receiverStopped(Communication::Receiver & /*receiver*/){}
+
+      virtual bool serviceQueue(Communication::Receiver & receiver)
+      {
+        // getBuffer() may report an error, so do not hold the lock while calling it.
+        for(Communication::LinkedBuffer * buffer = receiver.getBuffer(false);
+          buffer != 0;
+          buffer = receiver.getBuffer(false))
+        {
+          boost::mutex::scoped_lock lock(mutex_);
+          serviceThreads_.insert(boost::this_thread::get_id());
+          packets_.push_back(std::string(reinterpret_cast<const char *>(buffer->get()), buffer->used()));
+          receiver.releaseBuffer(buffer);
+        }
+        return true;
+      }
+
+      virtual bool reportCommunicationError(const std::string & errorMessage)
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        errors_.push_back(errorMessage);
+        errorThreads_.insert(boost::this_thread::get_id());
+        return true;
+      }
+
+      /// @brief Wait up to five seconds for packets and errors to arrive.
+      /// @param packetCount is the number of packets expected
+      /// @param errorCount is the number of errors expected
+      /// @returns true if they arrived.
+      bool waitFor(size_t packetCount, size_t errorCount = 0)
+      {
+        for(size_t wait = 0; wait < 500 && !arrived(packetCount, errorCount); ++wait)
+        {
+          boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        }
+        return arrived(packetCount, errorCount);
+      }
+
+      /// @brief Have the packets and errors arrived?
+      bool arrived(size_t packetCount, size_t errorCount = 0)
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        return packets_.size() >= packetCount && errors_.size() >= errorCount;
+      }
+
+      std::vector<std::string> packets_;
+      std::vector<std::string> errors_;
+      std::set<boost::thread::id> serviceThreads_;
+      std::set<boost::thread::id> errorThreads_;
+
+    private:
+      boost::mutex mutex_;
+    };
+  }
+}
+#endif // LOOPBACKMULTICAST_H
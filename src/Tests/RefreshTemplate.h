@@ -0,0 +1,174 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#ifdef _MSC_VER
+# pragma once
+#endif
+#ifndef REFRESHTEMPLATE_H
+#define REFRESHTEMPLATE_H
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/SegmentBody.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldInstructionSequence.h>
+#include <Codecs/FieldOpCopy.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Messages/Message.h>
+#include <Messages/Sequence.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+#include <Messages/FieldSequence.h>
+
+namespace QuickFAST{
+  namespace Tests{
+    /// A market data refresh template built without the XML parser, and messages to match.
+    ///
+    /// Template 7 "Refresh": SeqNum (uint32), Symbol (ascii), Price (optional decimal)
+    /// and a sequence Entries of Size (uint32) and Side (ascii, copy).
+    class RefreshTemplate
+    {
+    public:
+      /// The template ID
+      static const template_id_t id = 7;
+
+      /// @brief Build a registry holding the template.
+      /// @param ignore true to mark the template so decoded messages are ignored.
+      static Codecs::TemplateRegistryPtr buildRegistry(bool ignore = false)
+      {
+        Codecs::SegmentBodyPtr entry(new Codecs::SegmentBody(1));
+        entry->setApplicationType("Entry", "");
+        Codecs::FieldInstructionPtr field = instruction(new Codecs::FieldInstructionUInt32("Size", ""), true);
+        entry->addInstruction(field);
+        field = instruction(new Codecs::FieldInstructionAscii("Side", ""), true, true);
+        entry->addInstruction(field);
+
+        Codecs::TemplatePtr templ(new Codecs::Template);
+        templ->setId(id);
+        templ->setTemplateName("Refresh");
+        templ->setApplicationType("Refresh", "");
+        templ->setIgnore(ignore);
+        field = instruction(new Codecs::FieldInstructionUInt32("SeqNum", ""), true);
+        templ->addInstruction(field);
+        field = instruction(new Codecs::FieldInstructionAscii("Symbol", ""), true);
+        templ->addInstruction(field);
+        field = instruction(new Codecs::FieldInstructionDecimal("Price", ""), false);
+        templ->addInstruction(field);
+        field = instruction(new Codecs::FieldInstructionSequence("Entries", ""), true);
+        field->setSegmentBody(entry);
+        templ->addInstruction(field);
+
+        Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+        registry->addTemplate(templ);
+        registry->finalize();
+        return registry;
+      }
+
+      /// @brief The identities of the template's fields.
+      ///
+      /// Messages refer to their fields' identities, so these live as long as the program.
+      struct Identities
+      {
+        Identities()
+          : seqNum_("SeqNum")
+          , symbol_("Symbol")
+          , price_("Price")
+          , entries_("Entries")
+          , entryCount_("NoEntries")
+          , size_("Size")
+          , side_("Side")
+        {
+        }
+        Messages::FieldIdentity seqNum_;
+        Messages::FieldIdentity symbol_;
+        Messages::FieldIdentity price_;
+        Messages::FieldIdentity entries_;
+        Messages::FieldIdentity entryCount_;
+        Messages::FieldIdentity size_;
+        Messages::FieldIdentity side_;
+      };
+
+      /// @brief Access the identities.
+      static const Identities & identities()
+      {
+        static const Identities instance;
+        return instance;
+      }
+
+      /// @brief Build a message.
+      ///
+      /// Entry n has Size 100 * (n + 1) and Side "B" or "S" alternately.
+      /// @param seqNum is the value of SeqNum
+      /// @param entries is the number of entries in the sequence
+      /// @param withPrice true to include the Price (123.45)
+      /// @param symbol is the value of Symbol
+      static Messages::MessagePtr buildMessage(
+        uint32 seqNum,
+        size_t entries,
+        bool withPrice,
+        const std::string & symbol = "QFST")
+      {
+        const Identities & identity = identities();
+        Messages::MessagePtr msg(new Messages::Message(4));
+        msg->addField(identity.seqNum_, Messages::FieldUInt32::create(seqNum));
+        msg->addField(identity.symbol_, Messages::FieldAscii::create(symbol));
+        if(withPrice)
+        {
+          msg->addField(identity.price_, Messages::FieldDecimal::create(Decimal(12345, -2)));
+        }
+        Messages::SequencePtr sequence(new Messages::Sequence(identity.entryCount_, entries));
+        for(size_t nEntry = 0; nEntry < entries; ++nEntry)
+        {
+          Messages::FieldSetPtr entry(new Messages::FieldSet(2));
+          entry->addField(identity.size_, Messages::FieldUInt32::create(uint32(100 * (nEntry + 1))));
+          entry->addField(identity.side_, Messages::FieldAscii::create(nEntry % 2 == 0 ? "B" : "S"));
+          sequence->addEntry(entry);
+        }
+        msg->addField(identity.entries_, Messages::FieldSequence::create(sequence));
+        return msg;
+      }
+
+      /// @brief Encode messages with SeqNum 1, 2, 3...
+      /// @param registry was built by buildRegistry()
+      /// @param messageCount is how many messages to encode
+      /// @param entriesStep message n (counting from 0) has n * entriesStep entries
+      /// @param missingPrice is the index of the message without a price (if any)
+      /// @param symbol is the value of Symbol for every message
+      /// @returns the FAST encoded messages
+      static std::string encode(
+        Codecs::TemplateRegistryPtr registry,
+        size_t messageCount,
+        size_t entriesStep = 1,
+        size_t missingPrice = size_t(-1),
+        const std::string & symbol = "QFST")
+      {
+        Codecs::Encoder encoder(registry);
+        Codecs::DataDestination destination;
+        for(size_t n = 0; n < messageCount; ++n)
+        {
+          encoder.encodeMessage(destination, id, *buildMessage(uint32(n + 1), n * entriesStep, n != missingPrice, symbol));
+        }
+        std::string fast;
+        destination.toString(fast);
+        return fast;
+      }
+
+    private:
+      static Codecs::FieldInstructionPtr instruction(Codecs::FieldInstruction * field, bool mandatory, bool copy = false)
+      {
+        Codecs::FieldInstructionPtr result(field);
+        result->setPresence(mandatory);
+        if(copy)
+        {
+          result->setFieldOp(Codecs::FieldOpPtr(new Codecs::FieldOpCopy));
+        }
+        return result;
+      }
+    };
+  }
+}
+#endif // REFRESHTEMPLATE_H
@@ -0,0 +1,89 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Communication/BufferRing.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const size_t bufferCount = 8;
+  const size_t transferCount = 100000;
+
+  /// Push every buffer transferCount times in all, in order.
+  void produce(
+    Communication::BufferRing & ring,
+    Communication::LinkedBuffer * buffers)
+  {
+    for(size_t nTransfer = 0; nTransfer < transferCount; ++nTransfer)
+    {
+      Communication::LinkedBuffer * buffer = &buffers[nTransfer % bufferCount];
+      buffer->setUsed(nTransfer);
+      while(!ring.push(buffer))
+      {
+        boost::this_thread::yield();
+      }
+      // wait for the consumer to take it before reusing it.
+      if(nTransfer % bufferCount == bufferCount - 1)
+      {
+        while(!ring.isEmpty())
+        {
+          boost::this_thread::yield();
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testBufferRingSingleThread)
+{
+  Communication::BufferRing ring(3);
+  BOOST_CHECK_EQUAL(ring.capacity(), 4u);
+  BOOST_CHECK(ring.isEmpty());
+  BOOST_CHECK(ring.pop() == 0);
+
+  Communication::LinkedBuffer buffers[5];
+  for(size_t nBuffer = 0; nBuffer < 4; ++nBuffer)
+  {
+    BOOST_CHECK(ring.push(&buffers[nBuffer]));
+  }
+  BOOST_CHECK(!ring.push(&buffers[4]));
+  BOOST_CHECK(ring.pop() == &buffers[0]);
+  BOOST_CHECK(ring.push(&buffers[4]));
+  for(size_t nBuffer = 1; nBuffer < 5; ++nBuffer)
+  {
+    BOOST_CHECK(ring.pop() == &buffers[nBuffer]);
+  }
+  BOOST_CHECK(ring.isEmpty());
+  BOOST_CHECK(ring.pop() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(testBufferRingTwoThreads)
+{
+  Communication::BufferRing ring(bufferCount / 2);
+  Communication::LinkedBuffer buffers[bufferCount];
+  boost::thread producer(boost::bind(&produce, boost::ref(ring), buffers));
+
+  size_t errors = 0;
+  for(size_t nTransfer = 0; nTransfer < transferCount; ++nTransfer)
+  {
+    Communication::LinkedBuffer * buffer = ring.pop();
+    while(buffer == 0)
+    {
+      boost::this_thread::yield();
+      buffer = ring.pop();
+    }
+    if(buffer != &buffers[nTransfer % bufferCount] || buffer->used() != nTransfer)
+    {
+      ++errors;
+    }
+  }
+  producer.join();
+  BOOST_CHECK_EQUAL(errors, 0u);
+  BOOST_CHECK(ring.isEmpty());
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Communication/BusyPollReceiver.h>
+#include <Tests/LoopbackMulticast.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const unsigned short port = 30123;
+
+  std::string packet(size_t n)
+  {
+    std::ostringstream text;
+    text << "Packet " << n;
+    return text.str();
+  }
+
+  void sendPackets(size_t count)
+  {
+    std::vector<std::string> packets;
+    for(size_t n = 0; n < count; ++n)
+    {
+      packets.push_back(packet(n));
+    }
+    Tests::LoopbackMulticast::send(port, packets);
+  }
+
+  void checkPackets(Tests::CollectingAssembler & assembler, size_t count)
+  {
+    BOOST_REQUIRE_EQUAL(assembler.packets_.size(), count);
+    for(size_t n = 0; n < count; ++n)
+    {
+      BOOST_CHECK_EQUAL(assembler.packets_[n], packet(n));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testBusyPollReceiverPoll)
+{
+  const size_t packetCount = 20;
+  Tests::NullLogger logger;
+  Tests::CollectingAssembler assembler(logger);
+  Communication::BusyPollReceiver receiver(Tests::LoopbackMulticast::group(), Tests::LoopbackMulticast::loopback(), "0.0.0.0", port);
+  // Fewer buffers than packets, so buffers released by the Assembler are reused.
+  BOOST_REQUIRE(receiver.start(assembler, 1500, 3));
+  sendPackets(packetCount);
+
+  // Receive and decode on this thread.
+  for(size_t wait = 0; wait < 500 && !assembler.arrived(packetCount); ++wait)
+  {
+    if(receiver.poll() == 0)
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+  }
+  receiver.stop();
+  checkPackets(assembler, packetCount);
+  BOOST_CHECK(assembler.errors_.empty());
+  BOOST_CHECK_EQUAL(assembler.serviceThreads_.size(), 1u);
+  BOOST_CHECK(assembler.serviceThreads_.count(boost::this_thread::get_id()) == 1);
+  BOOST_CHECK_EQUAL(receiver.packetsReceived(), packetCount);
+}
+
+BOOST_AUTO_TEST_CASE(testBusyPollReceiverThread)
+{
+  const size_t packetCount = 20;
+  Tests::NullLogger logger;
+  Tests::CollectingAssembler assembler(logger);
+  Communication::BusyPollReceiver receiver(Tests::LoopbackMulticast::group(), Tests::LoopbackMulticast::loopback(), "0.0.0.0", port);
+  BOOST_REQUIRE(receiver.start(assembler, 1500, 3));
+  sendPackets(packetCount);
+
+  // Receive and decode on the polling thread until stopped.
+  receiver.runThreads(0, false);
+  bool arrived = assembler.waitFor(packetCount);
+  receiver.stop();
+  receiver.joinThreads();
+  BOOST_CHECK(arrived);
+  checkPackets(assembler, packetCount);
+  BOOST_CHECK(assembler.errors_.empty());
+  BOOST_CHECK_EQUAL(assembler.serviceThreads_.size(), 1u);
+  BOOST_CHECK(assembler.serviceThreads_.count(boost::this_thread::get_id()) == 0);
+  BOOST_CHECK_EQUAL(receiver.packetsReceived(), packetCount);
+}
+
+BOOST_AUTO_TEST_CASE(testBusyPollReceiverDecodeThread)
+{
+  const size_t packetCount = 20;
+  Tests::NullLogger logger;
+  Tests::CollectingAssembler assembler(logger);
+  Communication::BusyPollReceiver receiver(Tests::LoopbackMulticast::group(), Tests::LoopbackMulticast::loopback(), "0.0.0.0", port);
+  // The receiving thread cannot be pinned to a CPU that does not exist.
+  receiver.setCpu(1023);
+  receiver.setDecodeThread(true);
+  BOOST_REQUIRE(receiver.start(assembler, 1500, 3));
+  sendPackets(packetCount);
+  receiver.runThreads(0, false);
+  bool arrived = assembler.waitFor(packetCount, 1);
+  receiver.stop();
+  receiver.joinThreads();
+  BOOST_CHECK(arrived);
+  checkPackets(assembler, packetCount);
+
+  // The receiving thread's error was reported by the decoding thread.
+  BOOST_REQUIRE_EQUAL(assembler.errors_.size(), 1u);
+  BOOST_CHECK_EQUAL(assembler.errors_[0], "BusyPollReceiver: Cannot pin thread to CPU.");
+  BOOST_CHECK_EQUAL(assembler.serviceThreads_.size(), 1u);
+  BOOST_CHECK(assembler.errorThreads_ == assembler.serviceThreads_);
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/Decoder.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/ColumnarBuilder.h>
+#include <Tests/RefreshTemplate.h>
+
+#include <sstream>
+
+using namespace QuickFAST;
+
+namespace
+{
+  /// Read the header of one batch, then skip its columns.
+  class BatchReader
+  {
+  public:
+    explicit BatchReader(const std::string & data)
+      : data_(data)
+      , pos_(0)
+    {
+    }
+
+    bool next()
+    {
+      if(pos_ >= data_.size())
+      {
+        return false;
+      }
+      BOOST_REQUIRE_EQUAL(data_.substr(pos_, 4), "QFCB");
+      pos_ += 4;
+      name_ = readString();
+      firstRow_ = read<uint64>();
+      rows_ = read<uint32>();
+      uint32 columns = read<uint32>();
+      columnNames_.clear();
+      for(uint32 nColumn = 0; nColumn < columns; ++nColumn)
+      {
+        columnNames_.push_back(readString());
+        ValueType::Type type = ValueType::Type(read<uint32>());
+        pos_ += (rows_ + 7) / 8;
+        switch(type)
+        {
+        case ValueType::DECIMAL:
+          pos_ += rows_ * (sizeof(int64) + sizeof(int8));
+          break;
+        case ValueType::ASCII:
+        case ValueType::UTF8:
+        case ValueType::BYTEVECTOR:
+        {
+          pos_ += rows_ * sizeof(uint32);
+          // the final offset is followed by the arena size; both equal the arena size.
+          pos_ += sizeof(uint32);
+          uint32 arenaSize = read<uint32>();
+          pos_ += arenaSize;
+          break;
+        }
+        default:
+          pos_ += rows_ * sizeof(uint64);
+          break;
+        }
+      }
+      BOOST_REQUIRE(pos_ <= data_.size());
+      return true;
+    }
+
+    std::string name_;
+    uint64 firstRow_;
+    uint32 rows_;
+    std::vector<std::string> columnNames_;
+
+  private:
+    template<typename VALUE>
+    VALUE read()
+    {
+      VALUE value;
+      memcpy(&value, data_.data() + pos_, sizeof(value));
+      pos_ += sizeof(value);
+      return value;
+    }
+
+    std::string readString()
+    {
+      uint32 length = read<uint32>();
+      std::string result(data_, pos_, length);
+      pos_ += length;
+      return result;
+    }
+
+  private:
+    const std::string & data_;
+    size_t pos_;
+  };
+
+  /// Count the errors reported to it.
+  class CountingLogger : public Common::Logger
+  {
+  public:
+    CountingLogger()
+      : errors_(0)
+    {
+    }
+
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){++errors_; return false;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){++errors_; return false;}
+
+    size_t errors_;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(testColumnarBuilder)
+{
+  Codecs::TemplateRegistryPtr registry = Tests::RefreshTemplate::buildRegistry();
+  const size_t messageCount = 5;
+  std::string fast = Tests::RefreshTemplate::encode(registry, messageCount, 1, 2);
+
+  std::stringstream out;
+  // 5 messages with 0+1+2+3+4 entries.  Batches of at least 3 rows are written
+  // after a message, giving Refresh: 3 + 2 rows; Refresh.Entries: 3 + 3 + 4 rows
+  CountingLogger logger;
+  Codecs::ColumnarBuilder builder(*registry, out, logger, 3);
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    decoder.decodeMessage(source, builder);
+  }
+  builder.flush();
+  BOOST_CHECK_EQUAL(builder.batchCount(), 5u);
+  BOOST_CHECK_EQUAL(logger.errors_, 0u);
+  BOOST_CHECK(!builder.reportDecodingError("passed through"));
+  BOOST_CHECK_EQUAL(logger.errors_, 1u);
+
+  std::string data = out.str();
+  BatchReader reader(data);
+  size_t messageRows = 0;
+  size_t entryRows = 0;
+  while(reader.next())
+  {
+    if(reader.name_ == "Refresh")
+    {
+      BOOST_CHECK_EQUAL(reader.firstRow_, uint64(messageRows));
+      BOOST_REQUIRE_EQUAL(reader.columnNames_.size(), 4u);
+      BOOST_CHECK_EQUAL(reader.columnNames_[0], "SeqNum");
+      BOOST_CHECK_EQUAL(reader.columnNames_[3], "Entries");
+      messageRows += reader.rows_;
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(reader.name_, "Refresh.Entries");
+      BOOST_CHECK_EQUAL(reader.firstRow_, uint64(entryRows));
+      BOOST_REQUIRE_EQUAL(reader.columnNames_.size(), 3u);
+      BOOST_CHECK_EQUAL(reader.columnNames_[0], "_parent");
+      BOOST_CHECK_EQUAL(reader.columnNames_[2], "Side");
+      entryRows += reader.rows_;
+    }
+  }
+  BOOST_CHECK_EQUAL(messageRows, messageCount);
+  BOOST_CHECK_EQUAL(entryRows, 0u + 1u + 2u + 3u + 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testColumnarBuilderIgnoredMessage)
+{
+  Codecs::TemplateRegistryPtr registry = Tests::RefreshTemplate::buildRegistry();
+  Codecs::TemplateRegistryPtr ignored = Tests::RefreshTemplate::buildRegistry(true);
+  // Messages with 0, 1, 2 and 3 entries.
+  std::string fast = Tests::RefreshTemplate::encode(registry, 4);
+  // An ignored message with 4 entries: more than a batch of child rows.
+  std::string fastIgnored;
+  {
+    Codecs::Encoder encoder(ignored);
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, Tests::RefreshTemplate::id, *Tests::RefreshTemplate::buildMessage(99, 4, true));
+    destination.toString(fastIgnored);
+  }
+
+  std::stringstream out;
+  CountingLogger logger;
+  Codecs::ColumnarBuilder builder(*registry, out, logger, 2);
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  Codecs::Decoder ignoringDecoder(ignored);
+  Codecs::DataSourceString ignoredSource(fastIgnored);
+  for(size_t n = 0; n < 4; ++n)
+  {
+    decoder.decodeMessage(source, builder);
+    if(n == 1)
+    {
+      ignoringDecoder.decodeMessage(ignoredSource, builder);
+    }
+  }
+  builder.flush();
+
+  std::string data = out.str();
+  BatchReader reader(data);
+  size_t messageRows = 0;
+  size_t entryRows = 0;
+  while(reader.next())
+  {
+    if(reader.name_ == "Refresh")
+    {
+      BOOST_CHECK_EQUAL(reader.firstRow_, uint64(messageRows));
+      messageRows += reader.rows_;
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(reader.firstRow_, uint64(entryRows));
+      entryRows += reader.rows_;
+    }
+  }
+  // Nothing from the ignored message was written.
+  BOOST_CHECK_EQUAL(messageRows, 4u);
+  BOOST_CHECK_EQUAL(entryRows, 0u + 1u + 2u + 3u);
+  BOOST_CHECK_EQUAL(logger.errors_, 0u);
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/DataDestination.h>
+#include <Communication/LinkedBuffer.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  void putString(Codecs::DataDestination & destination, const char * value)
+  {
+    destination.putBytes(reinterpret_cast<const uchar *>(value), strlen(value));
+  }
+
+  std::string contiguous(Codecs::DataDestination & destination)
+  {
+    Communication::LinkedBuffer buffer;
+    destination.toLinkedBuffer(buffer);
+    BOOST_CHECK(buffer.get() == destination.data());
+    return std::string(reinterpret_cast<const char *>(buffer.get()), buffer.used());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDataDestinationBackPatch)
+{
+  Codecs::DataDestination destination;
+
+  // The header is filled in after the body, into room reserved for it.
+  Codecs::DataDestination::BufferHandle header = destination.startBuffer();
+  destination.startBuffer(3);
+  putString(destination, "body");
+  Codecs::DataDestination::BufferHandle body = destination.getBuffer();
+  destination.selectBuffer(header);
+  putString(destination, "H");
+  destination.selectBuffer(body);
+  putString(destination, "!");
+  destination.endMessage();
+  BOOST_CHECK_EQUAL(destination.length(), 6u);
+  BOOST_CHECK_EQUAL(contiguous(destination), "Hbody!");
+
+  // A second message: the unused room is between messages.
+  header = destination.startBuffer();
+  destination.startBuffer(3);
+  putString(destination, "second");
+  body = destination.getBuffer();
+  destination.selectBuffer(header);
+  putString(destination, "HH");
+  destination.selectBuffer(body);
+  destination.endMessage();
+  BOOST_CHECK_EQUAL(contiguous(destination), "Hbody!HHsecond");
+
+  // The header overflows the room reserved for it.
+  header = destination.startBuffer();
+  destination.startBuffer(1);
+  putString(destination, "third");
+  body = destination.getBuffer();
+  destination.selectBuffer(header);
+  putString(destination, "HHHH");
+  destination.selectBuffer(body);
+  putString(destination, "!");
+  destination.endMessage();
+  std::string expected("Hbody!HHsecondHHHHthird!");
+  BOOST_CHECK_EQUAL(contiguous(destination), expected);
+
+  std::string result;
+  destination.toString(result);
+  BOOST_CHECK_EQUAL(result, expected);
+
+  // enough data to force the buffer to grow
+  destination.clear();
+  std::string large;
+  for(size_t n = 0; n < 100; ++n)
+  {
+    header = destination.startBuffer();
+    destination.startBuffer(2);
+    putString(destination, "0123456789");
+    body = destination.getBuffer();
+    destination.selectBuffer(header);
+    destination.putByte(uchar('A' + n % 26));
+    destination.selectBuffer(body);
+    destination.endMessage();
+    large += char('A' + n % 26);
+    large += "0123456789";
+  }
+  BOOST_CHECK_EQUAL(contiguous(destination), large);
+}
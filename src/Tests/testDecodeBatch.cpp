@@ -0,0 +1,172 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionInt32.h>
+#include <Codecs/FieldInstructionUInt64.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldOpCopy.h>
+#include <Codecs/FieldOpDelta.h>
+#include <Codecs/FieldOpIncrement.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldAscii.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  Messages::FieldIdentity identity_u32nop("u32nop");
+  Messages::FieldIdentity identity_i32nop("i32nop");
+  Messages::FieldIdentity identity_u64copy("u64copy");
+  Messages::FieldIdentity identity_u32incr("u32incr");
+  Messages::FieldIdentity identity_asciidelta("asciidelta");
+
+  void addInstruction(
+    Codecs::TemplatePtr & templ,
+    Codecs::FieldInstruction * instruction,
+    bool mandatory,
+    Codecs::FieldOp * fieldOp = 0)
+  {
+    Codecs::FieldInstructionPtr field(instruction);
+    field->setPresence(mandatory);
+    if(fieldOp != 0)
+    {
+      field->setFieldOp(Codecs::FieldOpPtr(fieldOp));
+    }
+    templ->addInstruction(field);
+  }
+
+  Codecs::TemplateRegistryPtr buildRegistry()
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setId(1);
+    templ->setTemplateName("BatchTest");
+    addInstruction(templ, new Codecs::FieldInstructionUInt32("u32nop", ""), true);
+    addInstruction(templ, new Codecs::FieldInstructionInt32("i32nop", ""), false);
+    addInstruction(templ, new Codecs::FieldInstructionUInt64("u64copy", ""), true, new Codecs::FieldOpCopy);
+    addInstruction(templ, new Codecs::FieldInstructionUInt32("u32incr", ""), true, new Codecs::FieldOpIncrement);
+    addInstruction(templ, new Codecs::FieldInstructionAscii("asciidelta", ""), true, new Codecs::FieldOpDelta);
+
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+    registry->addTemplate(templ);
+    registry->finalize();
+    return registry;
+  }
+
+  Messages::MessagePtr buildMessage(size_t n)
+  {
+    Messages::MessagePtr msg(new Messages::Message(10));
+    msg->addField(identity_u32nop, Messages::FieldUInt32::create(uint32(n * 1000)));
+    if(n % 3 != 1)
+    {
+      msg->addField(identity_i32nop, Messages::FieldInt32::create(-int32(n)));
+    }
+    msg->addField(identity_u64copy, Messages::FieldUInt64::create(uint64(n / 3) << 40));
+    msg->addField(identity_u32incr, Messages::FieldUInt32::create(uint32(n + 10)));
+    std::string ascii("ABCDEFG");
+    ascii += char('a' + n);
+    msg->addField(identity_asciidelta, Messages::FieldAscii::create(ascii));
+    return msg;
+  }
+
+  bool compareMessages(const Messages::Message & lhs, const Messages::Message & rhs)
+  {
+    std::stringstream reason;
+    if(!lhs.equals(rhs, reason))
+    {
+      std::cerr << "Reason: " << reason.str() << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  /// Encode messageCount messages back to back, recording the size of each.
+  std::string buildPacket(Codecs::TemplateRegistryPtr & registry, size_t messageCount, std::vector<size_t> & sizes)
+  {
+    Codecs::Encoder encoder(registry);
+    std::string packet;
+    for(size_t n = 0; n < messageCount; ++n)
+    {
+      Codecs::DataDestination destination;
+      encoder.encodeMessage(destination, 1, *buildMessage(n));
+      std::string fast;
+      destination.toString(fast);
+      packet += fast;
+      sizes.push_back(fast.size());
+    }
+    return packet;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDecodeBatch)
+{
+  Codecs::TemplateRegistryPtr registry = buildRegistry();
+  const size_t messageCount = 12;
+  std::vector<size_t> sizes;
+  std::string packet = buildPacket(registry, messageCount, sizes);
+  const uchar * data = reinterpret_cast<const uchar *>(packet.data());
+
+  Codecs::Decoder decoder(registry);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  // The whole packet at once
+  size_t bytesUsed = 0;
+  BOOST_CHECK_EQUAL(decoder.decodeBatch(data, packet.size(), builder, bytesUsed), messageCount);
+  BOOST_CHECK_EQUAL(bytesUsed, packet.size());
+  BOOST_CHECK(compareMessages(*buildMessage(messageCount - 1), consumer.message()));
+
+  // One message at a time
+  decoder.reset();
+  size_t offset = 0;
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    BOOST_CHECK_EQUAL(decoder.decodeBatch(data + offset, packet.size() - offset, builder, bytesUsed, 1), 1u);
+    BOOST_CHECK_EQUAL(bytesUsed, sizes[n]);
+    BOOST_CHECK(compareMessages(*buildMessage(n), consumer.message()));
+    offset += bytesUsed;
+  }
+  BOOST_CHECK_EQUAL(decoder.decodeBatch(data + offset, packet.size() - offset, builder, bytesUsed), 0u);
+  BOOST_CHECK_EQUAL(bytesUsed, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testDecodeBatchTruncated)
+{
+  Codecs::TemplateRegistryPtr registry = buildRegistry();
+  std::vector<size_t> sizes;
+  std::string packet = buildPacket(registry, 3, sizes);
+  const uchar * data = reinterpret_cast<const uchar *>(packet.data());
+
+  Codecs::Decoder decoder(registry);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  // Only the presence map of the first message: it ends in an integer field,
+  // which is an error, and nothing was consumed.
+  size_t bytesUsed = 99;
+  BOOST_CHECK_THROW(decoder.decodeBatch(data, 1, builder, bytesUsed), EncodingError);
+  BOOST_CHECK_EQUAL(bytesUsed, 0u);
+
+  // bytesUsed covers the messages that were delivered before the error
+  decoder.reset();
+  BOOST_CHECK_THROW(decoder.decodeBatch(data, sizes[0] + sizes[1] + 1, builder, bytesUsed), EncodingError);
+  BOOST_CHECK_EQUAL(bytesUsed, sizes[0] + sizes[1]);
+  BOOST_CHECK(compareMessages(*buildMessage(1), consumer.message()));
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/DecodePlan.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionInt32.h>
+#include <Codecs/FieldInstructionUInt64.h>
+#include <Codecs/FieldInstructionInt64.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldOpConstant.h>
+#include <Codecs/FieldOpCopy.h>
+#include <Codecs/FieldOpDelta.h>
+#include <Codecs/FieldOpIncrement.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  Messages::FieldIdentity identity_u32nop("u32nop");
+  Messages::FieldIdentity identity_i32nop("i32nop");
+  Messages::FieldIdentity identity_u64copy("u64copy");
+  Messages::FieldIdentity identity_i64copy("i64copy");
+  Messages::FieldIdentity identity_u32incr("u32incr");
+  Messages::FieldIdentity identity_asciidelta("asciidelta");
+  Messages::FieldIdentity identity_decimal("decimal");
+  Messages::FieldIdentity identity_u32const("u32const");
+
+  void addInstruction(
+    Codecs::TemplatePtr & templ,
+    Codecs::FieldInstruction * instruction,
+    bool mandatory,
+    Codecs::FieldOp * fieldOp = 0)
+  {
+    Codecs::FieldInstructionPtr field(instruction);
+    field->setPresence(mandatory);
+    if(fieldOp != 0)
+    {
+      field->setFieldOp(Codecs::FieldOpPtr(fieldOp));
+    }
+    templ->addInstruction(field);
+  }
+
+  Codecs::TemplateRegistryPtr buildRegistry()
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setId(1);
+    templ->setTemplateName("PlanTest");
+    addInstruction(templ, new Codecs::FieldInstructionUInt32("u32nop", ""), true);
+    addInstruction(templ, new Codecs::FieldInstructionInt32("i32nop", ""), false);
+    addInstruction(templ, new Codecs::FieldInstructionUInt64("u64copy", ""), true, new Codecs::FieldOpCopy);
+    addInstruction(templ, new Codecs::FieldInstructionInt64("i64copy", ""), false, new Codecs::FieldOpCopy);
+    addInstruction(templ, new Codecs::FieldInstructionUInt32("u32incr", ""), true, new Codecs::FieldOpIncrement);
+    addInstruction(templ, new Codecs::FieldInstructionAscii("asciidelta", ""), true, new Codecs::FieldOpDelta);
+    addInstruction(templ, new Codecs::FieldInstructionDecimal("decimal", ""), false);
+    Codecs::FieldOp * constant = new Codecs::FieldOpConstant;
+    constant->setValue("42");
+    addInstruction(templ, new Codecs::FieldInstructionUInt32("u32const", ""), true, constant);
+
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+    registry->addTemplate(templ);
+    registry->finalize();
+    return registry;
+  }
+
+  Messages::MessagePtr buildMessage(size_t n, bool optionalPresent)
+  {
+    Messages::MessagePtr msg(new Messages::Message(10));
+    msg->addField(identity_u32nop, Messages::FieldUInt32::create(uint32(n * 1000)));
+    if(optionalPresent)
+    {
+      msg->addField(identity_i32nop, Messages::FieldInt32::create(-int32(n)));
+    }
+    msg->addField(identity_u64copy, Messages::FieldUInt64::create(uint64(n / 3) << 40));
+    if(optionalPresent)
+    {
+      msg->addField(identity_i64copy, Messages::FieldInt64::create(-int64(n / 2) * 100000000LL));
+    }
+    msg->addField(identity_u32incr, Messages::FieldUInt32::create(uint32(n + 10)));
+    std::string ascii("ABCDEFG");
+    ascii += char('a' + n);
+    msg->addField(identity_asciidelta, Messages::FieldAscii::create(ascii));
+    if(optionalPresent)
+    {
+      msg->addField(identity_decimal, Messages::FieldDecimal::create(Decimal(12345, -2)));
+    }
+    msg->addField(identity_u32const, Messages::FieldUInt32::create(42));
+    return msg;
+  }
+
+  bool compareMessages(const Messages::Message & lhs, const Messages::Message & rhs)
+  {
+    std::stringstream reason;
+    if(!lhs.equals(rhs, reason))
+    {
+      std::cerr << "Reason: " << reason.str() << std::endl;
+      return false;
+    }
+    return true;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDecodePlanCompile)
+{
+  Codecs::TemplateRegistryPtr registry = buildRegistry();
+  Codecs::TemplateCPtr templ;
+  BOOST_REQUIRE(registry->getTemplate(1, templ));
+  const Codecs::DecodePlan & plan = templ->getDecodePlan();
+  BOOST_REQUIRE(plan.isCompiled());
+  BOOST_REQUIRE_EQUAL(plan.size(), templ->size());
+  BOOST_CHECK_EQUAL(plan[0].opCode, Codecs::DecodePlan::UINT32_NOP);
+  BOOST_CHECK_EQUAL(plan[1].opCode, Codecs::DecodePlan::INT32_NOP);
+  BOOST_CHECK(!plan[1].mandatory);
+  BOOST_CHECK_EQUAL(plan[2].opCode, Codecs::DecodePlan::UINT64_COPY);
+  BOOST_CHECK_EQUAL(plan[3].opCode, Codecs::DecodePlan::INT64_COPY);
+  BOOST_CHECK(plan[2].dictionaryIndex != plan[3].dictionaryIndex);
+  BOOST_CHECK_EQUAL(plan[4].opCode, Codecs::DecodePlan::INCREMENT);
+  BOOST_CHECK_EQUAL(plan[5].opCode, Codecs::DecodePlan::DELTA);
+  BOOST_CHECK_EQUAL(plan[6].opCode, Codecs::DecodePlan::NOP);
+  BOOST_CHECK_EQUAL(plan[7].opCode, Codecs::DecodePlan::CONSTANT);
+  BOOST_CHECK(plan[0].instruction == templ->getInstruction(0).get());
+}
+
+BOOST_AUTO_TEST_CASE(testDecodePlanMatchesFieldOpDecoding)
+{
+  Codecs::TemplateRegistryPtr registry = buildRegistry();
+  Codecs::Encoder encoder(registry);
+  Codecs::Decoder normalDecoder(registry);
+  Codecs::Decoder planDecoder(registry);
+  planDecoder.setUseDecodePlan(true);
+  BOOST_CHECK(planDecoder.getUseDecodePlan());
+  BOOST_CHECK(!normalDecoder.getUseDecodePlan());
+
+  for(size_t n = 0; n < 12; ++n)
+  {
+    Messages::MessagePtr msg = buildMessage(n, (n % 3) != 1);
+    Codecs::DataDestination destination;
+    encoder.encodeMessage(destination, 1, *msg);
+    std::string fast;
+    destination.toString(fast);
+
+    Codecs::DataSourceString normalSource(fast);
+    Codecs::SingleMessageConsumer normalConsumer;
+    Codecs::GenericMessageBuilder normalBuilder(normalConsumer);
+    normalDecoder.decodeMessage(normalSource, normalBuilder);
+
+    Codecs::DataSourceString planSource(fast);
+    Codecs::SingleMessageConsumer planConsumer;
+    Codecs::GenericMessageBuilder planBuilder(planConsumer);
+    planDecoder.decodeMessage(planSource, planBuilder);
+
+    BOOST_CHECK(compareMessages(*msg, normalConsumer.message()));
+    BOOST_CHECK(compareMessages(normalConsumer.message(), planConsumer.message()));
+  }
+}
@@ -321,6 +321,7 @@ BOOST_AUTO_TEST_CASE(TestPacketSequencingAssemblerReorderAndGapDetect)
   BOOST_REQUIRE_EQUAL(builder.valueCount(), 2);
   BOOST_REQUIRE(builder.value(1) == reinterpret_cast<std::ptrdiff_t> (buffer23.extra()));
   BOOST_CHECK(!builder.hasError());
+  BOOST_CHECK_EQUAL(assembler.lineCount(), 1u);
 }
 
 void faultyHeader()
@@ -491,3 +492,145 @@ BOOST_AUTO_TEST_CASE(TestPacketSequencingAssemblerGapFill)
   BOOST_CHECK_EQUAL(builder.value(3), reinterpret_cast<std::ptrdiff_t> (buffer14.extra()));
   BOOST_CHECK_EQUAL(builder.value(4), reinterpret_cast<std::ptrdiff_t> (buffer15.extra()));
 }
+
+BOOST_AUTO_TEST_CASE(TestPacketSequencingAssemblerArbitration)
+{
+  std::stringstream templateStream(template_xml);
+  Codecs::XMLTemplateParser parser;
+  Codecs::TemplateRegistryPtr templateRegistry =
+    parser.parse(templateStream);
+
+  bool bigEndian = ByteSwapper::isBigEndian();
+  Codecs::FixedSizeHeaderAnalyzer packetHeaderAnalyzer(0, bigEndian, 4, 0, 0, 4);
+  Codecs::NoHeaderAnalyzer messageHeaderAnalyzer;
+
+  Messages::SequentialSingleValueBuilder<uint32> builder;
+  size_t lookAheadCount = 4;
+  Communication::RecoveryFeedPtr recoveryFeed; // no recovery feed
+  Codecs::PacketSequencingAssembler assembler(
+      templateRegistry,
+      packetHeaderAnalyzer,
+      messageHeaderAnalyzer,
+      builder,
+      lookAheadCount,
+      recoveryFeed);
+  TestReceiver receiver;
+
+  // buffers are the A line; bufferBs are the B line
+  for(size_t nBuffer = 0; buffers[nBuffer] != 0; ++nBuffer)
+  {
+    buffers[nBuffer]->setSource(0);
+    bufferBs[nBuffer]->setSource(1);
+  }
+
+  ////////////////////////////////
+  // The first copy of each packet is decoded
+  receiver.acceptBuffer(&buffer0);
+  receiver.acceptBuffer(&bufferB0);
+  receiver.acceptBuffer(&bufferB1);
+  receiver.acceptBuffer(&buffer1);
+  assembler.serviceQueue(receiver);
+  BOOST_REQUIRE_EQUAL(builder.valueCount(), 2);
+  BOOST_CHECK_EQUAL(builder.value(0), reinterpret_cast<std::ptrdiff_t> (buffer0.extra()));
+  BOOST_CHECK_EQUAL(builder.value(1), reinterpret_cast<std::ptrdiff_t> (bufferB1.extra()));
+
+  ////////////////////////////////
+  // A loses packet 2: wait for B to fill it
+  builder.reset();
+  receiver.acceptBuffer(&buffer3);
+  assembler.serviceQueue(receiver);
+  BOOST_CHECK_EQUAL(builder.valueCount(), 0);
+  BOOST_CHECK(!builder.hasGap());
+  receiver.acceptBuffer(&bufferB2);
+  receiver.acceptBuffer(&bufferB3);
+  assembler.serviceQueue(receiver);
+  BOOST_REQUIRE_EQUAL(builder.valueCount(), 2);
+  BOOST_CHECK_EQUAL(builder.value(0), reinterpret_cast<std::ptrdiff_t> (bufferB2.extra()));
+  BOOST_CHECK_EQUAL(builder.value(1), reinterpret_cast<std::ptrdiff_t> (buffer3.extra()));
+  BOOST_CHECK(!builder.hasGap());
+
+  ////////////////////////////////
+  // Both lines lose packet 4: the gap is declared
+  // as soon as both lines have passed it, even though
+  // packet 5 is within the look-ahead range.
+  builder.reset();
+  receiver.acceptBuffer(&buffer5);
+  assembler.serviceQueue(receiver);
+  BOOST_CHECK_EQUAL(builder.valueCount(), 0);
+  BOOST_CHECK(!builder.hasGap());
+  receiver.acceptBuffer(&bufferB5);
+  assembler.serviceQueue(receiver);
+  BOOST_CHECK(builder.hasGap());
+  BOOST_REQUIRE_EQUAL(builder.valueCount(), 1);
+  BOOST_CHECK_EQUAL(builder.value(0), reinterpret_cast<std::ptrdiff_t> (buffer5.extra()));
+  BOOST_CHECK(!builder.hasError());
+
+  // buffer0 arrived before line B was known, so it was not timed
+  // and bufferB0 is lost without a lag.
+  BOOST_REQUIRE_EQUAL(assembler.lineCount(), 2u);
+  const Codecs::PacketSequencingAssembler::LineStatistics & lineA = assembler.lineStatistics(0);
+  BOOST_CHECK_EQUAL(lineA.packets_, 4u);
+  BOOST_CHECK_EQUAL(lineA.won_, 3u);
+  BOOST_CHECK_EQUAL(lineA.lost_, 1u);
+  BOOST_CHECK_EQUAL(lineA.lagged_, 1u);
+  const Codecs::PacketSequencingAssembler::LineStatistics & lineB = assembler.lineStatistics(1);
+  BOOST_CHECK_EQUAL(lineB.packets_, 5u);
+  BOOST_CHECK_EQUAL(lineB.won_, 2u);
+  BOOST_CHECK_EQUAL(lineB.lost_, 3u);
+  BOOST_CHECK_EQUAL(lineB.lagged_, 2u);
+  BOOST_CHECK(lineB.maxLag_ >= lineB.totalLag_ / 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestPacketSequencingAssemblerArbitrationDeferred)
+{
+  std::stringstream templateStream(template_xml);
+  Codecs::XMLTemplateParser parser;
+  Codecs::TemplateRegistryPtr templateRegistry =
+    parser.parse(templateStream);
+
+  bool bigEndian = ByteSwapper::isBigEndian();
+  Codecs::FixedSizeHeaderAnalyzer packetHeaderAnalyzer(0, bigEndian, 4, 0, 0, 4);
+  Codecs::NoHeaderAnalyzer messageHeaderAnalyzer;
+
+  Messages::SequentialSingleValueBuilder<uint32> builder;
+  size_t lookAheadCount = 4;
+  Communication::RecoveryFeedPtr recoveryFeed; // no recovery feed
+  Codecs::PacketSequencingAssembler assembler(
+      templateRegistry,
+      packetHeaderAnalyzer,
+      messageHeaderAnalyzer,
+      builder,
+      lookAheadCount,
+      recoveryFeed);
+  TestReceiver receiver;
+
+  // buffers are the A line; bufferBs are the B line
+  for(size_t nBuffer = 0; buffers[nBuffer] != 0; ++nBuffer)
+  {
+    buffers[nBuffer]->setSource(0);
+    bufferBs[nBuffer]->setSource(1);
+  }
+
+  // Packet 1 is missing, so packet 2 waits in the look-ahead while packet 6
+  // (the same look-ahead slot) is deferred.  B's copy of packet 2 is still a
+  // duplicate.
+  receiver.acceptBuffer(&bufferB0);
+  receiver.acceptBuffer(&buffer2);
+  receiver.acceptBuffer(&buffer6);
+  receiver.acceptBuffer(&bufferB2);
+  assembler.serviceQueue(receiver);
+
+  BOOST_REQUIRE_EQUAL(assembler.lineCount(), 2u);
+  const Codecs::PacketSequencingAssembler::LineStatistics & lineA = assembler.lineStatistics(0);
+  BOOST_CHECK_EQUAL(lineA.packets_, 2u);
+  BOOST_CHECK_EQUAL(lineA.won_, 2u);
+  BOOST_CHECK_EQUAL(lineA.lost_, 0u);
+  const Codecs::PacketSequencingAssembler::LineStatistics & lineB = assembler.lineStatistics(1);
+  BOOST_CHECK_EQUAL(lineB.packets_, 2u);
+  BOOST_CHECK_EQUAL(lineB.won_, 1u);
+  BOOST_CHECK_EQUAL(lineB.lost_, 1u);
+  BOOST_CHECK_EQUAL(lineB.lagged_, 1u);
+  // each of the three packets was won exactly once.
+  BOOST_CHECK_EQUAL(lineA.won_ + lineB.won_, 3u);
+  BOOST_CHECK_EQUAL(lineA.won_ + lineA.lost_ + lineB.won_ + lineB.lost_, lineA.packets_ + lineB.packets_);
+}
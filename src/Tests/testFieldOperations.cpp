@@ -2615,3 +2615,160 @@ Flag    -1     1     -1      1     FF
   BOOST_CHECK(pmap == pmapResult);
 }
 
+
+namespace
+{
+  void decodeStrings(Codecs::DataSource & source, Messages::Message & message)
+  {
+    Codecs::DictionaryIndexer indexer;
+    Codecs::PresenceMap pmap(1);
+
+    Codecs::FieldInstructionAscii ascii("Symbol", "");
+    ascii.setPresence(true);
+    ascii.indexDictionaries(indexer, "global", "", "");
+    Codecs::FieldInstructionByteVector bytes("Data", "");
+    bytes.setPresence(false);
+    bytes.indexDictionaries(indexer, "global", "", "");
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3,3,indexer.size()));
+    ascii.finalize(*registry);
+    bytes.finalize(*registry);
+    Codecs::Decoder decoder(registry);
+
+    Codecs::SingleMessageConsumer consumer;
+    Codecs::GenericMessageBuilder builder(consumer);
+    builder.startMessage("UNIT_TEST", "", 10);
+    ascii.decode(source, pmap, decoder, builder);
+    bytes.decode(source, pmap, decoder, builder);
+    ascii.decode(source, pmap, decoder, builder);
+    BOOST_REQUIRE(builder.endMessage(builder));
+    message.swap(consumer.message());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testStringsSplitAcrossBuffers)
+{
+  // The string decoders take a shortcut when a value is contiguous in the
+  // source's buffer.  Make sure the results match when values straddle buffers.
+  // ASCII "IBM", optional byte vector (length 4 + 1 for nullable) "\x01\x02\x80\xFF", ASCII "MSFT"
+  const char testData[] = "\x49\x42\xCD\x85\x01\x02\x80\xFF\x4D\x53\x46\xD4";
+  std::string testString(testData, sizeof(testData)-1);
+
+  Codecs::DataSourceString contiguousSource(testString);
+  Messages::Message contiguous(3);
+  decodeStrings(contiguousSource, contiguous);
+
+  std::istringstream stream(testString);
+  Codecs::DataSourceStream splitSource(stream, 3);
+  Messages::Message split(3);
+  decodeStrings(splitSource, split);
+
+  uchar byte;
+  BOOST_CHECK(!contiguousSource.getByte(byte));
+  BOOST_CHECK(!splitSource.getByte(byte));
+
+  Messages::Message * messages[] = {&contiguous, &split};
+  for(size_t nMessage = 0; nMessage < 2; ++nMessage)
+  {
+    Messages::Message & message = *messages[nMessage];
+    BOOST_REQUIRE_EQUAL(message.size(), 3);
+    Messages::FieldSet::const_iterator pFieldEntry = message.begin();
+    BOOST_CHECK_EQUAL(pFieldEntry->getField()->toAscii(), "IBM");
+    ++pFieldEntry;
+    std::string data = pFieldEntry->getField()->toByteVector();
+    BOOST_CHECK(data == std::string("\x01\x02\x80\xFF", 4));
+    ++pFieldEntry;
+    BOOST_CHECK_EQUAL(pFieldEntry->getField()->toAscii(), "MSFT");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryReset)
+{
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3, 3, 3));
+  Codecs::Decoder decoder(registry);
+
+  uint32 value = 0;
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::UNDEFINED_VALUE);
+  decoder.setDictionaryValue(0, uint32(17));
+  decoder.setDictionaryValueNull(1);
+  const uchar * string = 0;
+  size_t length = 0;
+  decoder.setDictionaryValue(2, reinterpret_cast<const uchar *>("CME"), 3);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(value, 17u);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(1, value), Codecs::Context::NULL_VALUE);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(2, string, length), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char *>(string), length), "CME");
+
+  decoder.reset();
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::UNDEFINED_VALUE);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(1, value), Codecs::Context::UNDEFINED_VALUE);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(2, string, length), Codecs::Context::UNDEFINED_VALUE);
+
+  decoder.setDictionaryValue(2, reinterpret_cast<const uchar *>("NYSE"), 4);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(2, string, length), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char *>(string), length), "NYSE");
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::UNDEFINED_VALUE);
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryStrings)
+{
+  BOOST_CHECK_EQUAL(sizeof(Codecs::DictionaryEntry), 16u);
+
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3, 3, 3));
+  Codecs::Decoder decoder(registry);
+  const uchar * string = 0;
+  size_t length = 0;
+
+  // Grow one entry past its block while its neighbor keeps its value.
+  decoder.setDictionaryValue(0, std::string("AB"));
+  decoder.setDictionaryValue(1, std::string("XYZ"));
+  std::string expected("AB");
+  for(size_t n = 0; n < 40; ++n)
+  {
+    decoder.replaceDictionaryString(0, expected.size(), 0, reinterpret_cast<const uchar *>("CD"), 2);
+    expected += "CD";
+  }
+  decoder.replaceDictionaryString(0, 0, 1, reinterpret_cast<const uchar *>("Q"), 1);
+  expected[0] = 'Q';
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, string, length), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char *>(string), length), expected);
+  std::string value;
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(1, value), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(value, "XYZ");
+
+  // Shrinking reuses the block.
+  decoder.setDictionaryValue(0, "short");
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(value, "short");
+}
+
+BOOST_AUTO_TEST_CASE(testDictionaryStringFromArena)
+{
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3, 3, 3));
+  Codecs::Decoder decoder(registry);
+  const uchar * string = 0;
+  size_t length = 0;
+  std::string value;
+
+  // Pass values that point into the dictionary's own storage while each
+  // store grows the storage enough to move it.
+  std::string expected(100, 'A');
+  decoder.setDictionaryValue(0, expected);
+  for(size_t n = 0; n < 6; ++n)
+  {
+    BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, string, length), Codecs::Context::OK_VALUE);
+    decoder.setDictionaryValue(1, string, length);
+    BOOST_CHECK_EQUAL(decoder.getDictionaryValue(1, string, length), Codecs::Context::OK_VALUE);
+    decoder.replaceDictionaryString(0, expected.size(), 0, string, length);
+    expected += expected;
+    BOOST_CHECK_EQUAL(decoder.getDictionaryValue(0, value), Codecs::Context::OK_VALUE);
+    BOOST_CHECK_EQUAL(value, expected);
+  }
+
+  // Replace part of an entry with part of itself.
+  decoder.setDictionaryValue(2, std::string("ABCDEF"));
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(2, string, length), Codecs::Context::OK_VALUE);
+  decoder.replaceDictionaryString(2, 0, 1, string + 2, 3);
+  BOOST_CHECK_EQUAL(decoder.getDictionaryValue(2, value), Codecs::Context::OK_VALUE);
+  BOOST_CHECK_EQUAL(value, "CDEBCDEF");
+}
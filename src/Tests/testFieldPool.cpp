@@ -0,0 +1,63 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Messages/FieldPool.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+
+using namespace QuickFAST;
+
+BOOST_AUTO_TEST_CASE(testFieldPoolRecycles)
+{
+  // warm up the pool
+  {
+    Messages::FieldCPtr a = Messages::FieldUInt32::create(1);
+    Messages::FieldCPtr b = Messages::FieldAscii::create("warm");
+  }
+  Messages::FieldPool::resetStatistics();
+
+  const size_t count = 1000;
+  for(size_t n = 0; n < count; ++n)
+  {
+    Messages::FieldCPtr integer = Messages::FieldUInt32::create(uint32(n));
+    Messages::FieldCPtr ascii = Messages::FieldAscii::create("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    Messages::FieldCPtr decimal = Messages::FieldDecimal::create(Decimal(12345, -2));
+    BOOST_CHECK_EQUAL(integer->toUInt32(), uint32(n));
+    BOOST_CHECK_EQUAL(ascii->toAscii(), "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  }
+
+  Messages::FieldPool::Statistics statistics;
+  Messages::FieldPool::getStatistics(statistics);
+  BOOST_CHECK_EQUAL(statistics.allocations_, 3 * count);
+  BOOST_CHECK_EQUAL(statistics.releases_, 3 * count);
+  // at most one miss per field that is alive at the same time
+  BOOST_CHECK(statistics.hits_ >= statistics.allocations_ - 3);
+  BOOST_CHECK_EQUAL(statistics.recycled_, statistics.releases_);
+}
+
+namespace
+{
+  void releaseFields(std::vector<Messages::FieldCPtr> * fields)
+  {
+    fields->clear();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFieldPoolAcrossThreads)
+{
+  // Fields created in one thread may be released in another.
+  std::vector<Messages::FieldCPtr> fields;
+  for(size_t n = 0; n < 100; ++n)
+  {
+    fields.push_back(Messages::FieldUInt32::create(uint32(n)));
+  }
+  boost::thread releaser(boost::bind(releaseFields, &fields));
+  releaser.join();
+  BOOST_CHECK(fields.empty());
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/Decoder.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/FlatRecordBuilder.h>
+#include <Codecs/FlatRecord.h>
+#include <Tests/RefreshTemplate.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  class RecordChecker : public Codecs::FlatRecordConsumer
+  {
+  public:
+    explicit RecordChecker(const Codecs::FlatRecordLayout & layout)
+      : records_(0)
+      , entries_(0)
+      , pricesPresent_(0)
+    {
+      BOOST_REQUIRE(layout.findSlot("SeqNum", seqNum_));
+      BOOST_REQUIRE(layout.findSlot("Symbol", symbol_));
+      BOOST_REQUIRE(layout.findSlot("Price", price_));
+      BOOST_REQUIRE(layout.findSlot("Entries", entries_slot_));
+      const Codecs::FlatRecordLayout & entry = *layout[entries_slot_].nested_;
+      BOOST_REQUIRE(entry.findSlot("Size", size_));
+      BOOST_REQUIRE(entry.findSlot("Side", side_));
+      size_t notFound;
+      BOOST_CHECK(!entry.findSlot("SeqNum", notFound));
+    }
+
+    virtual bool consumeRecord(const Codecs::FlatRecord & record)
+    {
+      BOOST_CHECK_EQUAL(record.layout().templateId(), 7u);
+      uint64 seqNum;
+      BOOST_REQUIRE(record.getUnsignedInteger(seqNum_, seqNum));
+      BOOST_CHECK_EQUAL(seqNum, uint64(records_ + 1));
+      std::string symbol;
+      BOOST_REQUIRE(record.getString(symbol_, symbol));
+      BOOST_CHECK_EQUAL(symbol, "QFST");
+      Decimal price;
+      if(record.getDecimal(price_, price))
+      {
+        BOOST_CHECK(price == Decimal(12345, -2));
+        ++pricesPresent_;
+      }
+      size_t length = 0;
+      BOOST_REQUIRE(record.getSequenceLength(entries_slot_, length));
+      for(size_t nEntry = 0; nEntry < length; ++nEntry)
+      {
+        Codecs::FlatRecord entry = record.getSequenceEntry(entries_slot_, nEntry);
+        uint64 size;
+        BOOST_REQUIRE(entry.getUnsignedInteger(size_, size));
+        BOOST_CHECK_EQUAL(size, uint64(100 * (nEntry + 1)));
+        const uchar * side = 0;
+        size_t sideLength;
+        BOOST_REQUIRE(entry.getString(side_, side, sideLength));
+        BOOST_REQUIRE_EQUAL(sideLength, 1u);
+        BOOST_CHECK_EQUAL(side[0], nEntry % 2 == 0 ? 'B' : 'S');
+      }
+      entries_ += length;
+      ++records_;
+      return true;
+    }
+
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & errorMessage)
+    {
+      BOOST_ERROR(errorMessage);
+      return true;
+    }
+    virtual bool reportCommunicationError(const std::string & errorMessage)
+    {
+      BOOST_ERROR(errorMessage);
+      return true;
+    }
+
+    size_t records_;
+    size_t entries_;
+    size_t pricesPresent_;
+
+  private:
+    size_t seqNum_;
+    size_t symbol_;
+    size_t price_;
+    size_t entries_slot_;
+    size_t size_;
+    size_t side_;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(testFlatRecordBuilder)
+{
+  Codecs::TemplateRegistryPtr registry = Tests::RefreshTemplate::buildRegistry();
+  const size_t messageCount = 4;
+  std::string fast = Tests::RefreshTemplate::encode(registry, messageCount, 5, 2);
+
+  Codecs::FlatRecordSchemaCPtr schema(new Codecs::FlatRecordSchema(*registry));
+  const Codecs::FlatRecordLayout * layout = schema->findLayout(7);
+  BOOST_REQUIRE(layout != 0);
+  BOOST_CHECK(schema->findLayout(8) == 0);
+  BOOST_CHECK_EQUAL(layout->slotCount(), 4u);
+
+  RecordChecker checker(*layout);
+  Codecs::FlatRecordBuilder builder(schema, checker);
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    decoder.decodeMessage(source, builder);
+  }
+  BOOST_CHECK_EQUAL(checker.records_, messageCount);
+  BOOST_CHECK_EQUAL(checker.entries_, 0u + 5u + 10u + 15u);
+  BOOST_CHECK_EQUAL(checker.pricesPresent_, messageCount - 1);
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Messages/FieldUInt32.h>
+#include <Messages/Message.h>
+#include <Messages/Sequence.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  /// Record where each message and sequence entry lives, and what it holds.
+  class RecordingConsumer : public Codecs::MessageConsumer
+  {
+  public:
+    RecordingConsumer(const Messages::FieldIdentity & sequenceIdentity)
+      : sequenceIdentity_(sequenceIdentity)
+      , message_(0)
+      , total_(0)
+    {
+    }
+
+    virtual bool consumeMessage(Messages::Message & message)
+    {
+      message_ = &message;
+      entries_.clear();
+      total_ = 0;
+      Messages::FieldCPtr field;
+      BOOST_REQUIRE(message.getField(sequenceIdentity_, field));
+      const Messages::SequenceCPtr & sequence = field->toSequence();
+      for(size_t nEntry = 0; nEntry < sequence->size(); ++nEntry)
+      {
+        const Messages::FieldSet & entry = *(*sequence)[nEntry];
+        entries_.insert(&entry);
+        BOOST_REQUIRE_EQUAL(entry.size(), 1u);
+        total_ += entry[0].getField()->toUInt32();
+      }
+      return true;
+    }
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){return true;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return true;}
+    virtual void decodingStarted(){}
+    virtual void decodingStopped(){}
+
+    const Messages::FieldIdentity & sequenceIdentity_;
+    const Messages::Message * message_;
+    std::set<const Messages::FieldSet *> entries_;
+    uint32 total_;
+  };
+
+  void buildMessage(
+    Codecs::GenericMessageBuilder & builder,
+    const Messages::FieldIdentity & sequenceIdentity,
+    const Messages::FieldIdentity & lengthIdentity,
+    const Messages::FieldIdentity & priceIdentity,
+    size_t entries)
+  {
+    Messages::MessageBuilder & message = builder.startMessage("Refresh", "", 2);
+    Messages::ValueMessageBuilder & sequence = message.startSequence(
+      sequenceIdentity, "", "", 1, lengthIdentity, entries);
+    for(size_t nEntry = 0; nEntry < entries; ++nEntry)
+    {
+      Messages::ValueMessageBuilder & entry = sequence.startSequenceEntry("Entry", "", 1);
+      entry.addValue(priceIdentity, ValueType::UINT32, uint32(nEntry + 1));
+      sequence.endSequenceEntry(entry);
+    }
+    message.endSequence(sequenceIdentity, sequence);
+    builder.endMessage(message);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testGenericMessageBuilderRecycling)
+{
+  Messages::FieldIdentity sequenceIdentity("MDEntries");
+  Messages::FieldIdentity lengthIdentity("NoMDEntries");
+  Messages::FieldIdentity priceIdentity("MDEntryPx");
+  RecordingConsumer consumer(sequenceIdentity);
+  Codecs::GenericMessageBuilder builder(consumer);
+  builder.setRecycling(true);
+
+  const size_t entries = 10;
+  const uint32 expectedTotal = uint32(entries * (entries + 1) / 2);
+  buildMessage(builder, sequenceIdentity, lengthIdentity, priceIdentity, entries);
+  BOOST_CHECK_EQUAL(consumer.total_, expectedTotal);
+  const Messages::Message * firstMessage = consumer.message_;
+  std::set<const Messages::FieldSet *> firstEntries = consumer.entries_;
+  BOOST_CHECK_EQUAL(firstEntries.size(), entries);
+
+  // Everything was returned when the message was released.
+  Codecs::FieldSetRecycler::Statistics statistics;
+  builder.fieldSetRecycler()->getStatistics(statistics);
+  BOOST_CHECK_EQUAL(statistics.recycled_, entries);
+
+  for(size_t nMessage = 0; nMessage < 5; ++nMessage)
+  {
+    buildMessage(builder, sequenceIdentity, lengthIdentity, priceIdentity, entries);
+    BOOST_CHECK_EQUAL(consumer.total_, expectedTotal);
+    BOOST_CHECK_EQUAL(consumer.message_, firstMessage);
+    BOOST_CHECK(consumer.entries_ == firstEntries);
+  }
+  builder.fieldSetRecycler()->getStatistics(statistics);
+  BOOST_CHECK_EQUAL(statistics.hits_, 5 * entries);
+
+  builder.setRecycling(false);
+  BOOST_CHECK(!builder.fieldSetRecycler());
+  buildMessage(builder, sequenceIdentity, lengthIdentity, priceIdentity, entries);
+  BOOST_CHECK_EQUAL(consumer.total_, expectedTotal);
+}
@@ -0,0 +1,166 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/MessageWorkerPool.h>
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  Messages::FieldIdentity identity_seqNum("SeqNum");
+
+  /// Sum the sequence numbers of the messages it receives.
+  class SummingConsumer : public Codecs::MessageConsumer
+  {
+  public:
+    SummingConsumer()
+      : messages_(0)
+      , sum_(0)
+      , started_(0)
+      , stopped_(0)
+    {
+    }
+
+    virtual bool consumeMessage(Messages::Message & message)
+    {
+      Messages::FieldCPtr field;
+      BOOST_REQUIRE(message.getField("SeqNum", field));
+      boost::mutex::scoped_lock lock(mutex_);
+      ++messages_;
+      sum_ += field->toUInt32();
+      return true;
+    }
+
+    virtual void decodingStarted(){++started_;}
+    virtual void decodingStopped(){++stopped_;}
+    virtual bool wantLog(unsigned short /*level*/){return false;}
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/){return true;}
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/){return false;}
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/){return false;}
+
+    boost::mutex mutex_;
+    size_t messages_;
+    uint64 sum_;
+    size_t started_;
+    size_t stopped_;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(testMessageWorkerPool)
+{
+  SummingConsumer worker;
+  Codecs::MessageWorkerPool pool(worker, 4, 16);
+  pool.decodingStarted();
+
+  const size_t messageCount = 10000;
+  uint64 expected = 0;
+  std::vector<Messages::FieldCPtr> kept;
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    Messages::Message message(1);
+    Messages::FieldCPtr field(Messages::FieldUInt32::create(uint32(n)));
+    message.addField(identity_seqNum, field);
+    if(Messages::Field::atomicReferenceCount() && n % 10 == 0)
+    {
+      // Share the field with the workers.
+      kept.push_back(field);
+    }
+    field.reset();
+    BOOST_CHECK(pool.consumeMessage(message));
+    // The fields were handed off, not copied.  The message may now hold
+    // an earlier message's fields, returned to be released by this thread.
+    BOOST_CHECK(message.size() == 0 || message.begin()->getField()->toUInt32() < n);
+    expected += n;
+  }
+  pool.decodingStopped();
+
+  BOOST_CHECK_EQUAL(pool.messageCount(), messageCount);
+  BOOST_CHECK_EQUAL(worker.messages_, messageCount);
+  BOOST_CHECK_EQUAL(worker.sum_, expected);
+  BOOST_CHECK_EQUAL(worker.started_, 1u);
+  BOOST_CHECK_EQUAL(worker.stopped_, 1u);
+  for(size_t n = 0; n < kept.size(); ++n)
+  {
+    BOOST_CHECK_EQUAL(kept[n]->toUInt32(), uint32(n * 10));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMessageWorkerPoolReturnsFields)
+{
+  SummingConsumer worker;
+  Codecs::MessageWorkerPool pool(worker, 1, 16);
+  pool.decodingStarted();
+
+  // Once the worker is done with a message, a later handoff reuses it
+  // and gives its fields back to this thread.
+  Messages::Message message(1);
+  uint32 sent = 0;
+  uint64 expected = 0;
+  bool returned = false;
+  while(!returned && sent < 1000)
+  {
+    ++sent;
+    expected += sent;
+    message.addField(identity_seqNum, Messages::FieldUInt32::create(sent));
+    BOOST_CHECK(pool.consumeMessage(message));
+    Messages::FieldCPtr field;
+    returned = message.getField("SeqNum", field);
+    if(returned)
+    {
+      BOOST_CHECK(field->toUInt32() < sent);
+    }
+    else
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+    }
+  }
+  BOOST_CHECK(returned);
+  message.clear();
+  pool.decodingStopped();
+
+  BOOST_CHECK_EQUAL(pool.messageCount(), size_t(sent));
+  BOOST_CHECK_EQUAL(worker.sum_, expected);
+}
+
+namespace
+{
+  void produce(Codecs::MessageWorkerPool & pool, uint32 first, uint32 count)
+  {
+    Messages::Message message(1);
+    for(uint32 n = first; n < first + count; ++n)
+    {
+      message.clear();
+      message.addField(identity_seqNum, Messages::FieldUInt32::create(n));
+      pool.consumeMessage(message);
+    }
+    message.clear();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMessageWorkerPoolProducers)
+{
+  SummingConsumer worker;
+  Codecs::MessageWorkerPool pool(worker, 2, 16);
+
+  // decodingStarted() is not called: the first message from
+  // either thread starts the workers.
+  const uint32 count = 1000;
+  boost::thread first(boost::bind(&produce, boost::ref(pool), 0, count));
+  boost::thread second(boost::bind(&produce, boost::ref(pool), count, count));
+  first.join();
+  second.join();
+  pool.decodingStopped();
+
+  BOOST_CHECK_EQUAL(pool.messageCount(), size_t(2 * count));
+  BOOST_CHECK_EQUAL(worker.messages_, size_t(2 * count));
+  BOOST_CHECK_EQUAL(worker.sum_, uint64(2 * count) * (2 * count - 1) / 2);
+  BOOST_CHECK_EQUAL(worker.started_, 0u);
+}
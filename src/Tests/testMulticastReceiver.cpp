@@ -0,0 +1,92 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Communication/MulticastReceiver.h>
+#include <Tests/LoopbackMulticast.h>
+
+using namespace QuickFAST;
+
+#if QUICKFAST_RECVMMSG
+BOOST_AUTO_TEST_CASE(testMulticastReceiverBatch)
+{
+  const unsigned short port = 30124;
+  const size_t packetCount = 10;
+  Tests::NullLogger logger;
+  Tests::CollectingAssembler assembler(logger);
+  Communication::MulticastReceiver receiver(
+    Tests::LoopbackMulticast::group(), Tests::LoopbackMulticast::loopback(), "0.0.0.0", port);
+  // More packets than the batch size, and more than there are buffers.
+  receiver.setReceiveBatch(4);
+  BOOST_REQUIRE(receiver.start(assembler, 1500, 6));
+
+  std::vector<std::string> packets;
+  for(size_t n = 0; n < packetCount; ++n)
+  {
+    std::stringstream packet;
+    packet << "Packet " << n;
+    packets.push_back(packet.str());
+  }
+  Tests::LoopbackMulticast::send(port, packets);
+
+  // Receive and decode on this thread.
+  for(size_t wait = 0; wait < 500 && !assembler.arrived(packetCount); ++wait)
+  {
+    if(receiver.poll() == 0)
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+  }
+  receiver.stop();
+  receiver.poll();
+
+  // Every packet is delivered once, in order.
+  BOOST_CHECK(assembler.packets_ == packets);
+  BOOST_CHECK(assembler.errors_.empty());
+  BOOST_CHECK_EQUAL(receiver.packetsReceived(), packetCount);
+  BOOST_CHECK_EQUAL(receiver.packetsWithErrors(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testMulticastReceiverBatchTruncated)
+{
+  const unsigned short port = 30124;
+  const size_t bufferSize = 64;
+  Tests::NullLogger logger;
+  Tests::CollectingAssembler assembler(logger);
+  Communication::MulticastReceiver receiver(
+    Tests::LoopbackMulticast::group(), Tests::LoopbackMulticast::loopback(), "0.0.0.0", port);
+  receiver.setReceiveBatch(4);
+  BOOST_REQUIRE(receiver.start(assembler, bufferSize, 8));
+
+  // The middle datagram does not fit in a buffer.
+  std::vector<std::string> packets;
+  packets.push_back("First");
+  packets.push_back(std::string(bufferSize * 2, 'X'));
+  packets.push_back("Last");
+  Tests::LoopbackMulticast::send(port, packets);
+
+  // Receive and decode on this thread.
+  for(size_t wait = 0; wait < 500 && !assembler.arrived(2, 1); ++wait)
+  {
+    if(receiver.poll() == 0)
+    {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+  }
+  receiver.stop();
+  receiver.poll();
+
+  // The truncated datagram is reported, not delivered.
+  BOOST_REQUIRE_EQUAL(assembler.packets_.size(), 2u);
+  BOOST_CHECK_EQUAL(assembler.packets_[0], "First");
+  BOOST_CHECK_EQUAL(assembler.packets_[1], "Last");
+  BOOST_CHECK_EQUAL(assembler.errors_.size(), 1u);
+  BOOST_CHECK_EQUAL(receiver.packetsReceived(), 3u);
+  BOOST_CHECK_EQUAL(receiver.packetsWithErrors(), 1u);
+  BOOST_CHECK(receiver.largestPacket() <= bufferSize);
+}
+#endif // QUICKFAST_RECVMMSG
@@ -0,0 +1,145 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/ParallelMulticastDecoder.h>
+#include <Codecs/MessageConsumer.h>
+#include <Communication/RawFileReceiver.h>
+#include <Messages/Message.h>
+#include <Tests/RefreshTemplate.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  /// Count the messages from each feed and check that no two calls overlap.
+  class OverlapCheckingConsumer : public Codecs::MessageConsumer
+  {
+  public:
+    OverlapCheckingConsumer()
+      : overlaps_(0)
+      , logs_(0)
+      , errors_(0)
+    {
+    }
+
+    virtual bool consumeMessage(Messages::Message & message)
+    {
+      Enter enter(*this);
+      Messages::FieldCPtr symbol;
+      Messages::FieldCPtr seqNum;
+      BOOST_REQUIRE(message.getField("Symbol", symbol));
+      BOOST_REQUIRE(message.getField("SeqNum", seqNum));
+      std::vector<uint32> & feed = seqNums_[symbol->toAscii()];
+      feed.push_back(seqNum->toUInt32());
+      return true;
+    }
+
+    virtual void decodingStarted(){}
+    virtual void decodingStopped(){}
+
+    virtual bool wantLog(unsigned short /*level*/)
+    {
+      Enter enter(*this);
+      ++logs_;
+      return false;
+    }
+
+    virtual bool logMessage(unsigned short /*level*/, const std::string & /*logMessage*/)
+    {
+      Enter enter(*this);
+      ++logs_;
+      return true;
+    }
+
+    virtual bool reportDecodingError(const std::string & /*errorMessage*/)
+    {
+      Enter enter(*this);
+      ++errors_;
+      return true;
+    }
+
+    virtual bool reportCommunicationError(const std::string & /*errorMessage*/)
+    {
+      Enter enter(*this);
+      ++errors_;
+      return true;
+    }
+
+    std::map<std::string, std::vector<uint32> > seqNums_;
+    size_t overlaps_;
+    size_t logs_;
+    size_t errors_;
+
+  private:
+    /// Notices when another call is already in progress.
+    class Enter
+    {
+    public:
+      explicit Enter(OverlapCheckingConsumer & consumer)
+        : consumer_(consumer)
+        , lock_(consumer.inside_, boost::try_to_lock)
+      {
+        if(!lock_.owns_lock())
+        {
+          // Count the overlap and wait, so the other call is undisturbed.
+          lock_.lock();
+          ++consumer_.overlaps_;
+        }
+        // Make the calls long enough to collide if they can.
+        boost::this_thread::yield();
+      }
+    private:
+      OverlapCheckingConsumer & consumer_;
+      boost::mutex::scoped_lock lock_;
+    };
+
+    boost::mutex inside_;
+  };
+}
+
+BOOST_AUTO_TEST_CASE(testParallelMulticastDecoderTwoFeeds)
+{
+  Codecs::TemplateRegistryPtr registry = Tests::RefreshTemplate::buildRegistry();
+  const size_t messageCount = 200;
+  std::istringstream streamA(Tests::RefreshTemplate::encode(registry, messageCount, 1, size_t(-1), "AAAA"), std::ios::in | std::ios::binary);
+  std::istringstream streamB(Tests::RefreshTemplate::encode(registry, messageCount, 1, size_t(-1), "BBBB"), std::ios::in | std::ios::binary);
+  Communication::RawFileReceiver receiverA(streamA);
+  Communication::RawFileReceiver receiverB(streamB);
+
+  OverlapCheckingConsumer consumer;
+  {
+    Codecs::ParallelMulticastDecoder decoder(registry);
+    decoder.setStrict(false);
+    BOOST_CHECK_EQUAL(decoder.addFeed(receiverA), 0u);
+    BOOST_CHECK_EQUAL(decoder.addFeed(receiverB), 1u);
+    BOOST_CHECK_THROW(decoder.receiver(0), UsageError);
+
+    // One buffer bigger than the data: each stream is decoded as a single packet.
+    decoder.start(consumer, 1024 * 1024, 1);
+    decoder.runThreads();
+    decoder.joinThreads();
+    BOOST_CHECK_EQUAL(decoder.messageCount(), 2 * messageCount);
+  }
+
+  BOOST_CHECK_EQUAL(consumer.overlaps_, 0u);
+  BOOST_CHECK_EQUAL(consumer.errors_, 0u);
+  BOOST_CHECK(consumer.logs_ > 0);
+  BOOST_REQUIRE_EQUAL(consumer.seqNums_.size(), 2u);
+  for(std::map<std::string, std::vector<uint32> >::const_iterator it = consumer.seqNums_.begin();
+    it != consumer.seqNums_.end();
+    ++it)
+  {
+    const std::vector<uint32> & seqNums = it->second;
+    BOOST_REQUIRE_EQUAL(seqNums.size(), messageCount);
+    for(size_t n = 0; n < seqNums.size(); ++n)
+    {
+      // Each feed's messages arrive in order.
+      BOOST_CHECK_EQUAL(seqNums[n], uint32(n + 1));
+    }
+  }
+}
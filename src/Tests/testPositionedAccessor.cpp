@@ -0,0 +1,142 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/PositionedAccessor.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionInt32.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+#include <Messages/Message.h>
+#include <Messages/FieldInt32.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  // Template 5: A, optional B, C
+  Codecs::TemplateRegistryPtr abcRegistry()
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setTemplateName("ABC");
+    templ->setId(5);
+    Codecs::FieldInstructionPtr a(new Codecs::FieldInstructionInt32("A", ""));
+    Codecs::FieldInstructionPtr b(new Codecs::FieldInstructionInt32("B", ""));
+    b->setPresence(false);
+    Codecs::FieldInstructionPtr c(new Codecs::FieldInstructionInt32("C", ""));
+    templ->addInstruction(a);
+    templ->addInstruction(b);
+    templ->addInstruction(c);
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+    registry->addTemplate(templ);
+    registry->finalize();
+    return registry;
+  }
+
+  // identities as an application would construct them: neither interned nor positioned
+  Messages::FieldIdentity applicationA("A");
+  Messages::FieldIdentity applicationB("B");
+  Messages::FieldIdentity applicationC("C");
+}
+
+BOOST_AUTO_TEST_CASE(TestPositionedAccessor)
+{
+  Codecs::TemplateRegistryPtr registry = abcRegistry();
+  Codecs::TemplateCPtr templ;
+  BOOST_REQUIRE(registry->getTemplate(5, templ));
+  const Codecs::SegmentBody & segment = *templ;
+  const Messages::FieldIdentity & identityA = segment.getInstruction(0)->getIdentity();
+  const Messages::FieldIdentity & identityB = segment.getInstruction(1)->getIdentity();
+  const Messages::FieldIdentity & identityC = segment.getInstruction(2)->getIdentity();
+  std::vector<size_t> index;
+
+  // template order with the optional field B absent
+  Messages::FieldSet fields(3);
+  fields.addField(applicationA, Messages::FieldInt32::create(1));
+  fields.addField(applicationC, Messages::FieldInt32::create(3));
+  {
+    Codecs::PositionedAccessor accessor(fields, segment, index);
+    BOOST_REQUIRE_EQUAL(index.size(), 3u);
+    BOOST_CHECK_EQUAL(index[0], 0u);
+    BOOST_CHECK_EQUAL(index[1], Codecs::PositionedAccessor::NO_FIELD);
+    BOOST_CHECK_EQUAL(index[2], 1u);
+
+    int64 value = 0;
+    BOOST_CHECK(accessor.getSignedInteger(identityA, ValueType::INT32, value));
+    BOOST_CHECK_EQUAL(value, 1);
+    BOOST_CHECK(!accessor.isPresent(identityB));
+    BOOST_CHECK(accessor.getSignedInteger(identityC, ValueType::INT32, value));
+    BOOST_CHECK_EQUAL(value, 3);
+  }
+
+  // out of order fields are still found, and the same index is reused
+  Messages::FieldSet reversed(3);
+  reversed.addField(applicationC, Messages::FieldInt32::create(3));
+  reversed.addField(applicationB, Messages::FieldInt32::create(2));
+  reversed.addField(applicationA, Messages::FieldInt32::create(1));
+  {
+    Codecs::PositionedAccessor accessor(reversed, segment, index);
+    int64 value = 0;
+    BOOST_CHECK(accessor.getSignedInteger(identityA, ValueType::INT32, value));
+    BOOST_CHECK_EQUAL(value, 1);
+    BOOST_CHECK(accessor.getSignedInteger(identityB, ValueType::INT32, value));
+    BOOST_CHECK_EQUAL(value, 2);
+    BOOST_CHECK(accessor.getSignedInteger(identityC, ValueType::INT32, value));
+    BOOST_CHECK_EQUAL(value, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestEncodeByPosition)
+{
+  Codecs::TemplateRegistryPtr registry = abcRegistry();
+  Codecs::Encoder encoder(registry);
+  Codecs::DataDestination destination;
+
+  // The same Encoder encodes messages with and without the optional field.
+  Messages::Message withB(3);
+  withB.addField(applicationA, Messages::FieldInt32::create(1));
+  withB.addField(applicationB, Messages::FieldInt32::create(2));
+  withB.addField(applicationC, Messages::FieldInt32::create(3));
+  encoder.encodeMessage(destination, 5, withB);
+
+  Messages::Message withoutB(3);
+  withoutB.addField(applicationA, Messages::FieldInt32::create(4));
+  withoutB.addField(applicationC, Messages::FieldInt32::create(6));
+  encoder.encodeMessage(destination, 5, withoutB);
+  std::string fast;
+  destination.toString(fast);
+
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+
+  decoder.decodeMessage(source, builder);
+  const Messages::Message & first = consumer.message();
+  Messages::FieldCPtr value;
+  BOOST_REQUIRE_EQUAL(first.size(), 3u);
+  BOOST_REQUIRE(first.getField("A", value));
+  BOOST_CHECK_EQUAL(value->toInt32(), 1);
+  BOOST_REQUIRE(first.getField("B", value));
+  BOOST_CHECK_EQUAL(value->toInt32(), 2);
+  BOOST_REQUIRE(first.getField("C", value));
+  BOOST_CHECK_EQUAL(value->toInt32(), 3);
+
+  decoder.decodeMessage(source, builder);
+  const Messages::Message & second = consumer.message();
+  BOOST_REQUIRE_EQUAL(second.size(), 2u);
+  BOOST_REQUIRE(second.getField("A", value));
+  BOOST_CHECK_EQUAL(value->toInt32(), 4);
+  BOOST_CHECK(!second.getField("B", value));
+  BOOST_REQUIRE(second.getField("C", value));
+  BOOST_CHECK_EQUAL(value->toInt32(), 6);
+}
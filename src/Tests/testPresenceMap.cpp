@@ -146,3 +146,21 @@ BOOST_AUTO_TEST_CASE(testPmapEncoding2)
   const char expected[] = "\x80";
   BOOST_CHECK(result == expected);
 }
+
+BOOST_AUTO_TEST_CASE(testPmapVerbose)
+{
+  Codecs::PresenceMap pmap(7);
+  std::stringstream verbose;
+  if(QUICKFAST_DIAGNOSTICS)
+  {
+    pmap.setVerbose(&verbose);
+    pmap.setNextField(true);
+    BOOST_CHECK(!verbose.str().empty());
+  }
+  else
+  {
+    BOOST_CHECK_THROW(pmap.setVerbose(&verbose), UsageError);
+  }
+  // disabling verbose output is always allowed
+  pmap.setVerbose(0);
+}
@@ -72,3 +72,62 @@ BOOST_AUTO_TEST_CASE(TestReplaceField)
   BOOST_CHECK(!fields.isPresent(identity_uint64_nop));
 }
 
+
+namespace
+{
+  // MessageField refers to the identity, so it must outlive the FieldSet.
+  Messages::FieldIdentity internedPrice("Price", "ns");
+  Messages::FieldIdentity internedSize("Size", "ns");
+}
+
+BOOST_AUTO_TEST_CASE(TestInternedFieldLookup)
+{
+  internedPrice.intern();
+  internedSize.intern();
+  BOOST_CHECK(internedPrice.isInterned());
+  BOOST_CHECK(internedPrice.handle() != internedSize.handle());
+  internedPrice.setPosition(0);
+  internedSize.setPosition(1);
+
+  // same name and namespace share a handle
+  Messages::FieldIdentity lookupPrice("Price", "ns");
+  BOOST_CHECK(!lookupPrice.isInterned());
+  BOOST_CHECK(lookupPrice == internedPrice);
+  lookupPrice.intern();
+  BOOST_CHECK_EQUAL(lookupPrice.handle(), internedPrice.handle());
+  BOOST_CHECK(lookupPrice == internedPrice);
+  BOOST_CHECK(lookupPrice != internedSize);
+  Messages::FieldIdentity otherNamespace("Price", "other");
+  otherNamespace.intern();
+  BOOST_CHECK(otherNamespace != internedPrice);
+
+  Messages::FieldSet fields(4);
+  fields.addField(internedSize, Messages::FieldInt32::create(100));
+  fields.addField(internedPrice, Messages::FieldInt32::create(42));
+
+  const Messages::MessageField * field = fields.fieldAtPosition(0);
+  BOOST_REQUIRE(field != 0);
+  BOOST_CHECK_EQUAL(field->getField()->toInt32(), 42);
+  BOOST_CHECK(fields.fieldAtPosition(2) == 0);
+
+  int64 value = 0;
+  // found via the slot, by a linear search, and by name
+  BOOST_CHECK(fields.getSignedInteger(internedPrice, ValueType::INT32, value));
+  BOOST_CHECK_EQUAL(value, 42);
+  BOOST_CHECK(fields.getSignedInteger(lookupPrice, ValueType::INT32, value));
+  BOOST_CHECK_EQUAL(value, 42);
+  Messages::FieldCPtr sizeField;
+  BOOST_CHECK(fields.getField(Messages::FieldIdentity("Size", "ns"), sizeField));
+  BOOST_CHECK_EQUAL(sizeField->toInt32(), 100);
+
+  // growing the set preserves the slots
+  fields.reserve(20);
+  field = fields.fieldAtPosition(1);
+  BOOST_REQUIRE(field != 0);
+  BOOST_CHECK_EQUAL(field->getField()->toInt32(), 100);
+
+  // slots left over from before clear() are not used
+  fields.clear();
+  BOOST_CHECK(fields.fieldAtPosition(0) == 0);
+  BOOST_CHECK(!fields.isPresent(internedPrice));
+}
@@ -0,0 +1,231 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Common/StopBitScanner.h>
+#include <Codecs/FieldInstruction.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/DataSourceStream.h>
+#include <Codecs/PresenceMap.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/TemplateRegistry.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const StopBitScanner::Implementation implementations[] =
+  {
+    StopBitScanner::SCALAR,
+    StopBitScanner::SSE2,
+    StopBitScanner::AVX2
+  };
+  const size_t implementationCount = sizeof(implementations) / sizeof(implementations[0]);
+
+  void decodeAppendixVectors(Codecs::DataSource & source)
+  {
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3, 3, 0));
+    Codecs::Decoder decoder(registry);
+
+    Codecs::PresenceMap pmap(7);
+    pmap.decode(source);
+    BOOST_CHECK(pmap.checkNextField());
+    BOOST_CHECK(!pmap.checkNextField());
+    BOOST_CHECK(pmap.checkNextField());
+
+    // Appendix 3.2.5.1: 942755 then delta -5
+    uint32 unsignedValue = 0;
+    Codecs::FieldInstruction::decodeUnsignedInteger(source, decoder, unsignedValue, "Price");
+    BOOST_CHECK_EQUAL(unsignedValue, 942755u);
+    int64 signedValue = 0;
+    Codecs::FieldInstruction::decodeSignedInteger(source, decoder, signedValue, "Price");
+    BOOST_CHECK_EQUAL(signedValue, -5);
+
+    // Appendix 3.2.2.1: "CME"
+    WorkingBuffer buffer;
+    BOOST_CHECK(Codecs::FieldInstruction::decodeAscii(source, buffer));
+    std::string ascii;
+    buffer.toString(ascii);
+    BOOST_CHECK_EQUAL(ascii, "CME");
+
+    // Long enough to be found by a SIMD stride rather than the scalar tail.
+    BOOST_CHECK(Codecs::FieldInstruction::decodeAscii(source, buffer));
+    buffer.toString(ascii);
+    BOOST_CHECK_EQUAL(ascii, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+
+    uchar byte;
+    BOOST_CHECK(!source.getByte(byte));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testStopBitScannerFind)
+{
+  BOOST_CHECK(StopBitScanner::isSupported(StopBitScanner::SCALAR));
+  BOOST_CHECK(StopBitScanner::isSupported(StopBitScanner::best()));
+
+  const size_t bufferSize = 100;
+  uchar buffer[bufferSize];
+  for(size_t nImpl = 0; nImpl < implementationCount; ++nImpl)
+  {
+    StopBitScanner::Implementation implementation = implementations[nImpl];
+    if(!StopBitScanner::isSupported(implementation))
+    {
+      BOOST_CHECK_THROW(StopBitScanner::setImplementation(implementation), UsageError);
+      continue;
+    }
+    StopBitScanner::setImplementation(implementation);
+    BOOST_CHECK_EQUAL(StopBitScanner::getImplementation(), implementation);
+    BOOST_CHECK_EQUAL(StopBitScanner::find(buffer, 0), 0u);
+    // unaligned starting points, every stop bit position, and no stop bit at all
+    for(size_t start = 0; start < 4; ++start)
+    {
+      size_t size = bufferSize - start;
+      for(size_t stop = 0; stop <= size; ++stop)
+      {
+        for(size_t pos = 0; pos < bufferSize; ++pos)
+        {
+          buffer[pos] = uchar(pos & dataBits);
+        }
+        if(stop < size)
+        {
+          buffer[start + stop] |= stopBit;
+          // a second stop bit further on must not matter
+          buffer[bufferSize - 1] |= stopBit;
+        }
+        BOOST_CHECK_EQUAL(StopBitScanner::find(buffer + start, size), stop);
+      }
+    }
+  }
+  StopBitScanner::setImplementation(StopBitScanner::best());
+}
+
+BOOST_AUTO_TEST_CASE(testStopBitScannerDecoding)
+{
+  const char testData[] =
+    "\xD0"              // pmap 101
+    "\x39\x45\xa3"      // 942755
+    "\xfb"              // -5
+    "\x43\x4d\xc5"      // CME
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxy\xFA";
+  std::string testString(testData, sizeof(testData)-1);
+
+  for(size_t nImpl = 0; nImpl < implementationCount; ++nImpl)
+  {
+    if(StopBitScanner::isSupported(implementations[nImpl]))
+    {
+      StopBitScanner::setImplementation(implementations[nImpl]);
+      Codecs::DataSourceString contiguousSource(testString);
+      decodeAppendixVectors(contiguousSource);
+
+      // Small buffers force the fallback to byte-at-a-time decoding.
+      std::istringstream stream(testString);
+      Codecs::DataSourceStream splitSource(stream, 2);
+      decodeAppendixVectors(splitSource);
+    }
+  }
+  StopBitScanner::setImplementation(StopBitScanner::best());
+}
+
+namespace
+{
+  template<typename IntType>
+  bool decodeInteger(
+    Codecs::DataSource & source,
+    Codecs::Context & context,
+    bool isSigned,
+    bool oversize,
+    IntType & value)
+  {
+    try
+    {
+      if(isSigned)
+      {
+        Codecs::FieldInstruction::decodeSignedInteger(source, context, value, "test", oversize);
+      }
+      else
+      {
+        Codecs::FieldInstruction::decodeUnsignedInteger(source, context, value, "test");
+      }
+    }
+    catch(const EncodingError &)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  /// Decode using the eight byte load, and again a byte at a time.
+  template<typename IntType>
+  void compareIntegerDecoding(const std::string & encoded, bool isSigned, bool oversize)
+  {
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry(3, 3, 0));
+    Codecs::Decoder decoder(registry);
+
+    // padding guarantees eight contiguous bytes
+    Codecs::DataSourceString wideSource(encoded + std::string(8, '\x80'));
+    IntType wideValue = 0;
+    bool wideOk = decodeInteger(wideSource, decoder, isSigned, oversize, wideValue);
+
+    std::istringstream stream(encoded);
+    Codecs::DataSourceStream narrowSource(stream, 1);
+    IntType narrowValue = 0;
+    bool narrowOk = decodeInteger(narrowSource, decoder, isSigned, oversize, narrowValue);
+
+    BOOST_CHECK_EQUAL(wideOk, narrowOk);
+    if(wideOk && narrowOk)
+    {
+      BOOST_CHECK_EQUAL(wideValue, narrowValue);
+      // the padding must not have been consumed
+      uchar byte = 0;
+      BOOST_CHECK(wideSource.getByte(byte));
+      BOOST_CHECK_EQUAL(byte, stopBit);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testStopBitScannerDecodeWord)
+{
+  // Appendix 3.2.5.1: 942755
+  const uchar encoded[] = {0x39, 0x45, 0xa3, 0, 0, 0, 0, 0};
+  size_t length = 0;
+  uint64 groups = 0;
+  if(StopBitScanner::decodeWord(encoded, length, groups))
+  {
+    BOOST_CHECK_EQUAL(length, 3u);
+    BOOST_CHECK_EQUAL(groups, 942755u);
+  }
+
+  // Random encodings from one to ten bytes long, including overflows.
+  uint32 seed = 12345;
+  for(size_t test = 0; test < 20000; ++test)
+  {
+    std::string bytes;
+    seed = seed * 1103515245u + 12345u;
+    size_t byteCount = 1 + (seed >> 16) % 10;
+    for(size_t pos = 0; pos < byteCount; ++pos)
+    {
+      seed = seed * 1103515245u + 12345u;
+      uchar byte = uchar((seed >> 16) & dataBits);
+      // favor the extreme values that are near overflow boundaries
+      if(pos == 0 && (test & 3) == 0)
+      {
+        byte = (test & 4) ? uchar(0x7F) : uchar(0x00);
+      }
+      if(pos + 1 == byteCount)
+      {
+        byte |= stopBit;
+      }
+      bytes += char(byte);
+    }
+    compareIntegerDecoding<uint32>(bytes, false, false);
+    compareIntegerDecoding<uint64>(bytes, false, false);
+    compareIntegerDecoding<int32>(bytes, true, false);
+    compareIntegerDecoding<int32>(bytes, true, true);
+    compareIntegerDecoding<int64>(bytes, true, false);
+    compareIntegerDecoding<int64>(bytes, true, true);
+  }
+}
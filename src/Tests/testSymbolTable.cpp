@@ -0,0 +1,121 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Messages/SymbolTable.h>
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  const uchar * bytes(const char * value)
+  {
+    return reinterpret_cast<const uchar *>(value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSymbolTableIntern)
+{
+  Messages::SymbolTable table(300, 8);
+  const Messages::Symbol * ibm = table.intern(bytes("IBM"), 3);
+  BOOST_REQUIRE(ibm != 0);
+  BOOST_CHECK_EQUAL(ibm->id(), 0u);
+  BOOST_CHECK_EQUAL(ibm->field()->toAscii(), "IBM");
+
+  const Messages::Symbol * msft = table.intern(bytes("MSFT"), 4);
+  BOOST_REQUIRE(msft != 0);
+  BOOST_CHECK_EQUAL(msft->id(), 1u);
+
+  // the same bytes give the same symbol
+  BOOST_CHECK(table.intern(bytes("IBMX"), 3) == ibm);
+  BOOST_CHECK(table.find(bytes("MSFT"), 4) == msft);
+  BOOST_CHECK(table.find(bytes("ORCL"), 4) == 0);
+  BOOST_CHECK(&table[1] == msft);
+
+  // too long
+  BOOST_CHECK(table.intern(bytes("TOOLONGVALUE"), 12) == 0);
+
+  // enough values to force several rehashes, then fill the table
+  char buffer[16];
+  for(size_t n = 0; table.size() < 300; ++n)
+  {
+    int length = sprintf(buffer, "S%d", int(n));
+    BOOST_REQUIRE(table.intern(bytes(buffer), length) != 0);
+  }
+  BOOST_CHECK(table.intern(bytes("FULL"), 4) == 0);
+  BOOST_CHECK(table.intern(bytes("IBM"), 3) == ibm);
+  for(uint32 id = 0; id < table.size(); ++id)
+  {
+    const Messages::Symbol & symbol = table[id];
+    BOOST_CHECK_EQUAL(symbol.id(), id);
+    BOOST_CHECK(table.find(symbol.data(), symbol.length()) == &symbol);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSymbolTableDecoding)
+{
+  Messages::FieldIdentity identity_seqNum("SeqNum");
+  Messages::FieldIdentity identity_symbol("Symbol");
+
+  Codecs::TemplatePtr templ(new Codecs::Template);
+  templ->setId(3);
+  templ->setTemplateName("Trade");
+  Codecs::FieldInstructionPtr field(new Codecs::FieldInstructionUInt32("SeqNum", ""));
+  templ->addInstruction(field);
+  field.reset(new Codecs::FieldInstructionAscii("Symbol", ""));
+  templ->addInstruction(field);
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+  registry->addTemplate(templ);
+  registry->finalize();
+
+  Codecs::Encoder encoder(registry);
+  Codecs::DataDestination destination;
+  for(uint32 seqNum = 1; seqNum <= 2; ++seqNum)
+  {
+    Messages::Message msg(2);
+    msg.addField(identity_seqNum, Messages::FieldUInt32::create(seqNum));
+    msg.addField(identity_symbol, Messages::FieldAscii::create("QFST"));
+    encoder.encodeMessage(destination, 3, msg);
+  }
+  std::string fast;
+  destination.toString(fast);
+
+  Messages::SymbolTablePtr symbols(new Messages::SymbolTable);
+  Codecs::Decoder decoder(registry);
+  decoder.setSymbolTable(symbols);
+  Codecs::DataSourceString source(fast);
+
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  decoder.decodeMessage(source, builder);
+  Messages::FieldCPtr first;
+  BOOST_REQUIRE(consumer.message().getField("Symbol", first));
+  BOOST_CHECK_EQUAL(first->toAscii(), "QFST");
+
+  decoder.decodeMessage(source, builder);
+  Messages::FieldCPtr second;
+  BOOST_REQUIRE(consumer.message().getField("Symbol", second));
+
+  // both messages share the interned field
+  BOOST_CHECK(first == second);
+  BOOST_CHECK_EQUAL(symbols->size(), 1u);
+  BOOST_CHECK(symbols->find(bytes("QFST"), 4)->field() == first);
+}
@@ -0,0 +1,389 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/TemplateCodeGenerator.h>
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionInt64.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldInstructionUtf8.h>
+#include <Codecs/FieldOpCopy.h>
+#include <Codecs/FieldOpDefault.h>
+#include <Codecs/FieldOpTail.h>
+#include <Codecs/FieldInstructionInt32.h>
+#include <Codecs/FieldInstructionUInt64.h>
+#include <Codecs/FieldInstructionDecimal.h>
+#include <Codecs/FieldOpConstant.h>
+#include <Codecs/FieldOpIncrement.h>
+#include <Codecs/FieldOpDelta.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/Decoder.h>
+#include <Codecs/DataSourceString.h>
+#include <Codecs/SingleMessageConsumer.h>
+#include <Codecs/GenericMessageBuilder.h>
+#include <Messages/Message.h>
+#include <Messages/FieldIdentity.h>
+#include <Messages/FieldInt32.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldInt64.h>
+#include <Messages/FieldUInt64.h>
+#include <Messages/FieldAscii.h>
+#include <Messages/FieldDecimal.h>
+#include <Common/Exceptions.h>
+#include <Tests/GeneratedQuoteDecoder.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  Codecs::TemplatePtr newTemplate(template_id_t id, const std::string & name)
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setId(id);
+    templ->setTemplateName(name);
+    return templ;
+  }
+
+  void addField(
+    Codecs::TemplatePtr & templ,
+    Codecs::FieldInstruction * instruction,
+    bool mandatory,
+    Codecs::FieldOp * fieldOp = 0)
+  {
+    Codecs::FieldInstructionPtr field(instruction);
+    field->setPresence(mandatory);
+    if(fieldOp != 0)
+    {
+      field->setFieldOp(Codecs::FieldOpPtr(fieldOp));
+    }
+    templ->addInstruction(field);
+  }
+
+  Codecs::FieldOp * withValue(Codecs::FieldOp * fieldOp, const std::string & value)
+  {
+    fieldOp->setValue(value);
+    return fieldOp;
+  }
+
+  /// @brief The templates from which GeneratedQuoteDecoder.h and .cpp were generated.
+  ///
+  /// If you change this, regenerate the files with the TemplateCodeGenerator.
+  Codecs::TemplateRegistryPtr quoteRegistry()
+  {
+    Codecs::TemplatePtr quote = newTemplate(7, "Quote");
+    addField(quote, new Codecs::FieldInstructionUInt32("SeqNum", ""), true, withValue(new Codecs::FieldOpIncrement, "1"));
+    addField(quote, new Codecs::FieldInstructionInt64("Px", ""), false, new Codecs::FieldOpCopy);
+    addField(quote, new Codecs::FieldInstructionUInt32("Size", ""), false);
+    addField(quote, new Codecs::FieldInstructionInt32("Qty", ""), true, new Codecs::FieldOpDelta);
+    addField(quote, new Codecs::FieldInstructionInt64("Change", ""), false, new Codecs::FieldOpDelta);
+    addField(quote, new Codecs::FieldInstructionAscii("Market", ""), true, withValue(new Codecs::FieldOpDefault, "XNAS"));
+    addField(quote, new Codecs::FieldInstructionAscii("Symbol", ""), true, new Codecs::FieldOpCopy);
+    addField(quote, new Codecs::FieldInstructionAscii("Side", ""), false);
+    addField(quote, new Codecs::FieldInstructionAscii("Venue", ""), false, withValue(new Codecs::FieldOpConstant, "Q"));
+    addField(quote, new Codecs::FieldInstructionUInt64("Level", ""), true, withValue(new Codecs::FieldOpConstant, "3"));
+    addField(quote, new Codecs::FieldInstructionDecimal("Price", ""), false);
+    addField(quote, new Codecs::FieldInstructionUInt32("Flags", ""), false, withValue(new Codecs::FieldOpDefault, "5"));
+
+    // The same field with and without overflow checking.
+    Codecs::TemplatePtr wide = newTemplate(8, "Wide");
+    Codecs::FieldInstructionPtr wideValue(new Codecs::FieldInstructionUInt32("Value", ""));
+    wideValue->setIgnoreOverflow(true);
+    wide->addInstruction(wideValue);
+    Codecs::TemplatePtr narrow = newTemplate(9, "Narrow");
+    addField(narrow, new Codecs::FieldInstructionUInt32("Value", ""), true);
+
+    Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+    registry->addTemplate(quote);
+    registry->addTemplate(wide);
+    registry->addTemplate(narrow);
+    registry->finalize();
+    return registry;
+  }
+
+  const std::string quoteNamespace("QuickFAST::Tests::Generated");
+  const std::string quoteHeader("GeneratedQuoteDecoder.h");
+
+  Messages::FieldIdentity identity_SeqNum("SeqNum");
+  Messages::FieldIdentity identity_Px("Px");
+  Messages::FieldIdentity identity_Size("Size");
+  Messages::FieldIdentity identity_Qty("Qty");
+  Messages::FieldIdentity identity_Change("Change");
+  Messages::FieldIdentity identity_Market("Market");
+  Messages::FieldIdentity identity_Symbol("Symbol");
+  Messages::FieldIdentity identity_Side("Side");
+  Messages::FieldIdentity identity_Venue("Venue");
+  Messages::FieldIdentity identity_Level("Level");
+  Messages::FieldIdentity identity_Price("Price");
+  Messages::FieldIdentity identity_Flags("Flags");
+
+  /// Build a Quote that exercises the operators: values repeat, change, and go missing.
+  Messages::MessagePtr buildQuote(size_t n)
+  {
+    Messages::MessagePtr msg(new Messages::Message(12));
+    msg->addField(identity_SeqNum, Messages::FieldUInt32::create(uint32(n + 1)));
+    if(n % 4 != 3)
+    {
+      msg->addField(identity_Px, Messages::FieldInt64::create(int64(1000 + n / 2)));
+    }
+    if(n % 3 != 0)
+    {
+      msg->addField(identity_Size, Messages::FieldUInt32::create(uint32(n * 10)));
+    }
+    msg->addField(identity_Qty, Messages::FieldInt32::create(int32(100 - 7 * int32(n))));
+    if(n % 5 != 0)
+    {
+      msg->addField(identity_Change, Messages::FieldInt64::create(-int64(n)));
+    }
+    msg->addField(identity_Market, Messages::FieldAscii::create(n % 2 == 0 ? "XNAS" : "ARCX"));
+    msg->addField(identity_Symbol, Messages::FieldAscii::create(n < 3 ? "IBM" : "MSFT"));
+    if(n % 2 != 0)
+    {
+      msg->addField(identity_Side, Messages::FieldAscii::create("B"));
+    }
+    if(n % 3 == 1)
+    {
+      msg->addField(identity_Venue, Messages::FieldAscii::create("Q"));
+    }
+    msg->addField(identity_Level, Messages::FieldUInt64::create(3));
+    if(n % 2 == 0)
+    {
+      msg->addField(identity_Price, Messages::FieldDecimal::create(Decimal(mantissa_t(12345 + n), -2)));
+    }
+    if(n % 4 != 1)
+    {
+      msg->addField(identity_Flags, Messages::FieldUInt32::create(uint32(n % 2 != 0 ? 5 : n)));
+    }
+    return msg;
+  }
+
+  /// Keep the messages delivered by the generated decoder.
+  class QuoteHandler : public Tests::Generated::MessageHandler
+  {
+  public:
+    virtual void handle(const Tests::Generated::Quote & message)
+    {
+      quotes_.push_back(message);
+    }
+    virtual void handle(const Tests::Generated::Wide & message)
+    {
+      values_.push_back(message.Value);
+    }
+    virtual void handle(const Tests::Generated::Narrow & message)
+    {
+      values_.push_back(message.Value);
+    }
+
+    std::vector<Tests::Generated::Quote> quotes_;
+    std::vector<uint32> values_;
+  };
+
+  template<typename VALUE>
+  void fieldValue(const Messages::Field & field, VALUE & value)
+  {
+    field.getValue(value);
+  }
+
+  void fieldValue(const Messages::Field & field, Decimal & value)
+  {
+    value = field.toDecimal();
+  }
+
+  template<typename VALUE>
+  void checkField(const Messages::Message & message, const std::string & name, bool present, const VALUE & value)
+  {
+    Messages::FieldCPtr field;
+    BOOST_CHECK_EQUAL(message.getField(name, field), present);
+    if(present && field)
+    {
+      VALUE decoded = VALUE();
+      fieldValue(*field, decoded);
+      BOOST_CHECK_EQUAL(decoded, value);
+    }
+  }
+
+  void checkString(const Messages::Message & message, const std::string & name, bool present, const std::string & value)
+  {
+    Messages::FieldCPtr field;
+    BOOST_CHECK_EQUAL(message.getField(name, field), present);
+    if(present && field)
+    {
+      BOOST_CHECK_EQUAL(std::string(field->toAscii()), value);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateCodeGeneratorIdentifier)
+{
+  BOOST_CHECK_EQUAL(Codecs::TemplateCodeGenerator::identifier("MDEntryPx"), "MDEntryPx");
+  BOOST_CHECK_EQUAL(Codecs::TemplateCodeGenerator::identifier("MD-Entry.Px"), "MD_Entry_Px");
+  BOOST_CHECK_EQUAL(Codecs::TemplateCodeGenerator::identifier("52"), "f_52");
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateCodeGenerator)
+{
+  Codecs::TemplatePtr quote = newTemplate(7, "Quote");
+  addField(quote, new Codecs::FieldInstructionUInt32("SeqNum", ""), true);
+  addField(quote, new Codecs::FieldInstructionInt64("Px", ""), false, new Codecs::FieldOpCopy);
+  Codecs::FieldOp * defaultOp = new Codecs::FieldOpDefault;
+  defaultOp->setValue("XNAS");
+  addField(quote, new Codecs::FieldInstructionAscii("Market-Id", ""), true, defaultOp);
+
+  Codecs::TemplatePtr news = newTemplate(8, "News");
+  addField(news, new Codecs::FieldInstructionUtf8("Headline", ""), true, new Codecs::FieldOpTail);
+
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+  registry->addTemplate(quote);
+  registry->addTemplate(news);
+  registry->finalize();
+
+  Codecs::TemplateCodeGenerator generator(registry, "Test::Generated");
+  generator.setHeaderName("QuoteDecoder.h");
+  std::ostringstream header;
+  generator.generateHeader(header);
+  std::ostringstream source;
+  generator.generateSource(source);
+
+  BOOST_REQUIRE_EQUAL(generator.getSkippedTemplates().size(), 1);
+  BOOST_CHECK(generator.getSkippedTemplates()[0].find("News") == 0);
+
+  std::string h = header.str();
+  BOOST_CHECK(h.find("namespace Test{") != std::string::npos);
+  BOOST_CHECK(h.find("namespace Generated{") != std::string::npos);
+  BOOST_CHECK(h.find("struct Quote") != std::string::npos);
+  BOOST_CHECK(h.find("struct News") == std::string::npos);
+  BOOST_CHECK(h.find("static const QuickFAST::template_id_t templateId = 7;") != std::string::npos);
+  BOOST_CHECK(h.find("QuickFAST::uint32 SeqNum;") != std::string::npos);
+  BOOST_CHECK(h.find("bool SeqNumPresent;") == std::string::npos);
+  BOOST_CHECK(h.find("QuickFAST::int64 Px;") != std::string::npos);
+  BOOST_CHECK(h.find("bool PxPresent;") != std::string::npos);
+  BOOST_CHECK(h.find("std::string Market_Id;") != std::string::npos);
+
+  std::string s = source.str();
+  BOOST_CHECK(s.find("#include \"QuoteDecoder.h\"") != std::string::npos);
+  BOOST_CHECK(s.find("integerNop<QuickFAST::uint32, false>(source, context, true, false, message.SeqNum") != std::string::npos);
+  std::string copyCall = "message.PxPresent = QuickFAST::Codecs::GeneratedDecoderSupport::integerCopy<QuickFAST::int64, true>(source, pmap, context, false, false, ";
+  BOOST_CHECK(s.find(copyCall) != std::string::npos);
+  BOOST_CHECK(s.find("asciiDefault(source, pmap, context, true, \"XNAS\", message.Market_Id") != std::string::npos);
+  BOOST_CHECK(s.find("case Quote::templateId:") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateCodeGeneratorFixture)
+{
+  // GeneratedQuoteDecoder.h and .cpp are built with these tests and the tests below
+  // check how they decode.  Here check that the generator still declares what
+  // those tests use, without depending on the exact text it produces.
+  Codecs::TemplateCodeGenerator generator(quoteRegistry(), quoteNamespace);
+  generator.setHeaderName(quoteHeader);
+  std::ostringstream header;
+  generator.generateHeader(header);
+  std::ostringstream source;
+  generator.generateSource(source);
+  BOOST_CHECK(generator.getSkippedTemplates().empty());
+
+  const std::string h = header.str();
+  const char * declarations[] = {
+    "namespace Generated{",
+    "struct Quote",
+    "struct Wide",
+    "struct Narrow",
+    "class MessageHandler",
+    "class Decoder",
+    0};
+  for(size_t nDeclaration = 0; declarations[nDeclaration] != 0; ++nDeclaration)
+  {
+    BOOST_CHECK_MESSAGE(h.find(declarations[nDeclaration]) != std::string::npos, declarations[nDeclaration]);
+  }
+  BOOST_CHECK(source.str().find("#include \"" + quoteHeader + "\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(testGeneratedDecoderMatchesInterpreter)
+{
+  Codecs::TemplateRegistryPtr registry = quoteRegistry();
+  const size_t messageCount = 12;
+  Codecs::Encoder encoder(registry);
+  Codecs::DataDestination destination;
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    encoder.encodeMessage(destination, 7, *buildQuote(n));
+  }
+  std::string fast;
+  destination.toString(fast);
+
+  QuoteHandler handler;
+  Tests::Generated::Decoder generated;
+  Codecs::DataSourceString generatedSource(fast);
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  for(size_t n = 0; n < messageCount; ++n)
+  {
+    BOOST_REQUIRE(generated.decodeMessage(generatedSource, handler));
+    BOOST_REQUIRE_EQUAL(handler.quotes_.size(), n + 1);
+    decoder.decodeMessage(source, builder);
+    const Messages::Message & message = consumer.message();
+    const Tests::Generated::Quote & quote = handler.quotes_.back();
+
+    checkField(message, "SeqNum", true, quote.SeqNum);
+    checkField(message, "Px", quote.PxPresent, quote.Px);
+    checkField(message, "Size", quote.SizePresent, quote.Size);
+    checkField(message, "Qty", true, quote.Qty);
+    checkField(message, "Change", quote.ChangePresent, quote.Change);
+    checkString(message, "Market", true, quote.Market);
+    checkString(message, "Symbol", true, quote.Symbol);
+    checkString(message, "Side", quote.SidePresent, quote.Side);
+    checkString(message, "Venue", quote.VenuePresent, quote.Venue);
+    checkField(message, "Level", true, quote.Level);
+    checkField(message, "Price", quote.PricePresent, quote.Price);
+    checkField(message, "Flags", quote.FlagsPresent, quote.Flags);
+
+    // and both agree with what was encoded.
+    BOOST_CHECK_EQUAL(quote.SeqNum, uint32(n + 1));
+    BOOST_CHECK_EQUAL(quote.PxPresent, n % 4 != 3);
+    BOOST_CHECK_EQUAL(quote.Qty, int32(100 - 7 * int32(n)));
+    BOOST_CHECK_EQUAL(quote.Symbol, n < 3 ? "IBM" : "MSFT");
+    BOOST_CHECK_EQUAL(quote.VenuePresent, n % 3 == 1);
+    BOOST_CHECK_EQUAL(quote.FlagsPresent, n % 4 != 1);
+  }
+  BOOST_CHECK(generatedSource.bytesAvailable() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(testGeneratedDecoderOverflow)
+{
+  Codecs::TemplateRegistryPtr registry = quoteRegistry();
+  // pmap with the template ID bit, the template ID, then a 42 bit value for a uInt32 field.
+  const unsigned char wide[] = {0xC0, 0x88, 0x01, 0x00, 0x00, 0x00, 0x00, 0x81};
+  const unsigned char narrow[] = {0xC0, 0x89, 0x01, 0x00, 0x00, 0x00, 0x00, 0x81};
+
+  // Overflow is ignored for the field that asks for it...
+  Codecs::DataSourceString wideSource(std::string(reinterpret_cast<const char *>(wide), sizeof(wide)));
+  Codecs::Decoder decoder(registry);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  decoder.decodeMessage(wideSource, builder);
+  Messages::FieldCPtr field;
+  BOOST_REQUIRE(consumer.message().getField("Value", field));
+  uint32 interpreted = field->toUInt32();
+
+  QuoteHandler handler;
+  Tests::Generated::Decoder generated;
+  Codecs::DataSourceString generatedWideSource(std::string(reinterpret_cast<const char *>(wide), sizeof(wide)));
+  BOOST_REQUIRE(generated.decodeMessage(generatedWideSource, handler));
+  BOOST_REQUIRE_EQUAL(handler.values_.size(), 1u);
+  BOOST_CHECK_EQUAL(handler.values_[0], interpreted);
+
+  // ...and is an error otherwise.
+  Codecs::DataSourceString narrowSource(std::string(reinterpret_cast<const char *>(narrow), sizeof(narrow)));
+  Codecs::Decoder narrowDecoder(registry);
+  BOOST_CHECK_THROW(narrowDecoder.decodeMessage(narrowSource, builder), EncodingError);
+  Codecs::DataSourceString generatedNarrowSource(std::string(reinterpret_cast<const char *>(narrow), sizeof(narrow)));
+  Tests::Generated::Decoder generatedNarrow;
+  BOOST_CHECK_THROW(generatedNarrow.decodeMessage(generatedNarrowSource, handler), EncodingError);
+}
@@ -13,6 +13,16 @@
 #include <Codecs/Decoder.h>
 #include <Codecs/SingleMessageConsumer.h>
 #include <Codecs/GenericMessageBuilder.h>
+#include <Codecs/SegmentBody.h>
+#include <Codecs/FieldInstructionUInt32.h>
+#include <Codecs/FieldInstructionAscii.h>
+#include <Codecs/FieldInstructionTemplateRef.h>
+#include <Codecs/Encoder.h>
+#include <Codecs/DataDestination.h>
+#include <Codecs/DataSourceString.h>
+#include <Messages/Message.h>
+#include <Messages/FieldUInt32.h>
+#include <Messages/FieldAscii.h>
 //#include <Messages/Field.h>
 
 namespace
@@ -154,3 +164,97 @@ BOOST_AUTO_TEST_CASE(testStaticTemplateRefB)
   BOOST_REQUIRE(msgOut.getField("field3", value));
   BOOST_CHECK_EQUAL(value->toUInt32(), 3);
 }
+
+namespace
+{
+  Codecs::TemplatePtr namedTemplate(const std::string & name)
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setTemplateName(name);
+    return templ;
+  }
+
+  void addField(Codecs::TemplatePtr & templ, Codecs::FieldInstruction * instruction)
+  {
+    Codecs::FieldInstructionPtr field(instruction);
+    templ->addInstruction(field);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testStaticTemplateRefPositions)
+{
+  // Quote merges Header and Trailer into its field set.
+  Codecs::TemplatePtr header = namedTemplate("Header");
+  addField(header, new Codecs::FieldInstructionUInt32("SeqNum", ""));
+  addField(header, new Codecs::FieldInstructionAscii("Sender", ""));
+  Codecs::TemplatePtr trailer = namedTemplate("Trailer");
+  addField(trailer, new Codecs::FieldInstructionUInt32("Check", ""));
+  Codecs::TemplatePtr quote = namedTemplate("Quote");
+  quote->setId(10);
+  addField(quote, new Codecs::FieldInstructionUInt32("Price", ""));
+  addField(quote, new Codecs::FieldInstructionStaticTemplateRef("Header", ""));
+  addField(quote, new Codecs::FieldInstructionUInt32("Quantity", ""));
+  addField(quote, new Codecs::FieldInstructionStaticTemplateRef("Trailer", ""));
+
+  Codecs::TemplateRegistryPtr registry(new Codecs::TemplateRegistry);
+  registry->addTemplate(header);
+  registry->addTemplate(trailer);
+  registry->addTemplate(quote);
+  registry->finalize();
+
+  // Quote's own fields are numbered after those of the templates it merges.
+  BOOST_CHECK_EQUAL(header->getPositionBase(), 0u);
+  BOOST_CHECK_EQUAL(header->getPositionLimit(), 2u);
+  BOOST_CHECK_EQUAL(trailer->getPositionLimit(), 1u);
+  BOOST_CHECK_EQUAL(quote->getPositionBase(), 2u);
+  BOOST_CHECK_EQUAL(quote->getPositionLimit(), 6u);
+
+  Messages::FieldIdentity price("Price");
+  Messages::FieldIdentity seqNum("SeqNum");
+  Messages::FieldIdentity sender("Sender");
+  Messages::FieldIdentity quantity("Quantity");
+  Messages::FieldIdentity check("Check");
+  Messages::Message message(quote->fieldCount());
+  message.addField(price, Messages::FieldUInt32::create(12345));
+  message.addField(seqNum, Messages::FieldUInt32::create(7));
+  message.addField(sender, Messages::FieldAscii::create("QFST"));
+  message.addField(quantity, Messages::FieldUInt32::create(100));
+  message.addField(check, Messages::FieldUInt32::create(99));
+
+  Codecs::Encoder encoder(registry);
+  Codecs::DataDestination destination;
+  encoder.encodeMessage(destination, 10, message);
+  std::string fast;
+  destination.toString(fast);
+
+  Codecs::Decoder decoder(registry);
+  Codecs::DataSourceString source(fast);
+  Codecs::SingleMessageConsumer consumer;
+  Codecs::GenericMessageBuilder builder(consumer);
+  decoder.decodeMessage(source, builder);
+  const Messages::Message & decoded = consumer.message();
+  BOOST_REQUIRE_EQUAL(decoded.size(), 5u);
+
+  // Price and Quantity are at positions 2 and 4 of Quote; Sender at 1 of Header.
+  const Messages::MessageField * field = decoded.fieldAtPosition(2);
+  BOOST_REQUIRE(field != 0);
+  BOOST_CHECK_EQUAL(field->name(), "Price");
+  BOOST_CHECK_EQUAL(field->getField()->toUInt32(), 12345u);
+  field = decoded.fieldAtPosition(4);
+  BOOST_REQUIRE(field != 0);
+  BOOST_CHECK_EQUAL(field->name(), "Quantity");
+  BOOST_CHECK_EQUAL(field->getField()->toUInt32(), 100u);
+  field = decoded.fieldAtPosition(1);
+  BOOST_REQUIRE(field != 0);
+  BOOST_CHECK_EQUAL(field->name(), "Sender");
+  BOOST_CHECK_EQUAL(field->getField()->toAscii(), "QFST");
+
+  // Header and Trailer are merged side by side, so SeqNum and Check share a position.
+  // Neither is found by position but both are found by identity.
+  BOOST_CHECK(decoded.fieldAtPosition(0) == 0);
+  Messages::FieldCPtr value;
+  BOOST_REQUIRE(decoded.getField("SeqNum", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 7u);
+  BOOST_REQUIRE(decoded.getField("Check", value));
+  BOOST_CHECK_EQUAL(value->toUInt32(), 99u);
+}
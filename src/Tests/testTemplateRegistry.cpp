@@ -0,0 +1,69 @@
+// Copyright (c) 2009, 2010, 2011 Object Computing, Inc.
+// All rights reserved.
+// See the file license.txt for licensing information.
+#include <Common/QuickFASTPch.h>
+
+#define BOOST_TEST_NO_MAIN QuickFASTTest
+#include <boost/test/unit_test.hpp>
+
+#include <Codecs/TemplateRegistry.h>
+#include <Codecs/Template.h>
+
+using namespace QuickFAST;
+
+namespace
+{
+  Codecs::TemplatePtr addTemplate(Codecs::TemplateRegistry & registry, template_id_t id)
+  {
+    Codecs::TemplatePtr templ(new Codecs::Template);
+    templ->setId(id);
+    templ->setTemplateName(boost::lexical_cast<std::string>(id));
+    registry.addTemplate(templ);
+    return templ;
+  }
+
+  void checkLookups(const Codecs::TemplateRegistry & registry, const std::vector<template_id_t> & ids)
+  {
+    for(size_t n = 0; n < ids.size(); ++n)
+    {
+      const Codecs::Template * found = registry.findTemplate(ids[n]);
+      BOOST_REQUIRE(found != 0);
+      BOOST_CHECK_EQUAL(found->getId(), ids[n]);
+      // IDs that are not defined
+      BOOST_CHECK(registry.findTemplate(ids[n] + 1) == 0);
+    }
+    BOOST_CHECK(registry.findTemplate(0) == 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testTemplateRegistryFindTemplate)
+{
+  // Dense IDs are indexed by an array; sparse IDs by a hash table.
+  // Multiples of 4096 would all collide in an unmixed hash.
+  template_id_t strides[] = {2, 4096};
+  for(size_t nStride = 0; nStride < sizeof(strides)/sizeof(strides[0]); ++nStride)
+  {
+    Codecs::TemplateRegistry registry;
+    std::vector<template_id_t> ids;
+    for(template_id_t id = strides[nStride]; ids.size() < 100; id += strides[nStride])
+    {
+      addTemplate(registry, id);
+      ids.push_back(id);
+    }
+    // Lookups work before finalize
+    checkLookups(registry, ids);
+    registry.finalize();
+    checkLookups(registry, ids);
+
+    // ...and after adding a template to a finalized registry
+    Codecs::TemplatePtr added = addTemplate(registry, 0xFFFFFFF0u);
+    ids.push_back(0xFFFFFFF0u);
+    BOOST_CHECK_EQUAL(registry.findTemplate(0xFFFFFFF0u), added.get());
+    registry.finalize();
+    checkLookups(registry, ids);
+
+    Codecs::TemplateCPtr templ;
+    BOOST_CHECK(registry.getTemplate(ids[0], templ));
+    BOOST_CHECK_EQUAL(registry.findTemplate(ids[0]), templ.get());
+  }
+}